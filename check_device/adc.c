@@ -16,8 +16,15 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 #include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <dirent.h>
+#include <time.h>
 #include "adc.h"
+#include "sysattr.h"
 
 //------------------------------------------------------------------------------
 // default adc range (mV). ADC res 1.7578125mV (1800mV / 1024 bits)
@@ -30,6 +37,9 @@
 #define DEFAULT_ADC_H40_H   490
 #define DEFAULT_ADC_H40_L   430
 
+// buffer capture timeout (ms)
+#define ADC_BUFFER_TIMEOUT  500
+
 //------------------------------------------------------------------------------
 //
 // Configuration
@@ -57,37 +67,315 @@ struct device_adc DeviceADC [eADC_END] = {
     { "/sys/bus/iio/devices/iio:device0/in_voltage6_raw", DEFAULT_ADC_H40_H, DEFAULT_ADC_H40_L, 0 },
 };
 
+// pass/fail statistic, samples per check, max stddev (mV, 0 = no limit)
+static int AdcStat      = eADC_STAT_MEAN;
+static int AdcSamples   = ADC_SAMPLES_DEF;
+static int AdcStddevMax = 0;
+
+//------------------------------------------------------------------------------
+// scan element format ("le:u10/16>>0")
+struct adc_scan_type {
+    int be, sign, bits, storage, shift;
+};
+
+// scan element enables before the capture (restored after)
+#define ADC_SCAN_MAX    32
+
+struct adc_scan_save {
+    int     cnt;
+    char    name [ADC_SCAN_MAX][64];
+    char    en   [ADC_SCAN_MAX][4];
+};
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+static int adc_raw_to_mv (int raw)
+{
+    return (raw * 1800) / 1024;
+}
+
 //------------------------------------------------------------------------------
+static long long time_ms (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
 //------------------------------------------------------------------------------
-static int adc_read (const char *path)
+static int isqrt (long long v)
 {
-    char rdata[16];
-    int mV = 0;
-    FILE *fp;
-
-    memset (rdata, 0, sizeof (rdata));
-    // adc raw value get
-    if ((fp = fopen(path, "r")) != NULL) {
-        fgets (rdata, sizeof(rdata), fp);
-        fclose(fp);
+    long long r = 0, b = 1LL << 40;
+
+    while (b > v)   b >>= 2;
+    while (b) {
+        if (v >= r + b) {
+            v -= r + b;
+            r = (r >> 1) + b;
+        } else
+            r >>= 1;
+        b >>= 2;
     }
-    mV = (atoi(rdata) * 1800) / 1024;
-    return mV;
+    return (int)r;
+}
+
+//------------------------------------------------------------------------------
+static void adc_stats_calc (const int *mv, int cnt, struct adc_stats *st)
+{
+    long long sum = 0, sq = 0;
+    int i;
+
+    st->cnt = cnt;
+    st->min = st->max = cnt ? mv[0] : 0;
+    for (i = 0; i < cnt; i++) {
+        sum += mv[i];
+        if (mv[i] < st->min)    st->min = mv[i];
+        if (mv[i] > st->max)    st->max = mv[i];
+    }
+    st->mean = cnt ? (int)(sum / cnt) : 0;
+    for (i = 0; i < cnt; i++)
+        sq += (long long)(mv[i] - st->mean) * (mv[i] - st->mean);
+    st->stddev = cnt ? isqrt (sq / cnt) : 0;
+}
+
+//------------------------------------------------------------------------------
+// "/sys/bus/iio/devices/iio:device0/in_voltage7_raw" -> dir, "in_voltage7"
+//------------------------------------------------------------------------------
+static int adc_split_path (const char *path, char *dir, char *chan)
+{
+    const char *name = strrchr (path, '/');
+    int len;
+
+    if ((name == NULL) || ((len = strlen (name + 1) - strlen ("_raw")) <= 0))
+        return 0;
+
+    memcpy (dir, path, name - path);    dir[name - path] = 0;
+    memcpy (chan, name + 1, len);       chan[len] = 0;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+static int adc_scan_type (const char *dir, const char *chan, struct adc_scan_type *t)
+{
+    char path[PATH_MAX], rdata[32], endian[4], sign;
+
+    snprintf (path, sizeof(path), "%s/scan_elements/%s_type", dir, chan);
+    if (sysattr_read (path, rdata, sizeof(rdata)) <= 0)
+        return 0;
+
+    memset (t, 0, sizeof(struct adc_scan_type));
+    if (sscanf (rdata, "%2s:%c%d/%d>>%d", endian, &sign, &t->bits, &t->storage, &t->shift) != 5)
+        return 0;
+
+    t->be   = !strcmp (endian, "be");
+    t->sign = (sign == 's');
+    return ((t->storage == 8) || (t->storage == 16) || (t->storage == 32)) &&
+            (t->bits > 0) && (t->bits <= t->storage);
+}
+
+//------------------------------------------------------------------------------
+static int adc_scan_value (const unsigned char *p, const struct adc_scan_type *t)
+{
+    unsigned int v = 0;
+    int i, bytes = t->storage / 8;
+
+    for (i = 0; i < bytes; i++)
+        v |= (unsigned int)p[t->be ? i : (bytes - 1 - i)] << (8 * (bytes - 1 - i));
+
+    v >>= t->shift;
+    if (t->bits < 32) {
+        v &= (1u << t->bits) - 1;
+        // sign extend
+        if (t->sign && (v & (1u << (t->bits - 1))))
+            v |= ~((1u << t->bits) - 1);
+    }
+    return (int)v;
+}
+
+//------------------------------------------------------------------------------
+// enable only the channel (other channels and timestamp off, saved) + buffer on
+//------------------------------------------------------------------------------
+static int adc_buffer_setup (const char *dir, const char *chan, int samples,
+                             struct adc_scan_save *save)
+{
+    char path[PATH_MAX], file[PATH_MAX], str[16];
+    struct dirent *de;
+    DIR *d;
+    int len;
+
+    snprintf (path, sizeof(path), "%s/buffer/enable", dir);
+    sysattr_write (path, "0");
+
+    snprintf (path, sizeof(path), "%s/scan_elements", dir);
+    sysattr_path (file, sizeof(file), path);
+    if ((d = opendir (file)) == NULL)
+        return 0;
+    save->cnt = 0;
+    while (((de = readdir (d)) != NULL) && (save->cnt < ADC_SCAN_MAX)) {
+        len = strlen (de->d_name);
+        if ((len <= 3) || (len >= (int)sizeof(save->name[0])) || strcmp (&de->d_name[len - 3], "_en"))
+            continue;
+
+        snprintf (path, sizeof(path), "%s/scan_elements/%s", dir, de->d_name);
+        if (sysattr_read (path, save->en[save->cnt], sizeof(save->en[0])) <= 0)
+            continue;
+        strcpy (save->name[save->cnt++], de->d_name);
+        sysattr_write (path, "0");
+    }
+    closedir (d);
+
+    snprintf (path, sizeof(path), "%s/scan_elements/%s_en", dir, chan);
+    if (!sysattr_write (path, "1"))
+        return 0;
+
+    snprintf (path, sizeof(path), "%s/buffer/length", dir);
+    snprintf (str,  sizeof(str),  "%d", samples);
+    sysattr_write (path, str);
+
+    // no trigger (4.19 saradc) : the enable fails, sysfs fallback
+    snprintf (path, sizeof(path), "%s/buffer/enable", dir);
+    return sysattr_write (path, "1");
+}
+
+//------------------------------------------------------------------------------
+// buffer off, scan elements back to the state before adc_buffer_setup
+//------------------------------------------------------------------------------
+static void adc_buffer_restore (const char *dir, const struct adc_scan_save *save)
+{
+    char path[PATH_MAX];
+    int i;
+
+    snprintf (path, sizeof(path), "%s/buffer/enable", dir);
+    sysattr_write (path, "0");
+
+    for (i = 0; i < save->cnt; i++) {
+        snprintf (path, sizeof(path), "%s/scan_elements/%s", dir, save->name[i]);
+        sysattr_write (path, save->en[i]);
+    }
+}
+
+//------------------------------------------------------------------------------
+// iio buffer capture : N scans of one channel from /dev/iio:deviceN in one read
+// (blocks until the samples are there or timeout), return the sample count.
+//------------------------------------------------------------------------------
+static int adc_buffer_capture (const char *raw_path, int samples, int *mv)
+{
+    struct adc_scan_type t;
+    struct adc_scan_save save;
+    struct pollfd pfd;
+    char dir[PATH_MAX], chan[64], path[PATH_MAX], node[PATH_MAX];
+    unsigned char *buf;
+    int fd, ret, bytes, size, got = 0, i;
+    long long end;
+
+    if (!adc_split_path (raw_path, dir, chan) || !adc_scan_type (dir, chan, &t))
+        return 0;
+
+    bytes = t.storage / 8;
+    size  = samples * bytes;
+    if ((buf = (unsigned char *)malloc (size)) == NULL)
+        return 0;
+
+    save.cnt = 0;
+    if (!adc_buffer_setup (dir, chan, samples, &save))
+        goto out;
+
+    // "/sys/bus/iio/devices/iio:device0" -> "/dev/iio:device0"
+    snprintf (path, sizeof(path), "/dev%s", strrchr (dir, '/'));
+    sysattr_path (node, sizeof(node), path);
+    if ((fd = open (node, O_RDONLY | O_NONBLOCK)) < 0)
+        goto out;
+
+    pfd.fd = fd;    pfd.events = POLLIN;
+    end = time_ms () + ADC_BUFFER_TIMEOUT;
+    while (got < size) {
+        if ((ret = read (fd, buf + got, size - got)) > 0) {
+            got += ret;
+            continue;
+        }
+        // eof (file feed) or error
+        if ((ret == 0) || (errno != EAGAIN) || (time_ms () >= end))
+            break;
+        poll (&pfd, 1, (int)(end - time_ms ()));
+    }
+    close (fd);
+
+    for (i = 0; i < got / bytes; i++)
+        mv[i] = adc_raw_to_mv (adc_scan_value (buf + i * bytes, &t));
+out:
+    adc_buffer_restore (dir, &save);
+    free (buf);
+    return got / bytes;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// N samples of the channel (iio buffer, sysfs single-shot fallback), return the count
+//------------------------------------------------------------------------------
+int adc_capture (int id, int samples, struct adc_stats *st)
+{
+    int mv[ADC_SAMPLES_MAX], cnt, raw;
+
+    memset (st, 0, sizeof(struct adc_stats));
+    if ((id >= eADC_END) || (samples <= 0))
+        return 0;
+    if (samples > ADC_SAMPLES_MAX)
+        samples = ADC_SAMPLES_MAX;
+
+    if ((cnt = adc_buffer_capture (DeviceADC[id].path, samples, mv)) > 0) {
+        st->buffered = 1;
+    } else {
+        // sysfs single-shot (one pread per sample)
+        for (cnt = 0; cnt < samples; cnt++) {
+            if (!sysattr_read_int (DeviceADC[id].path, &raw))
+                break;
+            mv[cnt] = adc_raw_to_mv (raw);
+        }
+    }
+    adc_stats_calc (mv, cnt, st);
+    return cnt;
+}
+
+//------------------------------------------------------------------------------
+// stat : eADC_STAT_MEAN / eADC_STAT_ALL, stddev_max : mV (0 = no limit)
+//------------------------------------------------------------------------------
+void adc_set_stat (int stat, int samples, int stddev_max)
+{
+    if ((stat >= 0) && (stat < eADC_STAT_END))
+        AdcStat = stat;
+    if ((samples > 0) && (samples <= ADC_SAMPLES_MAX))
+        AdcSamples = samples;
+    if (stddev_max >= 0)
+        AdcStddevMax = stddev_max;
 }
 
 //------------------------------------------------------------------------------
 int adc_check (int id)
 {
-    int value = 0;
+    struct adc_stats st;
+    int pass;
 
-    if (access (DeviceADC[id].path, R_OK) != 0)
+    if (!adc_capture (id, AdcSamples, &st))
         return 0;
 
-    value = adc_read (DeviceADC[id].path);
-    if ((value < DeviceADC[id].max) && (value > DeviceADC[id].min))
-        return value;
+    printf ("%s : id %d, %s %d samples, mean %d, min %d, max %d, stddev %d mV\n",
+            __func__, id, st.buffered ? "buffer" : "sysfs", st.cnt,
+            st.mean, st.min, st.max, st.stddev);
+
+    DeviceADC[id].value = st.mean;
+    switch (AdcStat) {
+        case eADC_STAT_ALL:
+            pass = (st.max < DeviceADC[id].max) && (st.min > DeviceADC[id].min);
+            break;
+        default :
+            pass = (st.mean < DeviceADC[id].max) && (st.mean > DeviceADC[id].min);
+            break;
+    }
+    if (AdcStddevMax && (st.stddev > AdcStddevMax))
+        pass = 0;
 
-    return 0;
+    return pass ? st.mean : 0;
 }
 
 //------------------------------------------------------------------------------
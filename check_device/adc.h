@@ -28,10 +28,33 @@ enum {
     eADC_END
 };
 
+//------------------------------------------------------------------------------
+// pass/fail statistic
+enum {
+    // mean inside the range
+    eADC_STAT_MEAN = 0,
+    // every sample inside the range
+    eADC_STAT_ALL,
+    eADC_STAT_END
+};
+
+// samples per check
+#define ADC_SAMPLES_DEF     32
+#define ADC_SAMPLES_MAX     1024
+
+struct adc_stats {
+    // sample count, 1 = iio buffer capture, 0 = sysfs single-shot
+    int cnt, buffered;
+    // mV
+    int mean, min, max, stddev;
+};
+
 //------------------------------------------------------------------------------
 // function prototype
 //------------------------------------------------------------------------------
-extern int adc_check     (int id);
+extern int  adc_check       (int id);
+extern int  adc_capture     (int id, int samples, struct adc_stats *st);
+extern void adc_set_stat    (int stat, int samples, int stddev_max);
 
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
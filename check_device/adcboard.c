@@ -0,0 +1,210 @@
+//------------------------------------------------------------------------------
+/**
+ * @file adcboard.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Device Test library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+//------------------------------------------------------------------------------
+#include "../lib_i2cadc/lib_i2cadc.h"
+#include "adcboard.h"
+
+//------------------------------------------------------------------------------
+//
+// Batched reads for the I2C ADC board (header pattern, board type detect).
+// A batch is a channel list read as one sweep : the bus is taken once and
+// the channels are read back to back, so a sweep never interleaves with the
+// transfers of another task on the bit-banged bus.
+// lib_i2cadc has no multi-channel transfer and no name lookup, the board
+// backend is one adc_board_read per channel (same bus time as single reads)
+// and the channel names are resolved by the library on each read.
+// The simulated backend (value table) is for the test tools only.
+//
+//------------------------------------------------------------------------------
+struct adc_sim_chan {
+    char    name [16];
+    int     value [ADC_CHAN_VALUE_MAX];
+    int     cnt;
+};
+
+static int                  AdcBackend = eADC_BACKEND_BOARD;
+static struct adc_sim_chan  AdcSim [ADC_SIM_CHAN_MAX];
+
+// one sweep at a time on the i2c bus
+static pthread_mutex_t      AdcBusLock = PTHREAD_MUTEX_INITIALIZER;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+static int adc_sim_find (const char *name)
+{
+    int i;
+
+    for (i = 0; i < ADC_SIM_CHAN_MAX; i++)
+        if (AdcSim[i].name[0] && !strcmp (AdcSim[i].name, name))
+            return i;
+    return -1;
+}
+
+//------------------------------------------------------------------------------
+static int adc_sim_read (int chan, int *value, int *cnt)
+{
+    if ((chan < 0) || (chan >= ADC_SIM_CHAN_MAX) || !AdcSim[chan].cnt) {
+        *cnt = 0;
+        return 0;
+    }
+    memcpy (value, AdcSim[chan].value, AdcSim[chan].cnt * sizeof(int));
+    *cnt = AdcSim[chan].cnt;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// one channel of the sweep (AdcBusLock held)
+//------------------------------------------------------------------------------
+static int adc_chan_read (int fd, const adc_batch_t *b, int i, int *value, int *cnt)
+{
+    if (AdcBackend == eADC_BACKEND_SIM)
+        return adc_sim_read (b->chan[i], value, cnt);
+
+    *cnt = 0;
+    return adc_board_read (fd, b->name[i], value, cnt);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+int adcboard_init (const char *dev)
+{
+    // simulated board : any fd except 0/-1 (not opened)
+    if (AdcBackend == eADC_BACKEND_SIM)
+        return 1;
+
+    return adc_board_init (dev);
+}
+
+//------------------------------------------------------------------------------
+// Switch to the simulated backend (test tools), fname ("NAME value ..." per line)
+// or NULL. return the channel count
+//------------------------------------------------------------------------------
+int adcboard_sim_init (const char *fname)
+{
+    FILE *fp;
+    char line[512], *tok, *save;
+    int value[ADC_CHAN_VALUE_MAX], cnt, chan = 0;
+
+    memset (AdcSim, 0, sizeof(AdcSim));
+    AdcBackend = eADC_BACKEND_SIM;
+
+    if ((fname == NULL) || ((fp = fopen (fname, "r")) == NULL))
+        return 0;
+
+    while (fgets (line, sizeof(line), fp) != NULL) {
+        if ((line[0] == '#') || ((tok = strtok_r (line, " \t\r\n", &save)) == NULL))
+            continue;
+
+        char *name = tok;
+        for (cnt = 0; (cnt < ADC_CHAN_VALUE_MAX) &&
+                      ((tok = strtok_r (NULL, " \t\r\n", &save)) != NULL); cnt++)
+            value[cnt] = atoi (tok);
+
+        if (adcboard_sim_set (name, value, cnt))
+            chan++;
+    }
+    fclose (fp);
+    return chan;
+}
+
+//------------------------------------------------------------------------------
+int adcboard_sim_set (const char *name, const int *value, int cnt)
+{
+    int i;
+
+    if ((cnt <= 0) || (cnt > ADC_CHAN_VALUE_MAX))
+        return 0;
+
+    pthread_mutex_lock (&AdcBusLock);
+    if ((i = adc_sim_find (name)) < 0) {
+        for (i = 0; i < ADC_SIM_CHAN_MAX; i++)
+            if (!AdcSim[i].name[0])
+                break;
+    }
+    if (i < ADC_SIM_CHAN_MAX) {
+        strncpy (AdcSim[i].name, name, sizeof(AdcSim[i].name) -1);
+        memcpy  (AdcSim[i].value, value, cnt * sizeof(int));
+        AdcSim[i].cnt = cnt;
+    }
+    pthread_mutex_unlock (&AdcBusLock);
+
+    return (i < ADC_SIM_CHAN_MAX);
+}
+
+//------------------------------------------------------------------------------
+// names must stay valid (string constants).
+// return the resolved channel count (board : every name, sim : names in the table)
+//------------------------------------------------------------------------------
+int adcboard_batch_init (adc_batch_t *b, const char * const *names, int cnt)
+{
+    int i, ok = 0;
+
+    memset (b, 0, sizeof(adc_batch_t));
+    if ((cnt <= 0) || (cnt > ADC_BATCH_MAX))
+        return 0;
+
+    pthread_mutex_lock (&AdcBusLock);
+    for (i = 0; i < cnt; i++) {
+        b->name[i] = names[i];
+        b->chan[i] = (AdcBackend == eADC_BACKEND_SIM) ? adc_sim_find (names[i]) : -1;
+        if ((AdcBackend != eADC_BACKEND_SIM) || (b->chan[i] >= 0))
+            ok++;
+    }
+    pthread_mutex_unlock (&AdcBusLock);
+
+    b->cnt = cnt;
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+// value[i] : buffer of channel i (ADC_CHAN_VALUE_MAX), cnt[i] : values read
+// return the number of channels read
+//------------------------------------------------------------------------------
+int adcboard_batch_read (int fd, const adc_batch_t *b, int *value[], int cnt[])
+{
+    int i, ok = 0;
+
+    pthread_mutex_lock (&AdcBusLock);
+    for (i = 0; i < b->cnt; i++) {
+        if (adc_chan_read (fd, b, i, value[i], &cnt[i]))
+            ok++;
+    }
+    pthread_mutex_unlock (&AdcBusLock);
+
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+// single channel (adc_board_read compatible)
+//------------------------------------------------------------------------------
+int adcboard_read (int fd, const char *name, int *value, int *cnt)
+{
+    adc_batch_t b;
+
+    *cnt = 0;
+    if (!adcboard_batch_init (&b, &name, 1))
+        return 0;
+
+    return adcboard_batch_read (fd, &b, &value, cnt);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,55 @@
+//------------------------------------------------------------------------------
+/**
+ * @file adcboard.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Device Test library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef __ADCBOARD_H__
+#define __ADCBOARD_H__
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// channels per batch, values per channel (connector : 40 pins)
+#define ADC_BATCH_MAX       8
+#define ADC_CHAN_VALUE_MAX  40
+// simulated channels
+#define ADC_SIM_CHAN_MAX    32
+
+enum {
+    // lib_i2cadc (bit-banged i2c adc board)
+    eADC_BACKEND_BOARD = 0,
+    // value table (test tools, tools/adcboard_sim)
+    eADC_BACKEND_SIM,
+};
+
+// channel list set up once (adcboard_batch_init), read with one bus sweep
+typedef struct adc_batch__t {
+    int         cnt;
+    const char  *name [ADC_BATCH_MAX];
+    // backend channel handle (sim : table index, -1 = unknown / board)
+    int         chan  [ADC_BATCH_MAX];
+}   adc_batch_t;
+
+//------------------------------------------------------------------------------
+// function prototype
+//------------------------------------------------------------------------------
+extern int  adcboard_init       (const char *dev);
+extern int  adcboard_sim_init   (const char *fname);
+extern int  adcboard_sim_set    (const char *name, const int *value, int cnt);
+extern int  adcboard_batch_init (adc_batch_t *b, const char * const *names, int cnt);
+extern int  adcboard_batch_read (int fd, const adc_batch_t *b, int *value[], int cnt[]);
+extern int  adcboard_read       (int fd, const char *name, int *value, int *cnt);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#endif  // #define __ADCBOARD_H__
+//------------------------------------------------------------------------------
@@ -0,0 +1,294 @@
+//------------------------------------------------------------------------------
+/**
+ * @file blkbench.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Device Test library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// O_DIRECT
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/aio_abi.h>
+
+//------------------------------------------------------------------------------
+#include "blkbench.h"
+
+//------------------------------------------------------------------------------
+// O_DIRECT buffer / offset alignment
+#define BENCH_ALIGN     4096
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// kernel aio (libaio is not installed on the jig image, use raw syscalls)
+//------------------------------------------------------------------------------
+static int io_setup_ (unsigned nr, aio_context_t *ctx)
+{
+    return syscall (__NR_io_setup, nr, ctx);
+}
+
+//------------------------------------------------------------------------------
+static int io_destroy_ (aio_context_t ctx)
+{
+    return syscall (__NR_io_destroy, ctx);
+}
+
+//------------------------------------------------------------------------------
+static int io_submit_ (aio_context_t ctx, long nr, struct iocb **iocbpp)
+{
+    return syscall (__NR_io_submit, ctx, nr, iocbpp);
+}
+
+//------------------------------------------------------------------------------
+static int io_getevents_ (aio_context_t ctx, long min_nr, long nr,
+                          struct io_event *events)
+{
+    return syscall (__NR_io_getevents, ctx, min_nr, nr, events, NULL);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+static long long time_us (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+//------------------------------------------------------------------------------
+static int int_compare (const void *a, const void *b)
+{
+    return *(const int *)a - *(const int *)b;
+}
+
+//------------------------------------------------------------------------------
+// O_DIRECT is refused by tmpfs/overlay (boot device temp file), retry without it.
+//------------------------------------------------------------------------------
+static int bench_open (const struct bench_cfg *cfg, int *direct)
+{
+    int fd, flags;
+
+    flags = (cfg->mode == eBENCH_WRITE) ? (O_WRONLY | O_CREAT | O_DSYNC) : O_RDONLY;
+
+    *direct = 1;
+    if ((fd = open (cfg->path, flags | O_DIRECT, 0644)) >= 0)
+        return fd;
+
+    if (errno != EINVAL)
+        return -1;
+
+    *direct = 0;
+    if ((fd = open (cfg->path, flags, 0644)) >= 0)
+        posix_fadvise (fd, 0, 0, POSIX_FADV_DONTNEED);
+
+    return fd;
+}
+
+//------------------------------------------------------------------------------
+static void bench_result_calc (struct bench_result *r, int *lat, int cnt)
+{
+    if (cnt) {
+        qsort (lat, cnt, sizeof(int), int_compare);
+        r->lat_min = lat[0];
+        r->lat_p50 = lat[((cnt - 1) * 50) / 100];
+        r->lat_p95 = lat[((cnt - 1) * 95) / 100];
+        r->lat_p99 = lat[((cnt - 1) * 99) / 100];
+        r->lat_max = lat[cnt - 1];
+    }
+    if (r->elapsed_us) {
+        // bytes per usec == MB/s (10^6)
+        r->mbps = (int)(r->bytes / r->elapsed_us);
+        r->iops = (int)(((long long)cnt * 1000000) / r->elapsed_us);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Synchronous path (aio context unavailable), queue depth 1
+//------------------------------------------------------------------------------
+static int bench_sync (int fd, const struct bench_cfg *cfg, char *buf,
+                       int *lat, int n_io, struct bench_result *r)
+{
+    long long offset = cfg->offset, t;
+    int i, ret;
+
+    for (i = 0; i < n_io; i++, offset += cfg->bs) {
+        t = time_us ();
+        if (cfg->mode == eBENCH_WRITE)
+            ret = pwrite (fd, buf, cfg->bs, offset);
+        else
+            ret = pread  (fd, buf, cfg->bs, offset);
+        lat[i] = (int)(time_us () - t);
+
+        if (ret < 0) {
+            r->err = errno;
+            break;
+        }
+        r->bytes += ret;
+        // end of device/file
+        if (ret < cfg->bs) {
+            i++;
+            break;
+        }
+    }
+    return i;
+}
+
+//------------------------------------------------------------------------------
+// Kernel aio path, keep cfg->qd requests in flight
+//------------------------------------------------------------------------------
+static int bench_aio (aio_context_t ctx, int fd, const struct bench_cfg *cfg,
+                      char *buf, int *lat, int n_io, struct bench_result *r)
+{
+    struct iocb     cb   [BENCH_MAX_QD], *pcb [BENCH_MAX_QD];
+    struct io_event ev   [BENCH_MAX_QD];
+    long long       t_sub[BENCH_MAX_QD], offset = cfg->offset;
+    int free_slot[BENCH_MAX_QD], free_cnt, submitted = 0, done = 0;
+    int inflight = 0, eof = 0, i, cnt, ret, slot;
+
+    for (i = 0; i < cfg->qd; i++)
+        free_slot[i] = i;
+    free_cnt = cfg->qd;
+
+    while (done < submitted || (!eof && !r->err && submitted < n_io)) {
+        // fill the queue
+        for (cnt = 0; !eof && !r->err && free_cnt && (submitted + cnt) < n_io; cnt++) {
+            slot = free_slot[--free_cnt];
+
+            memset (&cb[slot], 0, sizeof(struct iocb));
+            cb[slot].aio_data       = slot;
+            cb[slot].aio_fildes     = fd;
+            cb[slot].aio_lio_opcode = (cfg->mode == eBENCH_WRITE) ? IOCB_CMD_PWRITE : IOCB_CMD_PREAD;
+            cb[slot].aio_buf        = (unsigned long)(buf + (long)slot * cfg->bs);
+            cb[slot].aio_nbytes     = cfg->bs;
+            cb[slot].aio_offset     = offset;
+            offset += cfg->bs;
+
+            pcb[cnt] = &cb[slot];
+            t_sub[slot] = time_us ();
+        }
+        if (cnt) {
+            if ((ret = io_submit_ (ctx, cnt, pcb)) < 0) {
+                r->err = errno;     ret = 0;
+            }
+            // return the slots of the requests that were not queued
+            for (i = ret; i < cnt; i++) {
+                free_slot[free_cnt++] = (int)pcb[i]->aio_data;
+                offset -= cfg->bs;
+            }
+            submitted += ret;   inflight += ret;
+        }
+        if (!inflight)
+            break;
+
+        if ((ret = io_getevents_ (ctx, 1, inflight, ev)) < 0) {
+            if (errno == EINTR)
+                continue;
+            r->err = errno;
+            break;
+        }
+        for (i = 0; i < ret; i++) {
+            slot = (int)ev[i].data;
+            lat[done++] = (int)(time_us () - t_sub[slot]);
+            free_slot[free_cnt++] = slot;
+            inflight--;
+
+            if ((long long)ev[i].res < 0) {
+                r->err = -(int)ev[i].res;
+                continue;
+            }
+            r->bytes += ev[i].res;
+            // end of device/file
+            if ((long long)ev[i].res < cfg->bs)
+                eof = 1;
+        }
+    }
+    return done;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+void blkbench_default (struct bench_cfg *cfg, const char *path, int mode)
+{
+    memset (cfg, 0, sizeof(struct bench_cfg));
+
+    cfg->path   = path;
+    cfg->mode   = mode;
+    cfg->bs     = BENCH_DEFAULT_BS;
+    cfg->qd     = BENCH_DEFAULT_QD;
+    cfg->size   = BENCH_DEFAULT_SIZE;
+    cfg->offset = 0;
+}
+
+//------------------------------------------------------------------------------
+// return MB/s (0 = error)
+//------------------------------------------------------------------------------
+int blkbench_run (const struct bench_cfg *cfg, struct bench_result *r)
+{
+    aio_context_t ctx = 0;
+    char *buf = NULL;
+    int *lat = NULL, fd, n_io, cnt = 0;
+    long long t;
+
+    memset (r, 0, sizeof(struct bench_result));
+
+    if ((cfg->path == NULL) || (cfg->bs <= 0) || (cfg->bs % BENCH_ALIGN) ||
+        (cfg->qd <= 0) || (cfg->qd > BENCH_MAX_QD) || (cfg->size < cfg->bs)) {
+        r->err = EINVAL;
+        return 0;
+    }
+    n_io = (int)(cfg->size / cfg->bs);
+
+    if (posix_memalign ((void **)&buf, BENCH_ALIGN, (size_t)cfg->bs * cfg->qd)) {
+        r->err = ENOMEM;
+        return 0;
+    }
+    if ((lat = (int *)calloc (n_io, sizeof(int))) == NULL) {
+        r->err = ENOMEM;
+        goto out_buf;
+    }
+    // non-zero pattern, some controllers shortcut zero blocks
+    memset (buf, 0xA5, (size_t)cfg->bs * cfg->qd);
+
+    if ((fd = bench_open (cfg, &r->direct)) < 0) {
+        r->err = errno;
+        goto out_lat;
+    }
+
+    t = time_us ();
+    if ((cfg->qd > 1) && (io_setup_ (cfg->qd, &ctx) == 0)) {
+        cnt = bench_aio (ctx, fd, cfg, buf, lat, n_io, r);
+        io_destroy_ (ctx);
+    } else {
+        cnt = bench_sync (fd, cfg, buf, lat, n_io, r);
+    }
+    r->elapsed_us = time_us () - t;
+
+    close (fd);
+    bench_result_calc (r, lat, cnt);
+
+out_lat:
+    free (lat);
+out_buf:
+    free (buf);
+    return r->err ? 0 : r->mbps;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,65 @@
+//------------------------------------------------------------------------------
+/**
+ * @file blkbench.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Device Test library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef __BLKBENCH_H__
+#define __BLKBENCH_H__
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// Default transfer (16 Mbytes, same amount as the old dd check)
+//------------------------------------------------------------------------------
+#define BENCH_DEFAULT_BS    (1024 * 1024)
+#define BENCH_DEFAULT_QD    4
+#define BENCH_DEFAULT_SIZE  (16 * 1024 * 1024)
+
+// Max queue depth (kernel aio context size)
+#define BENCH_MAX_QD        32
+
+enum { eBENCH_READ = 0, eBENCH_WRITE };
+
+struct bench_cfg {
+    // block device, regular file or loop image
+    const char  *path;
+    // eBENCH_READ / eBENCH_WRITE
+    int         mode;
+    // block size (bytes, multiple of 4096), queue depth
+    int         bs, qd;
+    // total transfer size, start offset (bytes)
+    long long   size, offset;
+};
+
+struct bench_result {
+    // throughput (MB/s, 10^6 bytes/sec like dd), io per second
+    int         mbps, iops;
+    // io latency (usec)
+    int         lat_min, lat_p50, lat_p95, lat_p99, lat_max;
+    // transfer bytes, elapsed time (usec)
+    long long   bytes, elapsed_us;
+    // 1 = O_DIRECT used, 0 = fallback (O_DSYNC only)
+    int         direct;
+    // 0 = success, errno on error
+    int         err;
+};
+
+//------------------------------------------------------------------------------
+// function prototype
+//------------------------------------------------------------------------------
+extern void blkbench_default (struct bench_cfg *cfg, const char *path, int mode);
+extern int  blkbench_run     (const struct bench_cfg *cfg, struct bench_result *r);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#endif  // #define __BLKBENCH_H__
+//------------------------------------------------------------------------------
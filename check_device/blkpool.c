@@ -0,0 +1,154 @@
+//------------------------------------------------------------------------------
+/**
+ * @file blkpool.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Device Test library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <pthread.h>
+
+//------------------------------------------------------------------------------
+#include "blkpool.h"
+
+//------------------------------------------------------------------------------
+//
+// All present devices are measured at the same time. Every job owns a thread
+// and its own kernel aio context (blkbench), so the queues are independent and
+// the total time is the time of the slowest device. A job is started as soon
+// as its device is present and reported as soon as it finishes, a device
+// plugged in later does not wait for the others.
+// (io_uring is not available on the 4.19 jig kernel)
+//
+// A network throughput test must not share the bus/CPU with the benchmarks.
+// bench_pool_quiet_enter waits for the running measures and holds the new
+// ones (their threads wait before run) until bench_pool_quiet_leave.
+//
+//------------------------------------------------------------------------------
+struct bench_worker {
+    struct bench_job    *job;
+    bench_done_t        done;
+    void                *arg;
+};
+
+// serialize the done callbacks
+static pthread_mutex_t  DoneLock = PTHREAD_MUTEX_INITIALIZER;
+
+// quiet gate : measures running, quiet holders
+static pthread_mutex_t  QuietLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   QuietCond = PTHREAD_COND_INITIALIZER;
+static int              Running, Quiet;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+static void *bench_worker_thread (void *arg)
+{
+    struct bench_worker *w = (struct bench_worker *)arg;
+    struct bench_job *job = w->job;
+
+    pthread_mutex_lock (&QuietLock);
+    while (Quiet)
+        pthread_cond_wait (&QuietCond, &QuietLock);
+    Running++;
+    pthread_mutex_unlock (&QuietLock);
+
+    job->value = job->run (job->dev_id, &job->r);
+
+    pthread_mutex_lock (&QuietLock);
+    if (!--Running)
+        pthread_cond_broadcast (&QuietCond);
+    pthread_mutex_unlock (&QuietLock);
+
+    if (w->done) {
+        pthread_mutex_lock   (&DoneLock);
+        w->done (job, w->arg);
+        pthread_mutex_unlock (&DoneLock);
+    }
+    free (w);
+    atomic_store (&job->busy, 0);
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+// Measure the job on its own (detached) thread, done() is called when finished.
+// return 1 = started, 0 = the job is still running or thread error
+//------------------------------------------------------------------------------
+int bench_pool_start (struct bench_job *job, bench_done_t done, void *arg)
+{
+    struct bench_worker *w;
+    pthread_attr_t attr;
+    pthread_t thread;
+    int expect = 0, ret;
+
+    if (!atomic_compare_exchange_strong (&job->busy, &expect, 1))
+        return 0;
+
+    if ((w = (struct bench_worker *)calloc (1, sizeof(struct bench_worker))) == NULL) {
+        atomic_store (&job->busy, 0);
+        return 0;
+    }
+    w->job  = job;
+    w->done = done;
+    w->arg  = arg;
+
+    pthread_attr_init (&attr);
+    pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_DETACHED);
+    ret = pthread_create (&thread, &attr, bench_worker_thread, w);
+    pthread_attr_destroy (&attr);
+
+    if (ret) {
+        free (w);
+        atomic_store (&job->busy, 0);
+        return 0;
+    }
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// no measure runs from return until bench_pool_quiet_leave
+//------------------------------------------------------------------------------
+void bench_pool_quiet_enter (void)
+{
+    pthread_mutex_lock (&QuietLock);
+    Quiet++;
+    while (Running)
+        pthread_cond_wait (&QuietCond, &QuietLock);
+    pthread_mutex_unlock (&QuietLock);
+}
+
+//------------------------------------------------------------------------------
+void bench_pool_quiet_leave (void)
+{
+    pthread_mutex_lock (&QuietLock);
+    if (Quiet && !--Quiet)
+        pthread_cond_broadcast (&QuietCond);
+    pthread_mutex_unlock (&QuietLock);
+}
+
+//------------------------------------------------------------------------------
+// measures running now (test)
+//------------------------------------------------------------------------------
+int bench_pool_running (void)
+{
+    int ret;
+
+    pthread_mutex_lock (&QuietLock);
+    ret = Running;
+    pthread_mutex_unlock (&QuietLock);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,58 @@
+//------------------------------------------------------------------------------
+/**
+ * @file blkpool.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Device Test library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef __BLKPOOL_H__
+#define __BLKPOOL_H__
+
+//------------------------------------------------------------------------------
+#include <stdatomic.h>
+#include "blkbench.h"
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// Max devices measured at once (storage 4 + usb 4)
+#define BENCH_POOL_MAX  8
+
+struct bench_job {
+    // caller item id (m1_item index)
+    int id;
+    // device id passed to run (eSTORAGE_xxx, eUSBxx_xxx)
+    int dev_id;
+    // measure function (storage_bench, usb_bench), return MB/s (0 = fail)
+    int (*run) (int dev_id, struct bench_result *r);
+
+    // run() return value, per-device stats
+    int value;
+    struct bench_result r;
+
+    // 1 = measuring (set by bench_pool_start, cleared after done)
+    atomic_int busy;
+};
+
+// called from the job thread as soon as the job is finished (serialized).
+typedef void (*bench_done_t) (struct bench_job *job, void *arg);
+
+//------------------------------------------------------------------------------
+// function prototype
+//------------------------------------------------------------------------------
+extern int  bench_pool_start       (struct bench_job *job, bench_done_t done, void *arg);
+extern void bench_pool_quiet_enter (void);
+extern void bench_pool_quiet_leave (void);
+extern int  bench_pool_running     (void);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#endif  // #define __BLKPOOL_H__
+//------------------------------------------------------------------------------
@@ -0,0 +1,304 @@
+//------------------------------------------------------------------------------
+/**
+ * @file discover.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Device Test library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+//------------------------------------------------------------------------------
+#include "discover.h"
+
+//------------------------------------------------------------------------------
+//
+// Server discovery without an external scan. The last known server is
+// probed first, then every host of the /24 gets a non-blocking connect()
+// to the server port at the same time. The first completed connect wins,
+// closed ports answer with a reset at once and absent hosts are dropped
+// at the deadline. A connect probe is used instead of arp because it also
+// tells that a program listens on the port. An open port is only a
+// candidate, the confirm callback (protocol exchange) must accept it before
+// it is returned or cached.
+//
+//------------------------------------------------------------------------------
+// hosts of a /24 (1 .. 254)
+#define SWEEP_HOST_MAX      254
+
+//------------------------------------------------------------------------------
+static long long time_ms (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+//------------------------------------------------------------------------------
+// return fd (connect in progress or done), -1 = error
+//------------------------------------------------------------------------------
+static int probe_start (struct in_addr addr, int port)
+{
+    struct sockaddr_in sa;
+    int fd;
+
+    if ((fd = socket (AF_INET, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0)) < 0)
+        return -1;
+
+    memset (&sa, 0, sizeof(sa));
+    sa.sin_family = AF_INET;
+    sa.sin_addr   = addr;
+    sa.sin_port   = htons (port);
+    if ((connect (fd, (struct sockaddr *)&sa, sizeof(sa)) < 0) && (errno != EINPROGRESS)) {
+        close (fd);
+        return -1;
+    }
+    return fd;
+}
+
+//------------------------------------------------------------------------------
+static int probe_done (int fd)
+{
+    socklen_t len = sizeof(int);
+    int err = 0;
+
+    if (getsockopt (fd, SOL_SOCKET, SO_ERROR, &err, &len) < 0)
+        return 0;
+    return err ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+// return index of the first connected probe (still open), -1 = none until end
+//------------------------------------------------------------------------------
+static int probe_wait (struct pollfd *pfd, int cnt, long long end)
+{
+    int i, ret, left = 0;
+
+    for (i = 0; i < cnt; i++)
+        if (pfd[i].fd >= 0)
+            left++;
+
+    while (left) {
+        if ((ret = (int)(end - time_ms ())) < 0)
+            break;
+        if ((ret = poll (pfd, cnt, ret)) < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        if (!ret)
+            break;
+        for (i = 0; i < cnt; i++) {
+            if ((pfd[i].fd < 0) || !pfd[i].revents)
+                continue;
+            pfd[i].revents = 0;
+            if (probe_done (pfd[i].fd))
+                return i;
+            // refused / unreachable
+            close (pfd[i].fd);
+            pfd[i].fd = -1;
+            left--;
+        }
+    }
+    return -1;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// return 1 = server port open
+//------------------------------------------------------------------------------
+int discover_probe (const char *ip, int port, int timeout_ms)
+{
+    struct pollfd pfd;
+    struct in_addr addr;
+    int ret;
+
+    if (!inet_aton (ip, &addr))
+        return 0;
+    if ((pfd.fd = probe_start (addr, port)) < 0)
+        return 0;
+    pfd.events = POLLOUT;   pfd.revents = 0;
+
+    ret = probe_wait (&pfd, 1, time_ms () + timeout_ms);
+    if (pfd.fd >= 0)
+        close (pfd.fd);
+    return (ret < 0) ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+// send req, the reply must start with ack. return 1 = ack received
+//------------------------------------------------------------------------------
+int discover_exchange (const char *ip, int port, const char *req, const char *ack,
+                       int timeout_ms)
+{
+    struct pollfd pfd;
+    struct in_addr addr;
+    long long end = time_ms () + timeout_ms;
+    char buf[DISCOVER_ACK_MAX];
+    int len = 0, ret, alen = strlen (ack);
+
+    if (!inet_aton (ip, &addr) || (alen >= DISCOVER_ACK_MAX))
+        return 0;
+    if ((pfd.fd = probe_start (addr, port)) < 0)
+        return 0;
+    pfd.events = POLLOUT;   pfd.revents = 0;
+
+    if ((probe_wait (&pfd, 1, end) < 0) ||
+        (send (pfd.fd, req, strlen (req), MSG_NOSIGNAL) != (ssize_t)strlen (req)))
+        goto out;
+
+    pfd.events = POLLIN;
+    while (len < alen) {
+        if ((ret = (int)(end - time_ms ())) < 0)
+            break;
+        if ((ret = poll (&pfd, 1, ret)) < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        if (!ret || ((ret = recv (pfd.fd, buf + len, alen - len, 0)) <= 0))
+            break;
+        len += ret;
+    }
+out:
+    if (pfd.fd >= 0)
+        close (pfd.fd);
+    return ((len == alen) && !memcmp (buf, ack, alen)) ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+// parallel connect to x.x.x.1 .. x.x.x.254 of my_ip (except my_ip), the open
+// ports in connect order until one is confirmed (confirm = NULL : first one)
+// return 1 = found (found : DISCOVER_IP_SIZE)
+//------------------------------------------------------------------------------
+int discover_sweep (const char *my_ip, int port, int timeout_ms,
+                    discover_confirm_t confirm, char *found)
+{
+    struct pollfd pfd [SWEEP_HOST_MAX];
+    struct in_addr addr [SWEEP_HOST_MAX], self;
+    long long end = time_ms () + timeout_ms;
+    char ip[DISCOVER_IP_SIZE];
+    int i, cnt = 0, ret;
+    uint32_t net;
+
+    if (!inet_aton (my_ip, &self))
+        return 0;
+    net = ntohl (self.s_addr) & 0xFFFFFF00;
+
+    for (i = 1; i <= SWEEP_HOST_MAX; i++) {
+        if ((net | i) == ntohl (self.s_addr))
+            continue;
+        addr[cnt].s_addr = htonl (net | i);
+        if ((pfd[cnt].fd = probe_start (addr[cnt], port)) < 0)
+            continue;
+        pfd[cnt].events  = POLLOUT;
+        pfd[cnt].revents = 0;
+        cnt++;
+    }
+
+    while ((ret = probe_wait (pfd, cnt, end)) >= 0) {
+        close (pfd[ret].fd);
+        pfd[ret].fd = -1;
+        snprintf (ip, sizeof(ip), "%s", inet_ntoa (addr[ret]));
+        if ((confirm == NULL) || confirm (ip, port)) {
+            memcpy (found, ip, DISCOVER_IP_SIZE);
+            break;
+        }
+        printf ("%s : %s port %d open, not confirmed\n", __func__, ip, port);
+    }
+    for (i = 0; i < cnt; i++)
+        if (pfd[i].fd >= 0)
+            close (pfd[i].fd);
+
+    return (ret < 0) ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+int discover_cache_read (const char *path, char *ip)
+{
+    struct in_addr addr;
+    char buf[DISCOVER_IP_SIZE + 8];
+    FILE *fp;
+    int ret = 0;
+
+    if ((fp = fopen (path, "r")) == NULL)
+        return 0;
+    if (fgets (buf, sizeof(buf), fp)) {
+        buf[strcspn (buf, " \r\n")] = 0;
+        if (inet_aton (buf, &addr)) {
+            snprintf (ip, DISCOVER_IP_SIZE, "%s", inet_ntoa (addr));
+            ret = 1;
+        }
+    }
+    fclose (fp);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+// written only when changed (boot partition)
+//------------------------------------------------------------------------------
+int discover_cache_write (const char *path, const char *ip)
+{
+    char old[DISCOVER_IP_SIZE];
+    FILE *fp;
+
+    if (discover_cache_read (path, old) && !strcmp (old, ip))
+        return 1;
+    if ((fp = fopen (path, "w")) == NULL)
+        return 0;
+    fprintf (fp, "%s\n", ip);
+    fclose (fp);
+    sync ();
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// cached server, then the /24 sweep. cache = NULL : sweep only
+// only a confirmed server is returned and written to the cache
+// return 1 = found (found : DISCOVER_IP_SIZE), cache updated
+//------------------------------------------------------------------------------
+int discover_server (const char *cache, const char *my_ip, int port,
+                     discover_confirm_t confirm, char *found)
+{
+    long long start = time_ms ();
+    char ip[DISCOVER_IP_SIZE];
+
+    if (cache && discover_cache_read (cache, ip) && strcmp (ip, my_ip) &&
+        discover_probe (ip, port, DISCOVER_PROBE_MS) &&
+        ((confirm == NULL) || confirm (ip, port))) {
+        memcpy (found, ip, DISCOVER_IP_SIZE);
+        printf ("%s : %s (cached), %lld ms\n", __func__, found, time_ms () - start);
+        return 1;
+    }
+    if (!discover_sweep (my_ip, port, DISCOVER_SWEEP_MS, confirm, found)) {
+        printf ("%s : no server on %s/24 port %d, %lld ms\n", __func__, my_ip, port,
+                time_ms () - start);
+        return 0;
+    }
+    printf ("%s : %s, %lld ms\n", __func__, found, time_ms () - start);
+    if (cache)
+        discover_cache_write (cache, found);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,50 @@
+//------------------------------------------------------------------------------
+/**
+ * @file discover.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Device Test library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef __DISCOVER_H__
+#define __DISCOVER_H__
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// cached server connect limit, /24 sweep deadline (msec)
+#define DISCOVER_PROBE_MS   200
+#define DISCOVER_SWEEP_MS   500
+
+// "255.255.255.255" + '\0'
+#define DISCOVER_IP_SIZE    16
+
+// protocol exchange limit (discover_exchange ack length)
+#define DISCOVER_ACK_MAX    64
+
+// open port found : protocol exchange with the server. return 1 = accepted
+typedef int (*discover_confirm_t) (const char *ip, int port);
+
+//------------------------------------------------------------------------------
+// function prototype
+//------------------------------------------------------------------------------
+extern int  discover_probe          (const char *ip, int port, int timeout_ms);
+extern int  discover_exchange       (const char *ip, int port, const char *req,
+                                     const char *ack, int timeout_ms);
+extern int  discover_sweep          (const char *my_ip, int port, int timeout_ms,
+                                     discover_confirm_t confirm, char *found);
+extern int  discover_cache_read     (const char *path, char *ip);
+extern int  discover_cache_write    (const char *path, const char *ip);
+extern int  discover_server         (const char *cache, const char *my_ip, int port,
+                                     discover_confirm_t confirm, char *found);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#endif  // #define __DISCOVER_H__
+//------------------------------------------------------------------------------
@@ -38,58 +38,282 @@
 #include <sys/ioctl.h>
 #include <sys/mman.h>
 #include <sys/wait.h>
-#include <sys/ioctl.h>
+#include <poll.h>
+#include <linux/ethtool.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
 
 //------------------------------------------------------------------------------
 #include "ethernet.h"
 
-#define STR_PATH_LENGTH 128
 //------------------------------------------------------------------------------
-static int ethernet_link_speed (void)
+//
+// Link speed through SIOCETHTOOL (ETHTOOL_SLINKSETTINGS, legacy ETHTOOL_SSET
+// on older drivers) instead of running ethtool. The link up is not polled:
+// an RTNETLINK socket (RTMGRP_LINK) is opened before the change and every
+// RTM_NEWLINK of the interface rechecks the link, so the wait ends as soon
+// as the autonegotiation completes.
+//
+//------------------------------------------------------------------------------
+static char IfName[IFNAMSIZ] = ETHERNET_IFNAME_DEF;
+
+// last link change / wait time (msec)
+static int LinkMs = 0;
+
+// ETHTOOL_xLINKSETTINGS request + supported / advertising / lp_advertising
+struct link_settings {
+    struct ethtool_link_settings req;
+    __u32 masks[3 * 127];
+};
+
+//------------------------------------------------------------------------------
+static long long time_ms (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+//------------------------------------------------------------------------------
+static int link_ioctl (int fd, unsigned long req, void *data)
 {
-    FILE *fp;
-    char cmd_line[STR_PATH_LENGTH];
+    struct ifreq ifr;
 
-    if (access ("/sys/class/net/eth0/speed", F_OK) != 0)
+    memset (&ifr, 0, sizeof(ifr));
+    strncpy (ifr.ifr_name, IfName, IFNAMSIZ - 1);
+    ifr.ifr_data = data;
+    return ioctl (fd, req, &ifr);
+}
+
+//------------------------------------------------------------------------------
+// nwords handshake : the first request returns -(mask words)
+//------------------------------------------------------------------------------
+static int link_get_settings (int fd, struct link_settings *ls)
+{
+    memset (ls, 0, sizeof(struct link_settings));
+    ls->req.cmd = ETHTOOL_GLINKSETTINGS;
+    if ((link_ioctl (fd, SIOCETHTOOL, ls) < 0) || (ls->req.link_mode_masks_nwords >= 0))
         return 0;
 
-    memset (cmd_line, 0x00, sizeof(cmd_line));
-    if ((fp = fopen ("/sys/class/net/eth0/speed", "r")) != NULL) {
-        memset (cmd_line, 0x00, sizeof(cmd_line));
-        if (NULL != fgets (cmd_line, sizeof(cmd_line), fp)) {
-            fclose (fp);
-            return atoi (cmd_line);
+    ls->req.cmd = ETHTOOL_GLINKSETTINGS;
+    ls->req.link_mode_masks_nwords = -ls->req.link_mode_masks_nwords;
+    if (link_ioctl (fd, SIOCETHTOOL, ls) < 0)
+        return 0;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// link speed (Mbps), 0 = link down
+//------------------------------------------------------------------------------
+static int link_speed (int fd)
+{
+    struct link_settings ls;
+    struct ethtool_cmd ecmd;
+    struct ifreq ifr;
+    __u32 speed;
+
+    memset (&ifr, 0, sizeof(ifr));
+    strncpy (ifr.ifr_name, IfName, IFNAMSIZ - 1);
+    if ((ioctl (fd, SIOCGIFFLAGS, &ifr) < 0) || !(ifr.ifr_flags & IFF_RUNNING))
+        return 0;
+
+    if (link_get_settings (fd, &ls)) {
+        speed = ls.req.speed;
+    } else {
+        memset (&ecmd, 0, sizeof(ecmd));
+        ecmd.cmd = ETHTOOL_GSET;
+        if (link_ioctl (fd, SIOCETHTOOL, &ecmd) < 0)
+            return 0;
+        speed = ethtool_cmd_speed (&ecmd);
+    }
+    return ((speed == (__u32)SPEED_UNKNOWN) || (speed > INT_MAX)) ? 0 : (int)speed;
+}
+
+//------------------------------------------------------------------------------
+// speed / full duplex : advertise only that mode (same as ethtool -s speed
+// duplex full with autoneg on), forced mode if autoneg is off.
+//------------------------------------------------------------------------------
+static int link_set_speed (int fd, int speed)
+{
+    struct link_settings ls;
+    struct ethtool_cmd ecmd;
+    int nwords, bit = (speed == LINK_SPEED_1G) ? ETHTOOL_LINK_MODE_1000baseT_Full_BIT :
+                                                 ETHTOOL_LINK_MODE_100baseT_Full_BIT;
+
+    if (link_get_settings (fd, &ls)) {
+        nwords = ls.req.link_mode_masks_nwords;
+        if (ls.req.autoneg == AUTONEG_ENABLE) {
+            // supported[], advertising[]
+            if (!(ls.masks[bit / 32] & (1u << (bit % 32))))
+                return 0;
+            memset (&ls.masks[nwords], 0, nwords * sizeof(__u32));
+            ls.masks[nwords + bit / 32] = 1u << (bit % 32);
+        }
+        ls.req.cmd    = ETHTOOL_SLINKSETTINGS;
+        ls.req.speed  = speed;
+        ls.req.duplex = DUPLEX_FULL;
+        return (link_ioctl (fd, SIOCETHTOOL, &ls) < 0) ? 0 : 1;
+    }
+
+    memset (&ecmd, 0, sizeof(ecmd));
+    ecmd.cmd = ETHTOOL_GSET;
+    if (link_ioctl (fd, SIOCETHTOOL, &ecmd) < 0)
+        return 0;
+    if (ecmd.autoneg == AUTONEG_ENABLE)
+        ecmd.advertising = (speed == LINK_SPEED_1G) ? ADVERTISED_1000baseT_Full :
+                                                      ADVERTISED_100baseT_Full;
+    ecmd.cmd    = ETHTOOL_SSET;
+    ecmd.duplex = DUPLEX_FULL;
+    ethtool_cmd_speed_set (&ecmd, speed);
+    return (link_ioctl (fd, SIOCETHTOOL, &ecmd) < 0) ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+static int link_event_open (void)
+{
+    struct sockaddr_nl sa;
+    int fd;
+
+    if ((fd = socket (AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE)) < 0)
+        return -1;
+
+    memset (&sa, 0, sizeof(sa));
+    sa.nl_family = AF_NETLINK;
+    sa.nl_groups = RTMGRP_LINK;
+    if (bind (fd, (struct sockaddr *)&sa, sizeof(sa)) < 0) {
+        close (fd);
+        return -1;
+    }
+    return fd;
+}
+
+//------------------------------------------------------------------------------
+// return 1 = RTM_NEWLINK of the interface received
+//------------------------------------------------------------------------------
+static int link_event_read (int nl, int ifindex)
+{
+    char buf[8192];
+    struct nlmsghdr *nh;
+    int len, found = 0;
+
+    while ((len = recv (nl, buf, sizeof(buf), MSG_DONTWAIT)) > 0) {
+        for (nh = (struct nlmsghdr *)buf; NLMSG_OK (nh, (unsigned int)len);
+             nh = NLMSG_NEXT (nh, len)) {
+            if ((nh->nlmsg_type == RTM_NEWLINK) &&
+                (((struct ifinfomsg *)NLMSG_DATA (nh))->ifi_index == ifindex))
+                found = 1;
         }
-        fclose (fp);
     }
-    return 0;
+    // ENOBUFS : events lost, recheck
+    if ((len < 0) && (errno == ENOBUFS))
+        found = 1;
+    return found;
+}
+
+//------------------------------------------------------------------------------
+// speed 0 = any. nl subscribed before the link change (no lost event)
+//------------------------------------------------------------------------------
+static int link_wait (int fd, int nl, int speed, int timeout_ms)
+{
+    struct pollfd pfd = { nl, POLLIN, 0 };
+    long long end = time_ms () + timeout_ms;
+    int ifindex = if_nametoindex (IfName), cur, left;
+
+    while (1) {
+        cur = link_speed (fd);
+        if (cur && (!speed || (cur == speed)))
+            return 1;
+
+        if ((left = (int)(end - time_ms ())) <= 0)
+            return 0;
+        if (poll (&pfd, 1, left) > 0)
+            link_event_read (nl, ifindex);
+    }
 }
 
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+void ethernet_init (const char *ifname)
+{
+    memset (IfName, 0, sizeof(IfName));
+    strncpy (IfName, ifname, IFNAMSIZ - 1);
+}
+
+//------------------------------------------------------------------------------
+// link speed (Mbps), 0 = link down
 //------------------------------------------------------------------------------
 int ethernet_link_check (void)
 {
-    return ethernet_link_speed();
+    int fd, speed;
+
+    if ((fd = socket (AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0)) < 0)
+        return 0;
+    speed = link_speed (fd);
+    close (fd);
+    return speed;
+}
+
+//------------------------------------------------------------------------------
+// time of the last ethernet_link_setup / ethernet_link_wait (msec)
+//------------------------------------------------------------------------------
+int ethernet_link_time (void)
+{
+    return LinkMs;
 }
 
+//------------------------------------------------------------------------------
+// link up (speed 0 = any speed), return 1 = up
+//------------------------------------------------------------------------------
+int ethernet_link_wait (int speed, int timeout_ms)
+{
+    long long start = time_ms ();
+    int fd, nl, ret = 0;
+
+    if ((fd = socket (AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0)) < 0)
+        return 0;
+    if ((nl = link_event_open ()) >= 0) {
+        ret = link_wait (fd, nl, speed, timeout_ms);
+        close (nl);
+    }
+    close (fd);
+
+    LinkMs = (int)(time_ms () - start);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+// return 1 = link up at the speed (timeout ETHERNET_LINK_TIMEOUT)
 //------------------------------------------------------------------------------
 int ethernet_link_setup (int speed)
 {
-    FILE *fp;
-    char cmd_line[STR_PATH_LENGTH], retry = 10;
-
-    if (ethernet_link_speed() != speed) {
-        memset (cmd_line, 0x00, sizeof(cmd_line));
-        sprintf(cmd_line,"ethtool -s eth0 speed %d duplex full", speed);
-        if ((fp = popen(cmd_line, "w")) != NULL)
-            pclose(fp);
+    long long start = time_ms ();
+    int fd, nl = -1, ret = 0;
+
+    LinkMs = 0;
+    if ((fd = socket (AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0)) < 0)
+        return 0;
+
+    if (link_speed (fd) == speed) {
+        close (fd);
+        return 1;
     }
-    // timeout 10 sec
-    while (retry--) {
-        if (ethernet_link_speed() == speed)
-            return 1;
-        sleep (1);
+    if ((nl = link_event_open ()) < 0) {
+        printf ("%s : rtnetlink error (%s)\n", __func__, strerror (errno));
+        goto out;
+    }
+    if (!link_set_speed (fd, speed)) {
+        printf ("%s : %s speed %d error (%s)\n", __func__, IfName, speed, strerror (errno));
+        goto out;
     }
-    return 0;
+    ret = link_wait (fd, nl, speed, ETHERNET_LINK_TIMEOUT);
+    LinkMs = (int)(time_ms () - start);
+    printf ("%s : %s %d Mbps %s, %d ms\n", __func__, IfName, speed, ret ? "up" : "timeout", LinkMs);
+out:
+    if (nl >= 0)
+        close (nl);
+    close (fd);
+    return ret;
 }
 
 //------------------------------------------------------------------------------
@@ -21,11 +21,18 @@
 #define LINK_SPEED_1G       1000
 #define LINK_SPEED_100M     100
 
+#define ETHERNET_IFNAME_DEF     "eth0"
+// link up after a speed change (autonegotiation)
+#define ETHERNET_LINK_TIMEOUT   10000
+
 //------------------------------------------------------------------------------
 // function prototype
 //------------------------------------------------------------------------------
-extern int ethernet_link_check (void);
-extern int ethernet_link_setup (int speed);
+extern void ethernet_init       (const char *ifname);
+extern int  ethernet_link_check (void);
+extern int  ethernet_link_setup (int speed);
+extern int  ethernet_link_wait  (int speed, int timeout_ms);
+extern int  ethernet_link_time  (void);
 
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
@@ -0,0 +1,363 @@
+//------------------------------------------------------------------------------
+/**
+ * @file gpiocdev.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Device Test library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+
+//------------------------------------------------------------------------------
+#include "sysattr.h"
+#include "gpiocdev.h"
+
+//------------------------------------------------------------------------------
+//
+// GPIO character device backend (/dev/gpiochipN).
+// Lines are requested once as outputs and held open, a set/get is one ioctl
+// per chip. GPIO_V2 line requests (kernel 5.10+), v1 line handles otherwise
+// (ODROID-M1 4.19 kernel).
+//
+//------------------------------------------------------------------------------
+struct gpio_chip {
+    char    path [PATH_MAX];
+    // global gpio number of line 0, line count
+    int     base, ngpio;
+};
+
+static struct gpio_chip GpioChip [GPIOCDEV_CHIP_MAX];
+static int              GpioChipCnt = 0;
+static pthread_mutex_t  GpioChipLock = PTHREAD_MUTEX_INITIALIZER;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+static int chip_ngpio (const char *path)
+{
+    struct gpiochip_info info;
+    int fd, ret = 0;
+
+    if ((fd = open (path, O_RDWR | O_CLOEXEC)) < 0)
+        return 0;
+
+    if (ioctl (fd, GPIO_GET_CHIPINFO_IOCTL, &info) == 0)
+        ret = info.lines;
+
+    close (fd);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+static int read_int (const char *dir, const char *name, int *value)
+{
+    char path[PATH_MAX];
+    FILE *fp;
+    int ret;
+
+    snprintf (path, sizeof(path), "%s/%s", dir, name);
+    if ((fp = fopen (path, "r")) == NULL)
+        return 0;
+    ret = (fscanf (fp, "%d", value) == 1);
+    fclose (fp);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+// /sys/class/gpio/gpiochip<base>/device/gpiochipN -> /dev/gpiochipN
+//------------------------------------------------------------------------------
+static void chip_scan_sysfs (void)
+{
+    char cls[PATH_MAX / 2], dir[PATH_MAX], dev[PATH_MAX];
+    struct dirent *e, *d;
+    DIR *dp, *ddp;
+    int base, ngpio;
+
+    sysattr_path (cls, sizeof(cls), "/sys/class/gpio");
+    if ((dp = opendir (cls)) == NULL)
+        return;
+
+    while ((e = readdir (dp)) != NULL && (GpioChipCnt < GPIOCDEV_CHIP_MAX)) {
+        if (strncmp (e->d_name, "gpiochip", 8))
+            continue;
+
+        snprintf (dir, sizeof(dir), "%s/%s", cls, e->d_name);
+        if (!read_int (dir, "base", &base) || !read_int (dir, "ngpio", &ngpio))
+            continue;
+
+        strncat (dir, "/device", sizeof(dir) - strlen (dir) -1);
+        if ((ddp = opendir (dir)) == NULL)
+            continue;
+
+        while ((d = readdir (ddp)) != NULL) {
+            if (strncmp (d->d_name, "gpiochip", 8))
+                continue;
+            snprintf (dev, sizeof(dev), "/dev/%s", d->d_name);
+            if (access (dev, R_OK | W_OK) == 0)
+                gpiocdev_add_chip (dev, base);
+            break;
+        }
+        closedir (ddp);
+    }
+    closedir (dp);
+}
+
+//------------------------------------------------------------------------------
+// no gpio sysfs class : chips in index order, bases packed from 0
+// (rockchip banks, 32 lines each)
+//------------------------------------------------------------------------------
+static void chip_scan_dev (void)
+{
+    char dev[PATH_MAX];
+    int i, base = 0, ngpio;
+
+    for (i = 0; i < GPIOCDEV_CHIP_MAX; i++) {
+        snprintf (dev, sizeof(dev), "/dev/gpiochip%d", i);
+        if ((ngpio = chip_ngpio (dev)) <= 0)
+            break;
+        gpiocdev_add_chip (dev, base);
+        base += ngpio;
+    }
+}
+
+//------------------------------------------------------------------------------
+static struct gpio_chip *chip_find (int gpio)
+{
+    int i;
+
+    for (i = 0; i < GpioChipCnt; i++) {
+        if ((gpio >= GpioChip[i].base) && (gpio < GpioChip[i].base + GpioChip[i].ngpio))
+            return &GpioChip[i];
+    }
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+static int line_request (struct gpio_chip_req *c, const char *path,
+                         const unsigned int *offset, const char *consumer)
+{
+    int fd, i;
+
+    if ((fd = open (path, O_RDWR | O_CLOEXEC)) < 0)
+        return 0;
+
+#if defined(GPIO_V2_GET_LINE_IOCTL)
+    {
+        struct gpio_v2_line_request req;
+
+        memset (&req, 0, sizeof(req));
+        for (i = 0; i < c->cnt; i++)
+            req.offsets[i] = offset[i];
+        req.num_lines    = c->cnt;
+        req.config.flags = GPIO_V2_LINE_FLAG_OUTPUT;
+        strncpy (req.consumer, consumer, sizeof(req.consumer) -1);
+
+        if (ioctl (fd, GPIO_V2_GET_LINE_IOCTL, &req) == 0) {
+            close (fd);
+            c->fd = req.fd;     c->v2 = 1;
+            return 1;
+        }
+        // v1 only kernel
+        if (errno != ENOTTY && errno != EINVAL) {
+            close (fd);
+            return 0;
+        }
+    }
+#endif
+    {
+        struct gpiohandle_request req;
+
+        memset (&req, 0, sizeof(req));
+        for (i = 0; i < c->cnt; i++)
+            req.lineoffsets[i] = offset[i];
+        req.lines = c->cnt;
+        req.flags = GPIOHANDLE_REQUEST_OUTPUT;
+        strncpy (req.consumer_label, consumer, sizeof(req.consumer_label) -1);
+
+        if (ioctl (fd, GPIO_GET_LINEHANDLE_IOCTL, &req) == 0) {
+            close (fd);
+            c->fd = req.fd;     c->v2 = 0;
+            return 1;
+        }
+    }
+    close (fd);
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// Register a chip (gpio-sim/mockup test chip, or a board without gpio sysfs).
+// Registered chips replace the automatic scan.
+//------------------------------------------------------------------------------
+int gpiocdev_add_chip (const char *path, int base)
+{
+    int ngpio, ret = 0;
+
+    if ((ngpio = chip_ngpio (path)) <= 0)
+        return 0;
+
+    pthread_mutex_lock (&GpioChipLock);
+    if (GpioChipCnt < GPIOCDEV_CHIP_MAX) {
+        strncpy (GpioChip[GpioChipCnt].path, path, PATH_MAX -1);
+        GpioChip[GpioChipCnt].base  = base;
+        GpioChip[GpioChipCnt].ngpio = ngpio;
+        GpioChipCnt++;  ret = 1;
+    }
+    pthread_mutex_unlock (&GpioChipLock);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+// gpio : global gpio numbers (sysfs numbering), requested as outputs (low).
+// return 1 = all lines held, 0 = error (nothing held)
+//------------------------------------------------------------------------------
+int gpiocdev_request (struct gpio_req *r, const int *gpio, int cnt, const char *consumer)
+{
+    unsigned int offset [GPIOCDEV_CHIP_MAX][GPIOCDEV_LINE_MAX];
+    struct gpio_chip *chip_of [GPIOCDEV_CHIP_MAX];
+    struct gpio_chip *chip;
+    int i, c;
+
+    memset (r, 0, sizeof(struct gpio_req));
+    if ((cnt <= 0) || (cnt > GPIOCDEV_LINE_MAX))
+        return 0;
+
+    if (!GpioChipCnt) {
+        chip_scan_sysfs ();
+        if (!GpioChipCnt)
+            chip_scan_dev ();
+    }
+
+    // group the lines by chip
+    for (i = 0; i < cnt; i++) {
+        if ((chip = chip_find (gpio[i])) == NULL) {
+            printf ("%s : gpio %d, no gpio chip\n", __func__, gpio[i]);
+            return 0;
+        }
+        for (c = 0; c < r->chip_cnt; c++)
+            if (chip_of[c] == chip)
+                break;
+        if (c == r->chip_cnt) {
+            if (c == GPIOCDEV_CHIP_MAX)
+                return 0;
+            chip_of[r->chip_cnt++] = chip;
+        }
+        offset[c][r->chip[c].cnt] = gpio[i] - chip->base;
+        r->chip[c].idx[r->chip[c].cnt++] = i;
+    }
+
+    for (c = 0; c < r->chip_cnt; c++) {
+        if (!line_request (&r->chip[c], chip_of[c]->path, offset[c],
+                           consumer ? consumer : "odroid-jig")) {
+            printf ("%s : %s line request error (%s)\n",
+                    __func__, chip_of[c]->path, strerror (errno));
+            r->chip_cnt = c;
+            gpiocdev_release (r);
+            return 0;
+        }
+    }
+    r->cnt = cnt;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// value[i] : level of gpio[i] (request order), one ioctl per chip
+//------------------------------------------------------------------------------
+int gpiocdev_set (struct gpio_req *r, const int *value)
+{
+    int c, i, ret = 1;
+
+    for (c = 0; c < r->chip_cnt; c++) {
+        struct gpio_chip_req *cr = &r->chip[c];
+#if defined(GPIO_V2_GET_LINE_IOCTL)
+        if (cr->v2) {
+            struct gpio_v2_line_values lv = { 0, 0 };
+
+            for (i = 0; i < cr->cnt; i++) {
+                lv.mask |= 1ULL << i;
+                if (value[cr->idx[i]])
+                    lv.bits |= 1ULL << i;
+            }
+            if (ioctl (cr->fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &lv) < 0)
+                ret = 0;
+            continue;
+        }
+#endif
+        {
+            struct gpiohandle_data hd;
+
+            memset (&hd, 0, sizeof(hd));
+            for (i = 0; i < cr->cnt; i++)
+                hd.values[i] = value[cr->idx[i]] ? 1 : 0;
+            if (ioctl (cr->fd, GPIOHANDLE_SET_LINE_VALUES_IOCTL, &hd) < 0)
+                ret = 0;
+        }
+    }
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+// read back the driven levels
+//------------------------------------------------------------------------------
+int gpiocdev_get (struct gpio_req *r, int *value)
+{
+    int c, i, ret = 1;
+
+    for (c = 0; c < r->chip_cnt; c++) {
+        struct gpio_chip_req *cr = &r->chip[c];
+#if defined(GPIO_V2_GET_LINE_IOCTL)
+        if (cr->v2) {
+            struct gpio_v2_line_values lv = { 0, 0 };
+
+            for (i = 0; i < cr->cnt; i++)
+                lv.mask |= 1ULL << i;
+            if (ioctl (cr->fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &lv) < 0)
+                ret = 0;
+            for (i = 0; i < cr->cnt; i++)
+                value[cr->idx[i]] = (lv.bits >> i) & 1;
+            continue;
+        }
+#endif
+        {
+            struct gpiohandle_data hd;
+
+            memset (&hd, 0, sizeof(hd));
+            if (ioctl (cr->fd, GPIOHANDLE_GET_LINE_VALUES_IOCTL, &hd) < 0)
+                ret = 0;
+            for (i = 0; i < cr->cnt; i++)
+                value[cr->idx[i]] = hd.values[i];
+        }
+    }
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+void gpiocdev_release (struct gpio_req *r)
+{
+    int c;
+
+    for (c = 0; c < r->chip_cnt; c++) {
+        if (r->chip[c].fd > 0)
+            close (r->chip[c].fd);
+    }
+    memset (r, 0, sizeof(struct gpio_req));
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,51 @@
+//------------------------------------------------------------------------------
+/**
+ * @file gpiocdev.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Device Test library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef __GPIOCDEV_H__
+#define __GPIOCDEV_H__
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// gpio chips, lines per request (uapi GPIO_V2_LINES_MAX / GPIOHANDLES_MAX)
+#define GPIOCDEV_CHIP_MAX   8
+#define GPIOCDEV_LINE_MAX   64
+
+// lines of one chip held by a request
+struct gpio_chip_req {
+    // line request fd, 1 = GPIO_V2 uapi, 0 = v1 handle (kernel < 5.10)
+    int fd, v2;
+    // line count, index of each line in the request gpio list
+    int cnt, idx [GPIOCDEV_LINE_MAX];
+};
+
+// output lines held open, any chip
+struct gpio_req {
+    int                     cnt, chip_cnt;
+    struct gpio_chip_req    chip [GPIOCDEV_CHIP_MAX];
+};
+
+//------------------------------------------------------------------------------
+// function prototype
+//------------------------------------------------------------------------------
+extern int  gpiocdev_add_chip   (const char *path, int base);
+extern int  gpiocdev_request    (struct gpio_req *r, const int *gpio, int cnt, const char *consumer);
+extern int  gpiocdev_set        (struct gpio_req *r, const int *value);
+extern int  gpiocdev_get        (struct gpio_req *r, int *value);
+extern void gpiocdev_release    (struct gpio_req *r);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#endif  // #define __GPIOCDEV_H__
+//------------------------------------------------------------------------------
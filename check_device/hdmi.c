@@ -24,6 +24,7 @@
 
 //------------------------------------------------------------------------------
 #include "hdmi.h"
+#include "sysattr.h"
 
 //------------------------------------------------------------------------------
 struct device_led {
@@ -64,15 +65,8 @@ struct device_led DeviceHDMI [eHDMI_END] = {
 //------------------------------------------------------------------------------
 static int hdmi_read (const char *path, char *rdata)
 {
-    FILE *fp;
-
-    // led value get
-    if ((fp = fopen(path, "r")) != NULL) {
-        fread (rdata, 1, HDMI_READ_BYTES, fp);
-        fclose(fp);
-        return 1;
-    }
-    return 0;
+    // edid (binary) / status string
+    return (sysattr_read (path, rdata, HDMI_READ_BYTES) > 0) ? 1 : 0;
 }
 
 //------------------------------------------------------------------------------
@@ -109,9 +103,8 @@ int hdmi_check (int id)
     int value = 0;
     char rdata[HDMI_READ_BYTES];
 
-    if ((id >= eHDMI_END) || (access (DeviceHDMI[id].path, R_OK) != 0)) {
+    if (id >= eHDMI_END)
         return 0;
-    }
 
     memset (rdata, 0, sizeof(rdata));
 
@@ -34,6 +34,8 @@
 
 //------------------------------------------------------------------------------
 #include "../lib_gpio/lib_gpio.h"
+#include "adcboard.h"
+#include "gpiocdev.h"
 #include "header.h"
 
 //------------------------------------------------------------------------------
@@ -41,6 +43,20 @@
 // Configuration
 //
 //------------------------------------------------------------------------------
+// settle detect : gap between CON1 reads
+#define HEADER_SETTLE_POLL_US   1000
+
+static int HeaderSettleMode     = eHEADER_SETTLE_DETECT;
+static int HeaderSettleTol      = HEADER_SETTLE_TOL_DEF;
+static int HeaderSettleTimeout  = HEADER_SETTLE_TIMEOUT_DEF;
+
+// gpio backend (header_init), cdev lines of the pattern pins
+static int              HeaderGpio = eHEADER_GPIO_CDEV;
+static struct gpio_req  HeaderReq;
+
+// last measured settle time per pattern (usec, -1 = timeout)
+static int HeaderSettleUs [eHEADER_END];
+
 //------------------------------------------------------------------------------
 //
 // ODROID-M1 Header GPIOs Define
@@ -49,7 +65,7 @@
 // Not Control
 #define NC  0
 
-const int HEADER40[] = {
+const int HEADER40[H40_PIN_CNT] = {
     // Header J2 GPIOs
      NC,        // Not used (pin 0)
      NC,  NC,   // | 01 : 3.3V     || 02 : 5.0V     |
@@ -74,125 +90,62 @@ const int HEADER40[] = {
      NC,  NC,   // | 39 : GND      || 40 : ADC.AIN5 |
 };
 
+//------------------------------------------------------------------------------
+// Patterns as pin masks (bit n = header pin n)
 //------------------------------------------------------------------------------
 #define PATTERN_COUNT   4
+#define PIN(n)          (1ULL << (n))
 
-const int H40_PATTERN[PATTERN_COUNT][sizeof(HEADER40)] = {
+// pins with a gpio (HEADER40)
+#define H40_GPIO_MASK   (PIN( 7) | PIN( 8) | PIN(10) | PIN(11) | PIN(12) | PIN(13) | \
+                         PIN(15) | PIN(16) | PIN(18) | PIN(19) | PIN(21) | PIN(22) | \
+                         PIN(23) | PIN(24) | PIN(26) | PIN(27) | PIN(28) | PIN(29) | \
+                         PIN(31) | PIN(32) | PIN(33) | PIN(35) | PIN(36))
+
+// high pins of the cross 0 pattern
+#define H40_CROSS0_MASK (PIN( 8) | PIN(11) | PIN(15) | PIN(18) | PIN(21) | PIN(24) | \
+                         PIN(28) | PIN(29) | PIN(32) | PIN(33) | PIN(36))
+
+static const struct h40_mask H40_PATTERN[PATTERN_COUNT] = {
     // Pattern 0 : ALL High
-    {
-        // Header J2 GPIOs
-         NC,        // Not used (pin 0)
-         NC,  NC,   // | 01 : 3.3V     || 02 : 5.0V     |
-         NC,  NC,   // | 03 : GPIO3_B6 || 04 : 5.0V     |
-         NC,  NC,   // | 05 : GPIO3_B5 || 06 : GND      |
-          1,   1,   // | 07 : GPIO0_B6 || 08 : GPIO3_D6 |
-         NC,   1,   // | 09 : GND      || 10 : GPIO3_D7 |
-          1,   1,   // | 11 : GPIO0_C0 || 12 : GPIO3_D0 |
-          1,  NC,   // | 13 : GPIO0_C1 || 14 : GND      |
-          1,   1,   // | 15 : GPIO3_B2 || 16 : GPIO3_C6 |
-         NC,   1,   // | 17 : 3.3V     || 18 : GPIO3_C7 |
-          1,  NC,   // | 19 : GPIO2_D1 || 20 : GND      |
-          1,   1,   // | 21 : GPIO2_D0 || 22 : GPIO3_D1 |
-          1,   1,   // | 23 : GPIO2_D3 || 24 : GPIO2_D2 |
-         NC,   1,   // | 25 : GND      || 26 : GPIO3_D2 |
-          1,   1,   // | 27 : GPIO0_B4 || 28 : GPIO0_B3 |
-          1,  NC,   // | 29 : GPIO4_C1 || 30 : GND      |
-          1,   1,   // | 31 : GPIO4_B6 || 32 : GPIO3_D3 |
-          1,  NC,   // | 33 : GPIO0_B5 || 34 : GND      |
-          1,   1,   // | 35 : GPIO3_D5 || 36 : GPIO3_D4 |
-         NC,  NC,   // | 37 : ADC.AIN4 || 38 : 1.8V     |
-         NC,  NC,   // | 39 : GND      || 40 : ADC.AIN5 |
-    },
+    { H40_GPIO_MASK, H40_GPIO_MASK,                      H40_GPIO_MASK },
     // Pattern 1 : ALL Low
-    {
-        // Header J2 GPIOs
-         NC,        // Not used (pin 0)
-         NC,  NC,   // | 01 : 3.3V     || 02 : 5.0V     |
-         NC,  NC,   // | 03 : GPIO3_B6 || 04 : 5.0V     |
-         NC,  NC,   // | 05 : GPIO3_B5 || 06 : GND      |
-          0,   0,   // | 07 : GPIO0_B6 || 08 : GPIO3_D6 |
-         NC,   0,   // | 09 : GND      || 10 : GPIO3_D7 |
-          0,   0,   // | 11 : GPIO0_C0 || 12 : GPIO3_D0 |
-          0,  NC,   // | 13 : GPIO0_C1 || 14 : GND      |
-          0,   0,   // | 15 : GPIO3_B2 || 16 : GPIO3_C6 |
-         NC,   0,   // | 17 : 3.3V     || 18 : GPIO3_C7 |
-          0,  NC,   // | 19 : GPIO2_D1 || 20 : GND      |
-          0,   0,   // | 21 : GPIO2_D0 || 22 : GPIO3_D1 |
-          0,   0,   // | 23 : GPIO2_D3 || 24 : GPIO2_D2 |
-         NC,   0,   // | 25 : GND      || 26 : GPIO3_D2 |
-          0,   0,   // | 27 : GPIO0_B4 || 28 : GPIO0_B3 |
-          0,  NC,   // | 29 : GPIO4_C1 || 30 : GND      |
-          0,   0,   // | 31 : GPIO4_B6 || 32 : GPIO3_D3 |
-          0,  NC,   // | 33 : GPIO0_B5 || 34 : GND      |
-          0,   0,   // | 35 : GPIO3_D5 || 36 : GPIO3_D4 |
-         NC,  NC,   // | 37 : ADC.AIN4 || 38 : 1.8V     |
-         NC,  NC,   // | 39 : GND      || 40 : ADC.AIN5 |
-    },
+    { H40_GPIO_MASK, 0,                                  H40_GPIO_MASK },
     // Pattern 2 : Cross 0
-    {
-        // Header J2 GPIOs
-         NC,        // Not used (pin 0)
-         NC,  NC,   // | 01 : 3.3V     || 02 : 5.0V     |
-         NC,  NC,   // | 03 : GPIO3_B6 || 04 : 5.0V     |
-         NC,  NC,   // | 05 : GPIO3_B5 || 06 : GND      |
-          0,   1,   // | 07 : GPIO0_B6 || 08 : GPIO3_D6 |
-         NC,   0,   // | 09 : GND      || 10 : GPIO3_D7 |
-          1,   0,   // | 11 : GPIO0_C0 || 12 : GPIO3_D0 |
-          0,  NC,   // | 13 : GPIO0_C1 || 14 : GND      |
-          1,   0,   // | 15 : GPIO3_B2 || 16 : GPIO3_C6 |
-         NC,   1,   // | 17 : 3.3V     || 18 : GPIO3_C7 |
-          0,  NC,   // | 19 : GPIO2_D1 || 20 : GND      |
-          1,   0,   // | 21 : GPIO2_D0 || 22 : GPIO3_D1 |
-          0,   1,   // | 23 : GPIO2_D3 || 24 : GPIO2_D2 |
-         NC,   0,   // | 25 : GND      || 26 : GPIO3_D2 |
-          0,   1,   // | 27 : GPIO0_B4 || 28 : GPIO0_B3 |
-          1,  NC,   // | 29 : GPIO4_C1 || 30 : GND      |
-          0,   1,   // | 31 : GPIO4_B6 || 32 : GPIO3_D3 |
-          1,  NC,   // | 33 : GPIO0_B5 || 34 : GND      |
-          0,   1,   // | 35 : GPIO3_D5 || 36 : GPIO3_D4 |
-         NC,  NC,   // | 37 : ADC.AIN4 || 38 : 1.8V     |
-         NC,  NC,   // | 39 : GND      || 40 : ADC.AIN5 |
-    },
+    { H40_GPIO_MASK, H40_CROSS0_MASK,                    H40_GPIO_MASK },
     // Pattern 3 : Cross 1
-    {
-        // Header J2 GPIOs
-         NC,        // Not used (pin 0)
-         NC,  NC,   // | 01 : 3.3V     || 02 : 5.0V     |
-         NC,  NC,   // | 03 : GPIO3_B6 || 04 : 5.0V     |
-         NC,  NC,   // | 05 : GPIO3_B5 || 06 : GND      |
-          1,   0,   // | 07 : GPIO0_B6 || 08 : GPIO3_D6 |
-         NC,   1,   // | 09 : GND      || 10 : GPIO3_D7 |
-          0,   1,   // | 11 : GPIO0_C0 || 12 : GPIO3_D0 |
-          1,  NC,   // | 13 : GPIO0_C1 || 14 : GND      |
-          0,   1,   // | 15 : GPIO3_B2 || 16 : GPIO3_C6 |
-         NC,   0,   // | 17 : 3.3V     || 18 : GPIO3_C7 |
-          1,  NC,   // | 19 : GPIO2_D1 || 20 : GND      |
-          0,   1,   // | 21 : GPIO2_D0 || 22 : GPIO3_D1 |
-          1,   0,   // | 23 : GPIO2_D3 || 24 : GPIO2_D2 |
-         NC,   1,   // | 25 : GND      || 26 : GPIO3_D2 |
-          1,   0,   // | 27 : GPIO0_B4 || 28 : GPIO0_B3 |
-          0,  NC,   // | 29 : GPIO4_C1 || 30 : GND      |
-          1,   0,   // | 31 : GPIO4_B6 || 32 : GPIO3_D3 |
-          0,  NC,   // | 33 : GPIO0_B5 || 34 : GND      |
-          1,   0,   // | 35 : GPIO3_D5 || 36 : GPIO3_D4 |
-         NC,  NC,   // | 37 : ADC.AIN4 || 38 : 1.8V     |
-         NC,  NC,   // | 39 : GND      || 40 : ADC.AIN5 |
-    },
+    { H40_GPIO_MASK, H40_GPIO_MASK & ~H40_CROSS0_MASK,   H40_GPIO_MASK },
 };
 
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
-static int pattern_write (int pattern)
+// drive the header gpios, high : pins set high (others low)
+//------------------------------------------------------------------------------
+static int pattern_drive (uint64_t high)
 {
-    int i;
-    if (pattern < PATTERN_COUNT) {
-        for (i = 0; i < (int)(sizeof(HEADER40)/sizeof(int)); i++) {
-            if (HEADER40[i]) {
-                gpio_set_value (HEADER40[i], H40_PATTERN[pattern][i]);
-            }
+    int i, value[H40_PIN_CNT], cnt = 0;
+
+    // whole pattern, one ioctl per gpio chip
+    if (HeaderReq.cnt) {
+        for (i = 0; i < H40_PIN_CNT; i++) {
+            if (HEADER40[i])
+                value[cnt++] = (high >> i) & 1;
         }
-        return 1;
+        return gpiocdev_set (&HeaderReq, value);
     }
+    for (i = 0; i < H40_PIN_CNT; i++) {
+        if (HEADER40[i]) {
+            gpio_set_value (HEADER40[i], (high >> i) & 1);
+        }
+    }
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+static int pattern_write (int pattern)
+{
+    if ((pattern >= 0) && (pattern < PATTERN_COUNT))
+        return pattern_drive (H40_PATTERN[pattern].high);
     return 0;
 }
 
@@ -204,38 +157,361 @@ int header_pattern_set (int id)
     return pattern_write (id);
 }
 
+//------------------------------------------------------------------------------
+int header_pattern_mask (int id, struct h40_mask *m)
+{
+    if ((id < 0) || (id >= PATTERN_COUNT))
+        return 0;
+    *m = H40_PATTERN[id];
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// pattern40[0..40] mV -> hi (>= HEADER_HIGH_MV), lo (<= HEADER_LOW_MV) pin masks
+//------------------------------------------------------------------------------
+void header_pattern_pack (const int *pattern40, uint64_t *hi, uint64_t *lo)
+{
+    uint64_t h = 0, l = 0;
+    int i;
+
+    // shift in from the last pin, no per-pin branch
+    for (i = H40_PIN_CNT -1; i >= 0; i--) {
+        h = (h << 1) | (pattern40[i] >= HEADER_HIGH_MV);
+        l = (l << 1) | (pattern40[i] <= HEADER_LOW_MV);
+    }
+    *hi = h;    *lo = l;
+}
+
+//------------------------------------------------------------------------------
+// return the failing pins (0 = pass)
+//------------------------------------------------------------------------------
+uint64_t header_pattern_fail (int id, const int *pattern40)
+{
+    const struct h40_mask *m;
+    uint64_t hi, lo;
+
+    if ((id < 0) || (id >= PATTERN_COUNT))
+        return 0;
+
+    m = &H40_PATTERN[id];
+    header_pattern_pack (pattern40, &hi, &lo);
+
+    // expected high not high, expected low not low
+    return m->care & ((m->high & ~hi) | (~m->high & ~lo));
+}
+
 //------------------------------------------------------------------------------
 int header_pattern_check (int id, int *pattern40)
+{
+    uint64_t fail = header_pattern_fail (id, pattern40);
+    char msg[512];
+    int pin, len = 0;
+
+    if (!fail)
+        return 1;
+
+    // every failing pin : pin(gpio):expected level mV
+    while (fail && (len < (int)sizeof(msg))) {
+        pin = __builtin_ctzll (fail);
+        fail &= fail - 1;
+        len += snprintf (&msg[len], sizeof(msg) - len, " %d(%d):%d %dmV",
+                         pin, HEADER40[pin], (int)((H40_PATTERN[id].high >> pin) & 1),
+                         pattern40[pin]);
+    }
+    printf ("PT%d fail pins%s\n", id, msg);
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+static long long time_us (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+//------------------------------------------------------------------------------
+// pattern40[1..40] : CON1 pin mV
+//------------------------------------------------------------------------------
+static int pattern_read (int adc_fd, int *pattern40)
+{
+    int cnt = 0;
+
+    memset (pattern40, 0, sizeof(int) * H40_PIN_CNT);
+    return adcboard_read (adc_fd, "CON1", &pattern40[1], &cnt);
+}
+
+//------------------------------------------------------------------------------
+// only the pins driven by the pattern
+//------------------------------------------------------------------------------
+static int pattern_agree (const int *prev, const int *cur)
 {
     int i;
-    if (id < PATTERN_COUNT) {
-        for (i = 0; i < (int)(sizeof(HEADER40)/sizeof(int)); i++) {
-            if (HEADER40[i]) {
-                if (H40_PATTERN[id][i]){
-                    if (pattern40[i] < 3000) {
-                        printf ("PT%d GPIO - %d : %d %dmV\n",
-                            id, HEADER40[i], H40_PATTERN[id][i], pattern40[i]);
-                        return 0;
-                    }
-                } else {
-                    if (pattern40[i] > 300) {
-                        printf ("PT%d GPIO - %d : %d %dmV\n",
-                            id, HEADER40[i], H40_PATTERN[id][i], pattern40[i]);
-                        return 0;
-                    }
-                }
+
+    for (i = 0; i < H40_PIN_CNT; i++) {
+        if (HEADER40[i] && (abs (prev[i] - cur[i]) > HeaderSettleTol))
+            return 0;
+    }
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// Drive high and read CON1 once the levels are stable.
+// pattern40 : last read (pattern40[1..40]), return 1 = settled, 0 = timeout.
+//------------------------------------------------------------------------------
+static int pattern_settle (uint64_t high, int adc_fd, int *pattern40,
+                           long long *elapsed, int *reads)
+{
+    int prev [H40_PIN_CNT], settled = 0;
+    long long start;
+
+    *elapsed = 0;   *reads = 1;
+    if (!pattern_drive (high))
+        return 0;
+
+    start = time_us ();
+    if (HeaderSettleMode == eHEADER_SETTLE_FIXED) {
+        usleep (HeaderSettleTimeout * 1000);
+        pattern_read (adc_fd, pattern40);
+        *elapsed = time_us () - start;
+        return 1;
+    }
+
+    pattern_read (adc_fd, prev);
+    while (*elapsed < (long long)HeaderSettleTimeout * 1000) {
+        usleep (HEADER_SETTLE_POLL_US);
+        pattern_read (adc_fd, pattern40);   (*reads)++;
+        *elapsed = time_us () - start;
+
+        if ((settled = pattern_agree (prev, pattern40)))
+            break;
+        memcpy (prev, pattern40, sizeof(prev));
+    }
+    return settled;
+}
+
+//------------------------------------------------------------------------------
+// Set the pattern and read CON1 once the levels are stable.
+// pattern40 : last read (pattern40[1..40]), return 1 = settled, 0 = timeout.
+//------------------------------------------------------------------------------
+int header_pattern_settle (int id, int adc_fd, int *pattern40)
+{
+    long long elapsed;
+    int reads, settled;
+
+    if ((id < 0) || (id >= PATTERN_COUNT))
+        return 0;
+
+    settled = pattern_settle (H40_PATTERN[id].high, adc_fd, pattern40, &elapsed, &reads);
+    if (HeaderSettleMode == eHEADER_SETTLE_FIXED) {
+        HeaderSettleUs[id] = HeaderSettleTimeout * 1000;
+        return settled;
+    }
+    HeaderSettleUs[id] = settled ? (int)elapsed : -1;
+
+    printf ("%s : PT%d %s %lld us, %d reads\n", __func__, id,
+            settled ? "settled" : "timeout", elapsed, reads);
+    return settled;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// Generated diagnosis patterns (short / open localization)
+//------------------------------------------------------------------------------
+// Pin k of the header gpios (HEADER40 order) gets the code k+1.
+//   eHEADER_DIAG_ADDR  : bit b of the codes and its complement, b = 0 ~ log2(N+2)
+//                        (exact for one short, several shorts may share a
+//                        signature and show as one group : use the walk modes)
+//   eHEADER_DIAG_WALK1 : pattern k drives pin k high, the others low
+//   eHEADER_DIAG_WALK0 : pattern k drives pin k low, the others high
+// return the pattern count, high[p] : pins driven high by pattern p
+//------------------------------------------------------------------------------
+int header_diag_pattern (int mode, uint64_t *high, int max)
+{
+    int pin [H40_PIN_CNT], n = 0, bits, b, k, cnt = 0;
+
+    for (k = 0; k < H40_PIN_CNT; k++)
+        if (H40_GPIO_MASK & PIN(k))
+            pin[n++] = k;
+
+    switch (mode) {
+        case eHEADER_DIAG_ADDR:
+            // codes 1 ~ N, none all-zero / all-one (bits : 2^bits - 2 >= N)
+            for (bits = 1; ((1 << bits) - 2) < n; bits++)
+                ;
+            if (2 * bits > max)
+                return 0;
+            for (b = 0; b < bits; b++) {
+                high[cnt] = 0;
+                for (k = 0; k < n; k++)
+                    if (((k + 1) >> b) & 1)
+                        high[cnt] |= PIN(pin[k]);
+                high[cnt + 1] = H40_GPIO_MASK & ~high[cnt];
+                cnt += 2;
             }
+            break;
+        case eHEADER_DIAG_WALK1:
+        case eHEADER_DIAG_WALK0:
+            if (n > max)
+                return 0;
+            for (k = 0; k < n; k++, cnt++)
+                high[cnt] = (mode == eHEADER_DIAG_WALK1) ?
+                            PIN(pin[k]) : (H40_GPIO_MASK & ~PIN(pin[k]));
+            break;
+        default:
+            return 0;
+    }
+    return cnt;
+}
+
+//------------------------------------------------------------------------------
+// hi[p] / lo[p] : read back of pattern p (header_pattern_pack).
+// Shorted pins are one node and read the same level (high, low or the mid
+// level of two fighting drivers) in every pattern; the generated codes make
+// two healthy pins differ in at least one pattern.
+//------------------------------------------------------------------------------
+int header_diag_analyze (const uint64_t *high, const uint64_t *hi,
+                         const uint64_t *lo, int cnt, struct h40_diag *d)
+{
+    uint64_t sig_hi [H40_PIN_CNT], sig_lo [H40_PIN_CNT], expect, all;
+    uint64_t grouped = 0;
+    int i, j, p;
+
+    memset (d, 0, sizeof(struct h40_diag));
+    if ((cnt <= 0) || (cnt > H40_DIAG_PATTERN_MAX))
+        return 0;
+
+    d->patterns = cnt;
+    all = (cnt == 64) ? ~0ULL : ((1ULL << cnt) - 1);
+
+    // per pin signature (bit p = level in pattern p)
+    for (i = 0; i < H40_PIN_CNT; i++) {
+        if (!(H40_GPIO_MASK & PIN(i)))
+            continue;
+        sig_hi[i] = sig_lo[i] = expect = 0;
+        for (p = 0; p < cnt; p++) {
+            sig_hi[i] |= ((hi[p]   >> i) & 1) << p;
+            sig_lo[i] |= ((lo[p]   >> i) & 1) << p;
+            expect    |= ((high[p] >> i) & 1) << p;
         }
+        if ((sig_hi[i] != expect) || (sig_lo[i] != (~expect & all)))
+            d->fail |= PIN(i);
     }
-    return 1;
+
+    // stuck at one level (open pin, short to a supply / gnd)
+    for (i = 0; i < H40_PIN_CNT; i++) {
+        if (!(d->fail & PIN(i)))
+            continue;
+        if (sig_hi[i] == all)
+            d->stuck_hi |= PIN(i);
+        else if (sig_lo[i] == all)
+            d->stuck_lo |= PIN(i);
+    }
+    grouped = d->stuck_hi | d->stuck_lo;
+
+    // other failing pins with the same signature : shorted
+    for (i = 0; i < H40_PIN_CNT; i++) {
+        if (!(d->fail & PIN(i)) || (grouped & PIN(i)))
+            continue;
+        for (j = i + 1; j < H40_PIN_CNT; j++) {
+            if (!(d->fail & PIN(j)) || (grouped & PIN(j)))
+                continue;
+            if ((sig_hi[i] == sig_hi[j]) && (sig_lo[i] == sig_lo[j])) {
+                d->shorts[d->short_cnt].a = i;
+                d->shorts[d->short_cnt].b = j;
+                d->short_cnt++;
+                grouped |= PIN(j);
+            }
+        }
+    }
+    return d->fail ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+// run the generated patterns and print the diagnosis, return 1 = no fault
+//------------------------------------------------------------------------------
+int header_diag (int mode, int adc_fd, struct h40_diag *d)
+{
+    uint64_t high [H40_DIAG_PATTERN_MAX], hi [H40_DIAG_PATTERN_MAX], lo [H40_DIAG_PATTERN_MAX];
+    int pattern40 [H40_PIN_CNT], cnt, p, reads, ret, len, i;
+    long long elapsed, start = time_us ();
+    char msg[512];
+
+    if (!(cnt = header_diag_pattern (mode, high, H40_DIAG_PATTERN_MAX)))
+        return 0;
+
+    for (p = 0; p < cnt; p++) {
+        pattern_settle (high[p], adc_fd, pattern40, &elapsed, &reads);
+        header_pattern_pack (pattern40, &hi[p], &lo[p]);
+    }
+    ret = header_diag_analyze (high, hi, lo, cnt, d);
+
+    len = snprintf (msg, sizeof(msg), "%d patterns, %lld ms", cnt, (time_us () - start) / 1000);
+    for (i = 0; (i < d->short_cnt) && (len < (int)sizeof(msg)); i++)
+        len += snprintf (&msg[len], sizeof(msg) - len, ", short %d-%d",
+                         d->shorts[i].a, d->shorts[i].b);
+    for (i = 0; (i < H40_PIN_CNT) && (len < (int)sizeof(msg)); i++) {
+        if ((d->stuck_hi | d->stuck_lo) & PIN(i))
+            len += snprintf (&msg[len], sizeof(msg) - len, ", stuck %s %d",
+                             (d->stuck_hi & PIN(i)) ? "high" : "low", i);
+    }
+    printf ("%s : %s%s\n", __func__, msg, ret ? ", no fault" : "");
+
+    // restore the idle level (all low)
+    pattern_drive (0);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+// mode : eHEADER_SETTLE_FIXED / DETECT, tol_mv, timeout_ms (-1 = keep)
+//------------------------------------------------------------------------------
+void header_set_settle (int mode, int tol_mv, int timeout_ms)
+{
+    if ((mode >= 0) && (mode < eHEADER_SETTLE_END))
+        HeaderSettleMode = mode;
+    if (tol_mv >= 0)
+        HeaderSettleTol = tol_mv;
+    if (timeout_ms > 0)
+        HeaderSettleTimeout = timeout_ms;
+}
+
+//------------------------------------------------------------------------------
+// last settle time of the pattern (usec, -1 = timeout / not run)
+//------------------------------------------------------------------------------
+int header_settle_us (int id)
+{
+    return ((id >= 0) && (id < eHEADER_END)) ? HeaderSettleUs[id] : -1;
+}
+
+//------------------------------------------------------------------------------
+// backend : eHEADER_GPIO_CDEV / eHEADER_GPIO_SYSFS (before header_init)
+//------------------------------------------------------------------------------
+void header_set_gpio (int backend)
+{
+    if ((backend >= 0) && (backend < eHEADER_GPIO_END))
+        HeaderGpio = backend;
 }
 
 //------------------------------------------------------------------------------
 int header_init (void)
 {
-    int i;
+    int i, gpio[H40_PIN_CNT], cnt = 0;
+
+    for (i = 0; i < eHEADER_END; i++)
+        HeaderSettleUs[i] = -1;
+
+    if (HeaderGpio == eHEADER_GPIO_CDEV) {
+        for (i = 0; i < H40_PIN_CNT; i++) {
+            if (HEADER40[i])
+                gpio[cnt++] = HEADER40[i];
+        }
+        if (gpiocdev_request (&HeaderReq, gpio, cnt, "jig-header"))
+            return 1;
+        printf ("%s : gpio cdev error, sysfs gpio used.\n", __func__);
+    }
 
-    for (i = 0; i < (int)(sizeof(HEADER40)/sizeof(int)); i++) {
+    for (i = 0; i < H40_PIN_CNT; i++) {
         if (HEADER40[i]) {
             gpio_export    (HEADER40[i]);
             gpio_direction (HEADER40[i], GPIO_DIR_OUT);
@@ -16,6 +16,8 @@
 #ifndef __HEADER_H__
 #define __HEADER_H__
 
+#include <stdint.h>
+
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 // Define the Device ID for the HEADER group.
@@ -28,12 +30,81 @@ enum {
     eHEADER_END
 };
 
+//------------------------------------------------------------------------------
+// pattern settle (pattern set -> CON1 adc read)
+enum {
+    // fixed delay (timeout)
+    eHEADER_SETTLE_FIXED = 0,
+    // re-sample until two consecutive reads agree (tolerance), up to timeout
+    eHEADER_SETTLE_DETECT,
+    eHEADER_SETTLE_END
+};
+
+// header pins 1 ~ 40 (index 0 not used)
+#define H40_PIN_CNT     41
+
+// pattern check threshold (mV)
+#define HEADER_HIGH_MV  3000
+#define HEADER_LOW_MV   300
+
+// pattern pin masks (bit n = pin n)
+struct h40_mask {
+    // pins driven by the pattern, expected high, checked pins
+    uint64_t drive, high, care;
+};
+
+// generated diagnosis patterns (header_diag)
+enum {
+    // binary address sequence + complement, 2 * log2(N+2) patterns
+    eHEADER_DIAG_ADDR = 0,
+    // one pin high / one pin low at a time, N patterns
+    eHEADER_DIAG_WALK1,
+    eHEADER_DIAG_WALK0,
+    eHEADER_DIAG_END
+};
+
+#define H40_DIAG_PATTERN_MAX    64
+
+struct h40_diag {
+    // patterns run, pins with a wrong level in any pattern
+    int         patterns;
+    uint64_t    fail;
+    // fault pins at the same level in every pattern (open, supply / gnd short)
+    uint64_t    stuck_hi, stuck_lo;
+    // shorted pin pairs (header pin numbers)
+    int         short_cnt;
+    struct { int a, b; } shorts [H40_PIN_CNT];
+};
+
+// pattern gpio backend
+enum {
+    // /dev/gpiochipN, lines held open, one ioctl per chip per pattern
+    eHEADER_GPIO_CDEV = 0,
+    // /sys/class/gpio, one write per pin
+    eHEADER_GPIO_SYSFS,
+    eHEADER_GPIO_END
+};
+
+#define HEADER_SETTLE_TOL_DEF       100     // mV
+#define HEADER_SETTLE_TIMEOUT_DEF   100     // ms
+
 //------------------------------------------------------------------------------
 // function prototype
 //------------------------------------------------------------------------------
-extern int header_pattern_set   (int id);
-extern int header_pattern_check (int id, int *pattern40);
-extern int header_init          (void);
+extern int  header_pattern_set      (int id);
+extern int  header_pattern_check    (int id, int *pattern40);
+extern int  header_pattern_mask     (int id, struct h40_mask *m);
+extern void header_pattern_pack     (const int *pattern40, uint64_t *hi, uint64_t *lo);
+extern uint64_t header_pattern_fail (int id, const int *pattern40);
+extern int  header_pattern_settle   (int id, int adc_fd, int *pattern40);
+extern void header_set_settle       (int mode, int tol_mv, int timeout_ms);
+extern int  header_settle_us        (int id);
+extern int  header_diag_pattern     (int mode, uint64_t *high, int max);
+extern int  header_diag_analyze     (const uint64_t *high, const uint64_t *hi,
+                                     const uint64_t *lo, int cnt, struct h40_diag *d);
+extern int  header_diag             (int mode, int adc_fd, struct h40_diag *d);
+extern void header_set_gpio         (int backend);
+extern int  header_init             (void);
 
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
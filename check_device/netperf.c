@@ -0,0 +1,763 @@
+//------------------------------------------------------------------------------
+/**
+ * @file netperf.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Device Test library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// sendmmsg / recvmmsg
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <netdb.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <linux/errqueue.h>
+
+//------------------------------------------------------------------------------
+#include "netperf.h"
+
+//------------------------------------------------------------------------------
+//
+// In-process throughput test (iperf3 replacement, no process spawn).
+// The client sends a request on a tcp control connection and waits for the
+// server ack. tcp data follows on the same connection (MSG_ZEROCOPY when
+// available) up to shutdown, udp datagrams (sendmmsg, paced to rate_mbps)
+// go to the udp socket of the same port and end with a fin message carrying
+// the sent count. The server answers with the receiver report : bytes,
+// elapsed time, datagrams, out of order and jitter (RFC 3550).
+//
+//------------------------------------------------------------------------------
+// "NPF1"
+#define NETPERF_MAGIC   0x4E504631
+
+enum { eMSG_REQ = 1, eMSG_ACK, eMSG_FIN, eMSG_REPORT };
+
+// control message (network byte order)
+//  REQ    : w[0] mode, w[1] duration_ms, w[2] len, w[3] rate_mbps
+//  ACK    : w[0] err
+//  FIN    : w[0..1] sent datagrams
+//  REPORT : w[0..1] bytes, w[2..3] elapsed_us, w[4..5] packets,
+//           w[6] reorder, w[7] jitter_us, w[8] err
+struct ctrl_msg {
+    uint32_t    magic, type, cookie, w[9];
+};
+
+// udp datagram header (network byte order), send time CLOCK_REALTIME usec
+struct dgram_hdr {
+    uint32_t    cookie, seq, ts_hi, ts_lo;
+};
+
+// udp receive buffer request
+#define NETPERF_SOCK_BUF    (4 * 1024 * 1024)
+
+//------------------------------------------------------------------------------
+static long long time_us (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+//------------------------------------------------------------------------------
+// datagram stamps (kernel SO_TIMESTAMPNS uses the same clock)
+//------------------------------------------------------------------------------
+static long long real_us (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_REALTIME, &ts);
+    return (long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+//------------------------------------------------------------------------------
+static void put64 (uint32_t *w, long long v)
+{
+    w[0] = htonl ((uint32_t)((unsigned long long)v >> 32));
+    w[1] = htonl ((uint32_t)v);
+}
+
+//------------------------------------------------------------------------------
+static long long get64 (const uint32_t *w)
+{
+    return (long long)(((unsigned long long)ntohl (w[0]) << 32) | ntohl (w[1]));
+}
+
+//------------------------------------------------------------------------------
+static void msg_init (struct ctrl_msg *m, int type, uint32_t cookie)
+{
+    memset (m, 0, sizeof(struct ctrl_msg));
+    m->magic  = htonl (NETPERF_MAGIC);
+    m->type   = htonl (type);
+    m->cookie = htonl (cookie);
+}
+
+//------------------------------------------------------------------------------
+static int msg_send (int fd, const struct ctrl_msg *m)
+{
+    const char *p = (const char *)m;
+    int len = sizeof(struct ctrl_msg), ret;
+
+    while (len) {
+        if ((ret = send (fd, p, len, MSG_NOSIGNAL)) < 0) {
+            if (errno == EINTR)
+                continue;
+            return 0;
+        }
+        p += ret;   len -= ret;
+    }
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// return 1 = message of the type received
+//------------------------------------------------------------------------------
+static int msg_recv (int fd, struct ctrl_msg *m, int type, int timeout_ms)
+{
+    struct pollfd pfd = { fd, POLLIN, 0 };
+    char *p = (char *)m;
+    int len = sizeof(struct ctrl_msg), ret;
+    long long end = time_us () + (long long)timeout_ms * 1000;
+
+    while (len) {
+        if ((ret = (int)((end - time_us ()) / 1000)) < 0) {
+            errno = ETIMEDOUT;
+            return 0;
+        }
+        if ((ret = poll (&pfd, 1, ret)) <= 0) {
+            if (ret < 0 && errno == EINTR)
+                continue;
+            if (!ret)
+                errno = ETIMEDOUT;
+            return 0;
+        }
+        if ((ret = recv (fd, p, len, 0)) <= 0) {
+            if (ret < 0 && errno == EINTR)
+                continue;
+            if (!ret)
+                errno = ECONNRESET;
+            return 0;
+        }
+        p += ret;   len -= ret;
+    }
+    if ((ntohl (m->magic) != NETPERF_MAGIC) || (ntohl (m->type) != (uint32_t)type)) {
+        errno = EPROTO;
+        return 0;
+    }
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+static void sock_buf (int fd, int opt, int force)
+{
+    int size = NETPERF_SOCK_BUF;
+
+    // root may exceed net.core.[rw]mem_max
+    if (setsockopt (fd, SOL_SOCKET, force, &size, sizeof(size)) < 0)
+        setsockopt (fd, SOL_SOCKET, opt, &size, sizeof(size));
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// client
+//------------------------------------------------------------------------------
+static int ctrl_connect (const struct netperf_cfg *cfg, struct sockaddr_in *sa)
+{
+    struct addrinfo hints, *ai;
+    struct pollfd pfd;
+    socklen_t len = sizeof(int);
+    int fd, err = 0;
+
+    memset (&hints, 0, sizeof(hints));
+    hints.ai_family   = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo (cfg->host, NULL, &hints, &ai)) {
+        errno = EHOSTUNREACH;
+        return -1;
+    }
+    memcpy (sa, ai->ai_addr, sizeof(struct sockaddr_in));
+    sa->sin_port = htons (cfg->port);
+    freeaddrinfo (ai);
+
+    if ((fd = socket (AF_INET, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0)) < 0)
+        return -1;
+
+    // no server (nlp host without netperf) : fail in NETPERF_CTRL_TIMEOUT
+    if (connect (fd, (struct sockaddr *)sa, sizeof(struct sockaddr_in)) < 0) {
+        if (errno != EINPROGRESS)
+            goto err;
+        pfd.fd = fd;    pfd.events = POLLOUT;   pfd.revents = 0;
+        if (poll (&pfd, 1, NETPERF_CTRL_TIMEOUT) <= 0) {
+            errno = ETIMEDOUT;
+            goto err;
+        }
+        if (getsockopt (fd, SOL_SOCKET, SO_ERROR, &err, &len) || err) {
+            errno = err ? err : EIO;
+            goto err;
+        }
+    }
+    fcntl (fd, F_SETFL, fcntl (fd, F_GETFL) & ~O_NONBLOCK);
+    return fd;
+err:
+    err = errno;
+    close (fd);
+    errno = err;
+    return -1;
+}
+
+//------------------------------------------------------------------------------
+// MSG_ZEROCOPY completions. return completions not copied by the kernel
+//------------------------------------------------------------------------------
+static int zc_reap (int fd, int *copied)
+{
+    char control[128];
+    struct msghdr msg;
+    struct cmsghdr *cm;
+    struct sock_extended_err *ee;
+    int done = 0;
+
+    while (1) {
+        memset (&msg, 0, sizeof(msg));
+        msg.msg_control    = control;
+        msg.msg_controllen = sizeof(control);
+        if (recvmsg (fd, &msg, MSG_ERRQUEUE) < 0)
+            break;
+        for (cm = CMSG_FIRSTHDR (&msg); cm; cm = CMSG_NXTHDR (&msg, cm)) {
+            ee = (struct sock_extended_err *)CMSG_DATA (cm);
+            if ((ee->ee_errno != 0) || (ee->ee_origin != SO_EE_ORIGIN_ZEROCOPY))
+                continue;
+            // completion range ee_info .. ee_data
+            if (ee->ee_code & SO_EE_CODE_ZEROCOPY_COPIED)
+                *copied = 1;
+            else
+                done++;
+        }
+    }
+    return done;
+}
+
+//------------------------------------------------------------------------------
+static int run_tcp (int fd, const struct netperf_cfg *cfg, struct netperf_result *r)
+{
+    long long end = time_us () + (long long)cfg->duration_ms * 1000;
+    int flags = MSG_NOSIGNAL, zc = 0, copied = 0, cnt = 0, ret;
+    char *buf;
+
+    if ((buf = (char *)malloc (cfg->len)) == NULL) {
+        r->err = ENOMEM;
+        return 0;
+    }
+    // non-zero pattern
+    memset (buf, 0xA5, cfg->len);
+
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+    if (cfg->zerocopy && !setsockopt (fd, SOL_SOCKET, SO_ZEROCOPY, &(int){1}, sizeof(int))) {
+        flags |= MSG_ZEROCOPY;
+        zc = 1;
+    }
+#endif
+    // buf is never written while the kernel holds it (zerocopy)
+    while (time_us () < end) {
+        if ((ret = send (fd, buf, cfg->len, flags)) < 0) {
+            if (errno == EINTR)
+                continue;
+            // zerocopy notification limit (optmem) : reap, copy this one
+            if (zc && (errno == ENOBUFS)) {
+                zc_reap (fd, &copied);
+                if ((ret = send (fd, buf, cfg->len, MSG_NOSIGNAL)) >= 0)
+                    goto sent;
+            }
+            r->err = errno;
+            break;
+        }
+sent:
+        r->sent_bytes += ret;
+        r->sent++;
+        if (zc && !(++cnt % 16))
+            zc_reap (fd, &copied);
+    }
+    if (zc)
+        zc_reap (fd, &copied);
+    // loopback / no sg support : the kernel copies (reported as not zerocopy)
+    r->zerocopy = zc && !copied;
+
+    shutdown (fd, SHUT_WR);
+    free (buf);
+    return r->err ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+static int run_udp (int fd, uint32_t cookie, const struct netperf_cfg *cfg,
+                    const struct sockaddr_in *sa, struct netperf_result *r)
+{
+    struct mmsghdr      msgs[NETPERF_BATCH];
+    struct iovec        iov [NETPERF_BATCH][2];
+    struct dgram_hdr    hdr [NETPERF_BATCH];
+    struct ctrl_msg     m;
+    long long start, now, due, wait_us;
+    int ufd, i, cnt, ret;
+    char *payload;
+
+    if ((ufd = socket (AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0)) < 0) {
+        r->err = errno;
+        return 0;
+    }
+    if (((payload = (char *)malloc (cfg->len)) == NULL) ||
+        (connect (ufd, (const struct sockaddr *)sa, sizeof(struct sockaddr_in)) < 0)) {
+        r->err = payload ? errno : ENOMEM;
+        goto out;
+    }
+    sock_buf (ufd, SO_SNDBUF, SO_SNDBUFFORCE);
+    memset (payload, 0xA5, cfg->len);
+
+    memset (msgs, 0, sizeof(msgs));
+    for (i = 0; i < NETPERF_BATCH; i++) {
+        iov[i][0].iov_base = &hdr[i];
+        iov[i][0].iov_len  = sizeof(struct dgram_hdr);
+        iov[i][1].iov_base = payload;
+        iov[i][1].iov_len  = cfg->len - sizeof(struct dgram_hdr);
+        msgs[i].msg_hdr.msg_iov    = iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 2;
+    }
+
+    start = time_us ();
+    while ((now = time_us ()) < start + (long long)cfg->duration_ms * 1000) {
+        cnt = NETPERF_BATCH;
+        if (cfg->rate_mbps) {
+            // datagrams due at this time
+            due = ((now - start) * cfg->rate_mbps) / (8LL * cfg->len) + 1 - r->sent;
+            if (due <= 0) {
+                wait_us = ((r->sent * 8LL * cfg->len) / cfg->rate_mbps) - (now - start);
+                if (wait_us > 0)
+                    nanosleep (&(struct timespec){ 0, wait_us * 1000 }, NULL);
+                continue;
+            }
+            if (due < cnt)
+                cnt = (int)due;
+        }
+        for (i = 0; i < cnt; i++) {
+            long long ts = real_us ();
+
+            hdr[i].cookie = htonl (cookie);
+            hdr[i].seq    = htonl ((uint32_t)(r->sent + i));
+            hdr[i].ts_hi  = htonl ((uint32_t)((unsigned long long)ts >> 32));
+            hdr[i].ts_lo  = htonl ((uint32_t)ts);
+        }
+        if ((ret = sendmmsg (ufd, msgs, cnt, 0)) < 0) {
+            // tx queue full
+            if ((errno == EINTR) || (errno == ENOBUFS) || (errno == EAGAIN))
+                continue;
+            r->err = errno;
+            break;
+        }
+        r->sent       += ret;
+        r->sent_bytes += (long long)ret * cfg->len;
+    }
+
+    msg_init (&m, eMSG_FIN, cookie);
+    put64 (&m.w[0], r->sent);
+    if (!r->err && !msg_send (fd, &m))
+        r->err = errno;
+out:
+    free (payload);
+    close (ufd);
+    return r->err ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+void netperf_default (struct netperf_cfg *cfg, const char *host, int mode)
+{
+    memset (cfg, 0, sizeof(struct netperf_cfg));
+
+    cfg->host        = host;
+    cfg->port        = NETPERF_PORT;
+    cfg->mode        = mode;
+    cfg->duration_ms = NETPERF_DEFAULT_TIME;
+    cfg->len         = (mode == eNETPERF_UDP) ? NETPERF_DEFAULT_UDP_LEN : NETPERF_DEFAULT_TCP_LEN;
+    cfg->rate_mbps   = (mode == eNETPERF_UDP) ? NETPERF_DEFAULT_RATE : 0;
+    cfg->zerocopy    = 1;
+}
+
+//------------------------------------------------------------------------------
+// return receiver Mbit/s (0 = error)
+//------------------------------------------------------------------------------
+int netperf_run (const struct netperf_cfg *cfg, struct netperf_result *r)
+{
+    struct sockaddr_in sa;
+    struct ctrl_msg m;
+    uint32_t cookie;
+    int fd, ok;
+
+    memset (r, 0, sizeof(struct netperf_result));
+
+    if ((cfg->host == NULL) || (cfg->duration_ms <= 0) || (cfg->rate_mbps < 0) ||
+        (cfg->len < (int)sizeof(struct dgram_hdr)) ||
+        ((cfg->mode == eNETPERF_UDP) && (cfg->len > 65507))) {
+        r->err = EINVAL;
+        return 0;
+    }
+    if ((fd = ctrl_connect (cfg, &sa)) < 0) {
+        r->err = errno;
+        return 0;
+    }
+    cookie = (uint32_t)(time_us () ^ ((long long)getpid () << 16));
+
+    msg_init (&m, eMSG_REQ, cookie);
+    m.w[0] = htonl (cfg->mode);
+    m.w[1] = htonl (cfg->duration_ms);
+    m.w[2] = htonl (cfg->len);
+    m.w[3] = htonl (cfg->rate_mbps);
+    if (!msg_send (fd, &m) || !msg_recv (fd, &m, eMSG_ACK, NETPERF_CTRL_TIMEOUT)) {
+        r->err = errno;
+        goto out;
+    }
+    if (m.w[0]) {
+        r->err = ntohl (m.w[0]);
+        goto out;
+    }
+
+    if (cfg->mode == eNETPERF_UDP)
+        ok = run_udp (fd, cookie, cfg, &sa, r);
+    else
+        ok = run_tcp (fd, cfg, r);
+
+    if (!ok || !msg_recv (fd, &m, eMSG_REPORT, NETPERF_CTRL_TIMEOUT)) {
+        if (!r->err)
+            r->err = errno;
+        goto out;
+    }
+    r->bytes      = get64 (&m.w[0]);
+    r->elapsed_us = get64 (&m.w[2]);
+    r->packets    = get64 (&m.w[4]);
+    r->reorder    = ntohl (m.w[6]);
+    r->jitter_us  = ntohl (m.w[7]);
+    r->err        = ntohl (m.w[8]);
+    if (cfg->mode == eNETPERF_UDP)
+        r->lost = (r->sent > r->packets) ? r->sent - r->packets : 0;
+    // bits per usec == Mbit/s
+    if (r->elapsed_us)
+        r->mbps = (int)((r->bytes * 8) / r->elapsed_us);
+out:
+    close (fd);
+    return r->err ? 0 : r->mbps;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// server
+//------------------------------------------------------------------------------
+struct udp_stat {
+    long long   bytes, packets, reorder, first_us, last_us, prev_transit;
+    long long   max_seq;
+    double      jitter;
+};
+
+//------------------------------------------------------------------------------
+static void udp_account (struct udp_stat *st, uint32_t cookie, const char *buf,
+                         int len, const struct msghdr *mh)
+{
+    const struct dgram_hdr *h = (const struct dgram_hdr *)buf;
+    struct cmsghdr *cm;
+    long long rx = 0, seq, transit, d;
+
+    if ((len < (int)sizeof(struct dgram_hdr)) || (ntohl (h->cookie) != cookie))
+        return;
+
+    for (cm = CMSG_FIRSTHDR (mh); cm; cm = CMSG_NXTHDR ((struct msghdr *)mh, cm)) {
+        if ((cm->cmsg_level == SOL_SOCKET) && (cm->cmsg_type == SCM_TIMESTAMPNS)) {
+            struct timespec ts;
+
+            memcpy (&ts, CMSG_DATA (cm), sizeof(ts));
+            rx = (long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+        }
+    }
+    if (!rx)
+        rx = real_us ();
+
+    seq = ntohl (h->seq);
+    if (seq <= st->max_seq)
+        st->reorder++;
+    else
+        st->max_seq = seq;
+
+    // RFC 3550 interarrival jitter
+    transit = rx - (long long)(((unsigned long long)ntohl (h->ts_hi) << 32) | ntohl (h->ts_lo));
+    if (st->packets) {
+        d = transit - st->prev_transit;
+        st->jitter += ((double)(d < 0 ? -d : d) - st->jitter) / 16;
+    } else {
+        st->first_us = rx;
+    }
+    st->prev_transit = transit;
+    st->last_us      = rx;
+    st->packets++;
+    st->bytes += len;
+}
+
+//------------------------------------------------------------------------------
+static int udp_drain (netperf_server_t *s, struct udp_stat *st, uint32_t cookie,
+                      char *buf, int len)
+{
+    struct mmsghdr  msgs[NETPERF_BATCH];
+    struct iovec    iov [NETPERF_BATCH];
+    char            ctrl[NETPERF_BATCH][64];
+    int i, ret, total = 0;
+
+    while (1) {
+        memset (msgs, 0, sizeof(msgs));
+        for (i = 0; i < NETPERF_BATCH; i++) {
+            iov[i].iov_base = buf + (long)i * len;
+            iov[i].iov_len  = len;
+            msgs[i].msg_hdr.msg_iov        = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen     = 1;
+            msgs[i].msg_hdr.msg_control    = ctrl[i];
+            msgs[i].msg_hdr.msg_controllen = sizeof(ctrl[i]);
+        }
+        if ((ret = recvmmsg (s->ufd, msgs, NETPERF_BATCH, MSG_DONTWAIT, NULL)) <= 0)
+            break;
+        for (i = 0; i < ret; i++)
+            udp_account (st, cookie, iov[i].iov_base, msgs[i].msg_len, &msgs[i].msg_hdr);
+        total += ret;
+    }
+    return total;
+}
+
+//------------------------------------------------------------------------------
+static int serve_udp (netperf_server_t *s, int cfd, uint32_t cookie, int duration_ms,
+                      int len, struct ctrl_msg *rep)
+{
+    struct pollfd pfd[2] = { { s->ufd, POLLIN, 0 }, { cfd, POLLIN, 0 } };
+    long long end = time_us () + (long long)(duration_ms + NETPERF_CTRL_TIMEOUT) * 1000;
+    struct udp_stat st;
+    struct ctrl_msg m;
+    long long sent = -1;
+    char *buf;
+    int ret, err = 0;
+
+    if ((buf = (char *)malloc ((size_t)len * NETPERF_BATCH)) == NULL)
+        return ENOMEM;
+    memset (&st, 0, sizeof(st));
+    st.max_seq = -1;
+
+    while (1) {
+        if ((ret = (int)((end - time_us ()) / 1000)) < 0) {
+            err = ETIMEDOUT;
+            break;
+        }
+        // after the fin : only the datagrams still in flight
+        if ((sent >= 0) && (ret > NETPERF_UDP_GRACE_MS))
+            ret = NETPERF_UDP_GRACE_MS;
+        if ((ret = poll (pfd, (sent < 0) ? 2 : 1, ret)) < 0) {
+            if (errno == EINTR)
+                continue;
+            err = errno;
+            break;
+        }
+        if (!ret) {
+            if (sent < 0)
+                err = ETIMEDOUT;
+            break;
+        }
+        if (pfd[0].revents & POLLIN)
+            udp_drain (s, &st, cookie, buf, len);
+        if ((sent < 0) && (pfd[1].revents & (POLLIN | POLLHUP | POLLERR))) {
+            if (!msg_recv (cfd, &m, eMSG_FIN, NETPERF_CTRL_TIMEOUT)) {
+                err = errno;
+                break;
+            }
+            sent = get64 (&m.w[0]);
+        }
+        // every datagram received, no grace wait
+        if ((sent >= 0) && (st.packets >= sent))
+            break;
+    }
+    free (buf);
+
+    put64 (&rep->w[0], st.bytes);
+    put64 (&rep->w[2], st.last_us - st.first_us);
+    put64 (&rep->w[4], st.packets);
+    rep->w[6] = htonl ((uint32_t)st.reorder);
+    rep->w[7] = htonl ((uint32_t)st.jitter);
+    return err;
+}
+
+//------------------------------------------------------------------------------
+static int serve_tcp (int cfd, int duration_ms, struct ctrl_msg *rep)
+{
+    struct pollfd pfd = { cfd, POLLIN, 0 };
+    long long end = time_us () + (long long)(duration_ms + NETPERF_CTRL_TIMEOUT) * 1000;
+    long long bytes = 0, first = 0, last = 0;
+    int ret, err = 0, size = NETPERF_DEFAULT_TCP_LEN;
+    char *buf;
+
+    if ((buf = (char *)malloc (size)) == NULL)
+        return ENOMEM;
+
+    // data up to the client shutdown
+    while (1) {
+        if ((ret = (int)((end - time_us ()) / 1000)) < 0) {
+            err = ETIMEDOUT;
+            break;
+        }
+        if ((ret = poll (&pfd, 1, ret)) <= 0) {
+            if ((ret < 0) && (errno == EINTR))
+                continue;
+            err = ret ? errno : ETIMEDOUT;
+            break;
+        }
+        if ((ret = recv (cfd, buf, size, 0)) < 0) {
+            if (errno == EINTR)
+                continue;
+            err = errno;
+            break;
+        }
+        if (!ret)
+            break;
+        last = time_us ();
+        if (!bytes)
+            first = last;
+        bytes += ret;
+    }
+    free (buf);
+
+    put64 (&rep->w[0], bytes);
+    put64 (&rep->w[2], last - first);
+    return err;
+}
+
+//------------------------------------------------------------------------------
+static void serve_one (netperf_server_t *s, int cfd)
+{
+    struct ctrl_msg m, rep;
+    uint32_t cookie;
+    int mode, duration_ms, len, err = 0;
+    char drop[64];
+
+    if (!msg_recv (cfd, &m, eMSG_REQ, NETPERF_CTRL_TIMEOUT))
+        return;
+
+    cookie      = ntohl (m.cookie);
+    mode        = ntohl (m.w[0]);
+    duration_ms = ntohl (m.w[1]);
+    len         = ntohl (m.w[2]);
+
+    if (((mode != eNETPERF_TCP) && (mode != eNETPERF_UDP)) || (duration_ms <= 0) ||
+        (len < (int)sizeof(struct dgram_hdr)) || ((mode == eNETPERF_UDP) && (len > 65507)))
+        err = EINVAL;
+
+    // datagrams left from an aborted test
+    if (mode == eNETPERF_UDP)
+        while (recv (s->ufd, drop, sizeof(drop), MSG_DONTWAIT) > 0)
+            ;
+
+    msg_init (&m, eMSG_ACK, cookie);
+    m.w[0] = htonl (err);
+    if (!msg_send (cfd, &m) || err)
+        return;
+
+    msg_init (&rep, eMSG_REPORT, cookie);
+    if (mode == eNETPERF_UDP)
+        err = serve_udp (s, cfd, cookie, duration_ms, len, &rep);
+    else
+        err = serve_tcp (cfd, duration_ms, &rep);
+    rep.w[8] = htonl (err);
+    msg_send (cfd, &rep);
+
+    printf ("%s : %s %lld bytes, %lld usec, %lld packets, err %d\n", __func__,
+            (mode == eNETPERF_UDP) ? "udp" : "tcp", get64 (&rep.w[0]),
+            get64 (&rep.w[2]), get64 (&rep.w[4]), err);
+}
+
+//------------------------------------------------------------------------------
+netperf_server_t *netperf_server_init (int port)
+{
+    struct sockaddr_in sa;
+    netperf_server_t *s;
+    int on = 1;
+
+    if ((s = (netperf_server_t *)calloc (1, sizeof(netperf_server_t))) == NULL)
+        return NULL;
+    s->port = port;
+    s->lfd  = s->ufd = -1;
+
+    memset (&sa, 0, sizeof(sa));
+    sa.sin_family      = AF_INET;
+    sa.sin_addr.s_addr = htonl (INADDR_ANY);
+    sa.sin_port        = htons (port);
+
+    s->lfd = socket (AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    s->ufd = socket (AF_INET, SOCK_DGRAM  | SOCK_CLOEXEC, 0);
+    if ((s->lfd < 0) || (s->ufd < 0))
+        goto err;
+
+    setsockopt (s->lfd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    setsockopt (s->ufd, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(on));
+    sock_buf (s->ufd, SO_RCVBUF, SO_RCVBUFFORCE);
+
+    if ((bind (s->lfd, (struct sockaddr *)&sa, sizeof(sa)) < 0) || (listen (s->lfd, 4) < 0) ||
+        (bind (s->ufd, (struct sockaddr *)&sa, sizeof(sa)) < 0))
+        goto err;
+
+    return s;
+err:
+    printf ("%s : port %d error (%s)\n", __func__, port, strerror (errno));
+    netperf_server_close (s);
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+// one client at a time. count 0 = forever, stop is checked every 200 ms.
+// return tests served
+//------------------------------------------------------------------------------
+int netperf_server_run (netperf_server_t *s, int count, volatile int *stop)
+{
+    struct pollfd pfd = { s->lfd, POLLIN, 0 };
+    int cfd, served = 0;
+
+    while ((!count || (served < count)) && !(stop && *stop)) {
+        if (poll (&pfd, 1, 200) <= 0)
+            continue;
+        if ((cfd = accept4 (s->lfd, NULL, NULL, SOCK_CLOEXEC)) < 0)
+            continue;
+        serve_one (s, cfd);
+        close (cfd);
+        served++;
+        s->served++;
+    }
+    return served;
+}
+
+//------------------------------------------------------------------------------
+void netperf_server_close (netperf_server_t *s)
+{
+    if (s == NULL)
+        return;
+    if (s->lfd >= 0)
+        close (s->lfd);
+    if (s->ufd >= 0)
+        close (s->ufd);
+    free (s);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,85 @@
+//------------------------------------------------------------------------------
+/**
+ * @file netperf.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Device Test library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef __NETPERF_H__
+#define __NETPERF_H__
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// server port (tcp control/data, udp data), iperf3 uses 5201
+#define NETPERF_PORT            5202
+
+#define NETPERF_DEFAULT_TIME    2000
+#define NETPERF_DEFAULT_TCP_LEN (128 * 1024)
+#define NETPERF_DEFAULT_UDP_LEN 1448
+// udp send rate (Mbit/s, 0 = unlimited)
+#define NETPERF_DEFAULT_RATE    950
+
+// datagrams per sendmmsg / recvmmsg
+#define NETPERF_BATCH           32
+// udp datagrams still in flight after the client fin (msec)
+#define NETPERF_UDP_GRACE_MS    50
+// connect / control reply timeout (msec)
+#define NETPERF_CTRL_TIMEOUT    3000
+
+enum { eNETPERF_TCP = 0, eNETPERF_UDP };
+
+struct netperf_cfg {
+    const char  *host;
+    int         port;
+    // eNETPERF_TCP / eNETPERF_UDP
+    int         mode;
+    // send time (msec), write / datagram size (bytes), udp rate (Mbit/s)
+    int         duration_ms, len, rate_mbps;
+    // 1 = MSG_ZEROCOPY (tcp) when the kernel supports it
+    int         zerocopy;
+};
+
+struct netperf_result {
+    // receiver throughput (Mbit/s)
+    int         mbps;
+    // received bytes, receiver elapsed time (usec, first to last data)
+    long long   bytes, elapsed_us;
+    // client : sent bytes / datagrams
+    long long   sent_bytes, sent;
+    // udp : received, lost, out of order datagrams, jitter (usec, RFC 3550)
+    long long   packets, lost, reorder;
+    int         jitter_us;
+    // 1 = MSG_ZEROCOPY used
+    int         zerocopy;
+    // 0 = success, errno on error (ECONNREFUSED = no server)
+    int         err;
+};
+
+typedef struct netperf_server__t {
+    // tcp listen, udp data socket
+    int         lfd, ufd, port;
+    // tests served
+    int         served;
+}   netperf_server_t;
+
+//------------------------------------------------------------------------------
+// function prototype
+//------------------------------------------------------------------------------
+extern void             netperf_default     (struct netperf_cfg *cfg, const char *host, int mode);
+extern int              netperf_run         (const struct netperf_cfg *cfg, struct netperf_result *r);
+extern netperf_server_t *netperf_server_init (int port);
+extern int              netperf_server_run  (netperf_server_t *s, int count, volatile int *stop);
+extern void             netperf_server_close (netperf_server_t *s);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#endif  // #define __NETPERF_H__
+//------------------------------------------------------------------------------
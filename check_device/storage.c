@@ -34,6 +34,7 @@
 
 //------------------------------------------------------------------------------
 #include "storage.h"
+#include "blkbench.h"
 
 //------------------------------------------------------------------------------
 #define STR_PATH_LENGTH 128
@@ -84,83 +85,87 @@ struct device_storage DeviceSTORAGE [eSTORAGE_END] = {
     { "/dev/nvme0n1", DEFAULT_NVME_R, DEFAULT_NVME_R,   0 },
 };
 
-// Storage Read / Write (16 Mbytes, 1 block count)
-//#define STORAGE_R_CHECK "dd of=/dev/null bs=16M count=1 iflag=nocache,dsync oflag=nocache,dsync if="
-#define STORAGE_R_CHECK "dd of=/dev/null bs=16M count=1 iflag=direct,dsync oflag=nocache,dsync if="
-#define STORAGE_W_CHECK "dd if=/dev/zero bs=16M count=1 iflag=nocache,dsync oflag=nocache,dsync of="
-
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
-static int remove_tmp (const char *path)
+static int _storage_rw (const char *path, int mode, struct bench_result *r)
 {
-    FILE *fp;
-    char cmd[STR_PATH_LENGTH];
+    struct bench_cfg cfg;
 
-    if (access (path, R_OK) == 0) {
-        memset  (cmd, 0x00, sizeof(cmd));
-        sprintf (cmd, "rm -f %s 2>&1", path);
+    // O_DIRECT, 16 Mbytes (1M block x 16, queue depth 4)
+    blkbench_default (&cfg, path, mode);
 
-        if ((fp = popen (cmd, "r")) != NULL) {
-            pclose(fp);
-            return 1;
-        }
+    return blkbench_run (&cfg, r);
+}
+
+//------------------------------------------------------------------------------
+int storage_check (int id)
+{
+    if ((id >= eSTORAGE_END) || (access (DeviceSTORAGE[id].path, R_OK) != 0)) {
+        return 0;
     }
-    return 0;
+    return 1;
 }
 
 //------------------------------------------------------------------------------
-static int _storage_rw (const char *path, const char *check_cmd)
+// uevent DEVNAME (mmcblk0, sda, nvme0n1) to storage read id (-1 = none)
+//------------------------------------------------------------------------------
+int storage_uevent_id (const char *devname)
 {
-    FILE *fp;
-    char cmd[STR_PATH_LENGTH], rdata[STR_PATH_LENGTH], *ptr;
-
-    memset  (cmd, 0x00, sizeof(cmd));
-    sprintf (cmd, "%s%s 2>&1", check_cmd, path);
-
-    if ((fp = popen (cmd, "r")) != NULL) {
-        while (fgets (rdata, sizeof(rdata), fp) != NULL) {
-            if ((ptr = strstr (rdata, " MB/s")) != NULL) {
-                while (*ptr != ',') ptr--;
-                return atoi (ptr+1);
-            }
-        }
-        pclose(fp);
+    int id;
+
+    for (id = 0; id < eSTORAGE_eMMC_W; id++) {
+        if (!strncmp (DeviceSTORAGE[id].path, "/dev/", 5) &&
+            !strcmp  (&DeviceSTORAGE[id].path[5], devname))
+            return id;
     }
-    return 0;
+    return -1;
 }
 
 //------------------------------------------------------------------------------
-int storage_check (int id)
+// Replace the test target (regular file or loop image) for the given id.
+//------------------------------------------------------------------------------
+int storage_set_path (int id, const char *path)
 {
-    if ((id >= eSTORAGE_END) || (access (DeviceSTORAGE[id].path, R_OK) != 0)) {
+    if ((id >= eSTORAGE_END) || (path == NULL) || (strlen (path) > STR_PATH_LENGTH))
         return 0;
-    }
+
+    memset (DeviceSTORAGE[id].path, 0, sizeof(DeviceSTORAGE[id].path));
+    strncpy (DeviceSTORAGE[id].path, path, STR_PATH_LENGTH);
     return 1;
 }
 
 //------------------------------------------------------------------------------
-int storage_rw (int id)
+int storage_bench (int id, struct bench_result *r)
 {
     int value = 0;
 
+    memset (r, 0, sizeof(struct bench_result));
+
     if (storage_check(id)) {
-        sleep(1);
         switch (id) {
             case eSTORAGE_eMMC_W:   case eSTORAGE_uSD_W:
             case eSTORAGE_NVME_W:   case eSTORAGE_SATA_W:
                 if (id == BOOT_DEVICE) {
-                    value = _storage_rw (TEMP_FILE, STORAGE_W_CHECK);
-                    remove_tmp (TEMP_FILE);
+                    value = _storage_rw (TEMP_FILE, eBENCH_WRITE, r);
+                    unlink (TEMP_FILE);
                 }
                 return value;
             default :
                 break;
 
         }
-        value = _storage_rw (DeviceSTORAGE[id].path, STORAGE_R_CHECK);
+        value = _storage_rw (DeviceSTORAGE[id].path, eBENCH_READ, r);
     }
 
     return (value > DeviceSTORAGE[id].w_min) ? value : 0;
 }
+
+//------------------------------------------------------------------------------
+int storage_rw (int id)
+{
+    struct bench_result r;
+
+    return storage_bench (id, &r);
+}
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
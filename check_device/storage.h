@@ -43,8 +43,13 @@ enum {
 //------------------------------------------------------------------------------
 // function prototype
 //------------------------------------------------------------------------------
+struct bench_result;
+
 extern int storage_check     (int id);
 extern int storage_rw        (int id);
+extern int storage_bench     (int id, struct bench_result *r);
+extern int storage_set_path  (int id, const char *path);
+extern int storage_uevent_id (const char *devname);
 
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
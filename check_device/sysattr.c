@@ -0,0 +1,244 @@
+//------------------------------------------------------------------------------
+/**
+ * @file sysattr.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Device Test library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+//------------------------------------------------------------------------------
+#include "sysattr.h"
+
+//------------------------------------------------------------------------------
+//
+// sysfs attribute handles.
+// Each path is opened once and kept open, a read is one pread(fd, .., 0)
+// (sysfs regenerates the value at offset 0) and a write is one pwrite.
+// When the device goes away (ENODEV, ESTALE...) the handle is reopened once.
+// A missing attribute is not cached, the next call tries to open it again.
+//
+//------------------------------------------------------------------------------
+struct sysattr {
+    // relative to the root (NULL = free slot, fd not valid)
+    char    *path;
+    int     fd, wr;
+    // regular file (test tree) : truncate after write
+    int     reg;
+};
+
+// "" = live system, "/tmp/fake" = test tree
+static char             SysRoot [PATH_MAX] = "";
+
+static struct sysattr   SysAttr [SYSATTR_MAX];
+static struct sysattr_stats Stats;
+
+static pthread_mutex_t  SysAttrLock = PTHREAD_MUTEX_INITIALIZER;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+static void sysattr_close (struct sysattr *a)
+{
+    if (a->fd >= 0)
+        close (a->fd);
+    a->fd = -1;
+}
+
+//------------------------------------------------------------------------------
+static int sysattr_open (struct sysattr *a)
+{
+    char path[PATH_MAX];
+    struct stat st;
+
+    sysattr_path (path, sizeof(path), a->path);
+    if ((a->fd = open (path, (a->wr ? O_WRONLY : O_RDONLY) | O_CLOEXEC)) < 0)
+        return 0;
+
+    a->reg = (fstat (a->fd, &st) == 0) && S_ISREG (st.st_mode);
+    Stats.open++;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// find or open the handle (SysAttrLock held), NULL = attribute missing
+//------------------------------------------------------------------------------
+static struct sysattr *sysattr_get (const char *path, int wr)
+{
+    struct sysattr *a, *empty = NULL;
+    int i;
+
+    for (i = 0; i < SYSATTR_MAX; i++) {
+        a = &SysAttr[i];
+        if (a->path == NULL) {
+            if (empty == NULL)
+                empty = a;
+            continue;
+        }
+        if ((a->wr == wr) && !strcmp (a->path, path)) {
+            if ((a->fd < 0) && !sysattr_open (a))
+                return NULL;
+            return a;
+        }
+    }
+    // table full : use a temporary handle in the last slot
+    if (empty == NULL) {
+        empty = &SysAttr[SYSATTR_MAX -1];
+        sysattr_close (empty);
+        free (empty->path);
+        empty->path = NULL;
+    }
+    if ((empty->path = strdup (path)) == NULL)
+        return NULL;
+
+    empty->wr = wr;
+    if (!sysattr_open (empty)) {
+        free (empty->path);
+        empty->path = NULL;
+        return NULL;
+    }
+    return empty;
+}
+
+//------------------------------------------------------------------------------
+// the device behind the handle was removed/re-added
+//------------------------------------------------------------------------------
+static int sysattr_stale (int err)
+{
+    return (err == ENODEV) || (err == ESTALE) || (err == EBADF) || (err == ENOENT);
+}
+
+//------------------------------------------------------------------------------
+static int sysattr_reopen (struct sysattr *a)
+{
+    sysattr_close (a);
+    Stats.reopen++;
+    return sysattr_open (a);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// return read bytes (buf is NUL terminated), -1 = error
+//------------------------------------------------------------------------------
+int sysattr_read (const char *path, char *buf, int size)
+{
+    struct sysattr *a;
+    int ret = -1;
+
+    if (size <= 0)
+        return -1;
+
+    memset (buf, 0, size);
+    pthread_mutex_lock (&SysAttrLock);
+    Stats.rd++;
+    if ((a = sysattr_get (path, 0)) != NULL) {
+        if (((ret = pread (a->fd, buf, size -1, 0)) < 0) && sysattr_stale (errno)) {
+            if (sysattr_reopen (a))
+                ret = pread (a->fd, buf, size -1, 0);
+        }
+    }
+    pthread_mutex_unlock (&SysAttrLock);
+
+    if (ret < 0)
+        buf[0] = 0;
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+int sysattr_read_int (const char *path, int *value)
+{
+    char buf[32];
+
+    if (sysattr_read (path, buf, sizeof(buf)) <= 0)
+        return 0;
+
+    *value = atoi (buf);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// return 1 = success
+//------------------------------------------------------------------------------
+int sysattr_write (const char *path, const char *data)
+{
+    struct sysattr *a;
+    int ret = -1, len = strlen (data);
+
+    pthread_mutex_lock (&SysAttrLock);
+    Stats.wr++;
+    if ((a = sysattr_get (path, 1)) != NULL) {
+        if (((ret = pwrite (a->fd, data, len, 0)) < 0) && sysattr_stale (errno)) {
+            if (sysattr_reopen (a))
+                ret = pwrite (a->fd, data, len, 0);
+        }
+        if ((ret == len) && a->reg && ftruncate (a->fd, len) < 0)
+            ret = -1;
+    }
+    pthread_mutex_unlock (&SysAttrLock);
+
+    return (ret == len) ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+// Prefix for all paths (test against regular files), NULL or "" = live system.
+// The open handles are closed.
+//------------------------------------------------------------------------------
+void sysattr_set_root (const char *root)
+{
+    sysattr_close_all ();
+
+    pthread_mutex_lock   (&SysAttrLock);
+    snprintf (SysRoot, sizeof(SysRoot), "%s", root ? root : "");
+    pthread_mutex_unlock (&SysAttrLock);
+}
+
+//------------------------------------------------------------------------------
+// root + path, return 0 = truncated
+//------------------------------------------------------------------------------
+int sysattr_path (char *buf, int size, const char *path)
+{
+    return snprintf (buf, size, "%s%s", SysRoot, path) < size;
+}
+
+//------------------------------------------------------------------------------
+void sysattr_close_all (void)
+{
+    int i;
+
+    pthread_mutex_lock (&SysAttrLock);
+    for (i = 0; i < SYSATTR_MAX; i++) {
+        if (SysAttr[i].path == NULL)
+            continue;
+        sysattr_close (&SysAttr[i]);
+        free (SysAttr[i].path);
+        SysAttr[i].path = NULL;
+    }
+    pthread_mutex_unlock (&SysAttrLock);
+}
+
+//------------------------------------------------------------------------------
+void sysattr_get_stats (struct sysattr_stats *st)
+{
+    pthread_mutex_lock   (&SysAttrLock);
+    memcpy (st, &Stats, sizeof(struct sysattr_stats));
+    pthread_mutex_unlock (&SysAttrLock);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
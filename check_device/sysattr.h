@@ -0,0 +1,43 @@
+//------------------------------------------------------------------------------
+/**
+ * @file sysattr.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Device Test library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef __SYSATTR_H__
+#define __SYSATTR_H__
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// cached attribute handles
+#define SYSATTR_MAX     32
+
+struct sysattr_stats {
+    // read/write calls, open (first use + reopen), reopen after ENODEV
+    unsigned int    rd, wr, open, reopen;
+};
+
+//------------------------------------------------------------------------------
+// function prototype
+//------------------------------------------------------------------------------
+extern int          sysattr_read        (const char *path, char *buf, int size);
+extern int          sysattr_read_int    (const char *path, int *value);
+extern int          sysattr_write       (const char *path, const char *data);
+extern void         sysattr_set_root    (const char *root);
+extern int          sysattr_path        (char *buf, int size, const char *path);
+extern void         sysattr_close_all   (void);
+extern void         sysattr_get_stats   (struct sysattr_stats *st);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#endif  // #define __SYSATTR_H__
+//------------------------------------------------------------------------------
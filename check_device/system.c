@@ -23,6 +23,7 @@
 
 //------------------------------------------------------------------------------
 #include "system.h"
+#include "sysattr.h"
 
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
@@ -84,31 +85,24 @@ static int get_memory_size (void)
 //------------------------------------------------------------------------------
 static int get_fb_size (const char *path, int id)
 {
-    FILE *fp;
-    int x, y;
+    char rdata[16], *ptr;
+    int x = 0, y = 0;
 
-    if (access (path, R_OK) == 0) {
-        if ((fp = fopen(path, "r")) != NULL) {
-            char rdata[16], *ptr;
+    if (sysattr_read (path, rdata, sizeof(rdata)) <= 0)
+        return 0;
 
-            memset (rdata, 0x00, sizeof(rdata));
+    // "1920,1080"
+    if ((ptr = strtok (rdata, ",")) != NULL)
+        x = atoi(ptr);
 
-            if (fgets (rdata, sizeof(rdata), fp) != NULL) {
-                if ((ptr = strtok (rdata, ",")) != NULL)
-                    x = atoi(ptr);
+    if ((ptr = strtok (NULL, ",")) != NULL)
+        y = atoi(ptr);
 
-                if ((ptr = strtok (NULL, ",")) != NULL)
-                    y = atoi(ptr);
-            }
-            fclose(fp);
-        }
-        switch (id) {
-            case eSYSTEM_FB_X:  return x;
-            case eSYSTEM_FB_Y:  return y;
-            default :           return 0;
-        }
+    switch (id) {
+        case eSYSTEM_FB_X:  return x;
+        case eSYSTEM_FB_Y:  return y;
+        default :           return 0;
     }
-    return 0;
 }
 
 //------------------------------------------------------------------------------
@@ -118,10 +112,7 @@ int system_check (int id)
         case eSYSTEM_MEM:
             return get_memory_size();
         case eSYSTEM_FB_X:  case eSYSTEM_FB_Y:
-
-            if (access (DeviceSYSTEM.fb_path, R_OK) == 0)
-                return  get_fb_size (DeviceSYSTEM.fb_path, id);
-            return 0;
+            return  get_fb_size (DeviceSYSTEM.fb_path, id);
         default :
             break;
     }
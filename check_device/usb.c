@@ -20,9 +20,13 @@
 #include <limits.h>
 #include <unistd.h>
 #include <errno.h>
+#include <dirent.h>
+#include <pthread.h>
 
 //------------------------------------------------------------------------------
 #include "usb.h"
+#include "blkbench.h"
+#include "sysattr.h"
 
 //------------------------------------------------------------------------------
 #define STR_PATH_LENGTH 128
@@ -66,73 +70,137 @@ struct device_usb DeviceUSB [eUSB_END] = {
     // eUSB_C, USB 3.0
 };
 
-// USB Read / Write (16 Mbytes, 1 block count)
-//#define USB_R_CHECK "dd of=/dev/null bs=16M count=1 iflag=nocache,dsync oflag=nocache,dsync if=/dev/"
-#define USB_R_CHECK "dd of=/dev/null bs=16M count=1 iflag=direct,dsync oflag=nocache,dsync if=/dev/"
-#define USB_W_CHECK "dd if=/dev/zero bs=16M count=1 iflag=nocache,dsync oflag=nocache,dsync of=/dev/"
+//------------------------------------------------------------------------------
+// Block device index (usb port -> /dev/sdX)
+//------------------------------------------------------------------------------
+// block device node per usb id, "" = no disk on the port
+static char UsbBlock [eUSB_END][PATH_MAX];
+static int  UsbIndexValid = 0;
+
+static pthread_mutex_t UsbIndexLock = PTHREAD_MUTEX_INITIALIZER;
 
 //------------------------------------------------------------------------------
+// Walk /sys/block/*/device and match the links against the port directories.
+// Paths are under the sysattr root (fake tree test). (UsbIndexLock held)
 //------------------------------------------------------------------------------
-static int usb_speed (const char *path)
+static int usb_index_build (void)
 {
-    FILE *fp;
-    char cmd[STR_PATH_LENGTH], rdata[STR_PATH_LENGTH];
-
-    if (access (path, R_OK) == 0) {
-        memset  (cmd, 0x00, sizeof(cmd));
-        sprintf (cmd, "%s/speed", path);
-        if ((fp = fopen (cmd, "r")) != NULL) {
-            memset (rdata, 0, sizeof(rdata));
-            fgets  (rdata, sizeof(rdata), fp);
-            fclose (fp);
+    char path[PATH_MAX], port[eUSB_END][PATH_MAX], link[PATH_MAX], name[NAME_MAX + 32];
+    struct dirent *de;
+    DIR *dir;
+    int id, len, cnt = 0;
+
+    memset (UsbBlock, 0, sizeof(UsbBlock));
+    UsbIndexValid = 1;
+
+    // resolve the port directories once (/sys/bus/usb/devices/8-1 -> /sys/devices/...)
+    for (id = 0; id < eUSB_END; id++) {
+        sysattr_path (path, sizeof(path), DeviceUSB[id].path);
+        if (!DeviceUSB[id].path[0] || (realpath (path, port[id]) == NULL))
+            port[id][0] = 0;
+    }
+
+    sysattr_path (path, sizeof(path), "/sys/block");
+    if ((dir = opendir (path)) == NULL)
+        return 0;
+
+    while ((de = readdir (dir)) != NULL) {
+        if (de->d_name[0] == '.')
+            continue;
+
+        snprintf (name, sizeof(name), "/sys/block/%s/device", de->d_name);
+        sysattr_path (path, sizeof(path), name);
+        if (realpath (path, link) == NULL)
+            continue;
+
+        for (id = 0; id < eUSB_END; id++) {
+            if (!port[id][0])
+                continue;
+            len = strlen (port[id]);
+            if (!strncmp (link, port[id], len) && (link[len] == '/')) {
+                snprintf (name, sizeof(name), "/dev/%s", de->d_name);
+                sysattr_path (UsbBlock[id], sizeof(UsbBlock[id]), name);
+                cnt++;
+            }
         }
-        return atoi (rdata);
     }
-    return 0;
+    closedir (dir);
+    return cnt;
 }
 
 //------------------------------------------------------------------------------
-static int _usb_rw (const char *path, const char *check_cmd)
+// Return the block device node of the port (0 = no disk).
+// The index is built on the first lookup and then only by usb_index_refresh
+// (hotplug event), an empty port does not walk /sys/block again.
+// A disk removed since the last refresh is reported as no disk.
+//------------------------------------------------------------------------------
+static int usb_index_lookup (int id, char *node, int size)
 {
-    FILE *fp;
-    char cmd[STR_PATH_LENGTH], rdata[STR_PATH_LENGTH], *ptr;
-
-    memset  (cmd, 0x00, sizeof(cmd));
-    sprintf (cmd, "find %s/ -name sd* 2>&1", path);
-
-    if ((fp = popen (cmd, "r")) != NULL) {
-        memset (rdata, 0x00, sizeof(cmd));
-        // 1 line read
-        fgets (rdata, sizeof(rdata), fp);
-        fclose (fp);
-        // find string "sd"
-        if ((ptr = strstr (rdata, "sd")) != NULL) {
-            memset  (cmd, 0, sizeof (cmd));
-            // 0x00 -> 0x20 (space)
-            ptr[strlen(ptr)-1] = ' ';
-            sprintf (cmd, "%s%s 2>&1", check_cmd, ptr);
-
-            if ((fp = popen(cmd, "r")) != NULL) {
-                while (1) {
-                    memset (rdata, 0, sizeof (rdata));
-                    if ((fgets (rdata, sizeof (rdata), fp)) == NULL)
-                        break;
-                    if ((ptr = strstr (rdata, " MB/s")) != NULL) {
-                        while (*ptr != ',') ptr--;
-                        return atoi (ptr+1);
-                    }
-                }
-                pclose (fp);
-            }
-        }
-    }
-    return 0;
+    char path[PATH_MAX], block[NAME_MAX + 32];
+    const char *name;
+
+    pthread_mutex_lock (&UsbIndexLock);
+    if (!UsbIndexValid)
+        usb_index_build ();
+
+    snprintf (node, size, "%s", UsbBlock[id]);
+    pthread_mutex_unlock (&UsbIndexLock);
+
+    if ((name = strrchr (node, '/')) == NULL)
+        return 0;
+
+    snprintf (block, sizeof(block), "/sys/block%s", name);
+    sysattr_path (path, sizeof(path), block);
+    return (access (path, F_OK) == 0) ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+// Rebuild the index (hotplug add/remove), return the number of mapped ports.
+//------------------------------------------------------------------------------
+int usb_index_refresh (void)
+{
+    int cnt;
+
+    pthread_mutex_lock   (&UsbIndexLock);
+    cnt = usb_index_build ();
+    pthread_mutex_unlock (&UsbIndexLock);
+
+    return cnt;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+static int usb_speed (const char *port)
+{
+    char path[STR_PATH_LENGTH + 8];
+    int speed = 0;
+
+    // port removed : read error
+    snprintf (path, sizeof(path), "%s/speed", port);
+    if (!sysattr_read_int (path, &speed))
+        return 0;
+
+    return speed;
+}
+
+//------------------------------------------------------------------------------
+static int _usb_rw (int id, int mode, struct bench_result *r)
+{
+    char node[PATH_MAX];
+    struct bench_cfg cfg;
+
+    if (!usb_index_lookup (id, node, sizeof(node)))
+        return 0;
+
+    // O_DIRECT, 16 Mbytes (1M block x 16, queue depth 4)
+    blkbench_default (&cfg, node, mode);
+    return blkbench_run (&cfg, r);
 }
 
 //------------------------------------------------------------------------------
 int usb_check (int id)
 {
-    if ((id >= eUSB_END) || ((access (DeviceUSB[id].path, R_OK)) != 0))
+    if ((id >= eUSB_END) || !DeviceUSB[id].path[0])
         return 0;
 
     if (usb_speed (DeviceUSB[id].path) != DeviceUSB[id].speed)
@@ -142,24 +210,54 @@ int usb_check (int id)
 }
 
 //------------------------------------------------------------------------------
-int usb_rw (int id)
+// uevent DEVPATH (/devices/.../usb8/8-1/8-1:1.0/...) to usb read id (-1 = none)
+//------------------------------------------------------------------------------
+int usb_uevent_id (const char *devpath)
+{
+    char port[STR_PATH_LENGTH];
+    const char *name;
+    int id;
+
+    for (id = 0; id < eUSB30_UP_W; id++) {
+        if ((name = strrchr (DeviceUSB[id].path, '/')) == NULL)
+            continue;
+
+        memset  (port, 0, sizeof(port));
+        sprintf (port, "%s/", name);
+        if (strstr (devpath, port) != NULL)
+            return id;
+    }
+    return -1;
+}
+
+//------------------------------------------------------------------------------
+int usb_bench (int id, struct bench_result *r)
 {
     int value = 0;
 
+    memset (r, 0, sizeof(struct bench_result));
+
     if (usb_check(id)) {
-        sleep(1);
         switch (id) {
             case eUSB30_UP_W:   case eUSB30_DN_W:
             case eUSB20_UP_W:   case eUSB20_DN_W:
-                value = _usb_rw (DeviceUSB[id].path, USB_W_CHECK);
+                value = _usb_rw (id, eBENCH_WRITE, r);
                 return (value > DeviceUSB[id].w_min) ? value : 0;
             default :
-                value = _usb_rw (DeviceUSB[id].path, USB_R_CHECK);
+                value = _usb_rw (id, eBENCH_READ, r);
                 return (value > DeviceUSB[id].r_min) ? value : 0;
         }
     }
     return 0;
 }
 
+//------------------------------------------------------------------------------
+int usb_rw (int id)
+{
+    struct bench_result r;
+
+    return usb_bench (id, &r);
+}
+
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
@@ -42,8 +42,13 @@ enum {
 //------------------------------------------------------------------------------
 // function prototype
 //------------------------------------------------------------------------------
-extern int usb_check    (int id);
-extern int usb_rw       (int id);
+struct bench_result;
+
+extern int usb_check         (int id);
+extern int usb_rw            (int id);
+extern int usb_bench         (int id, struct bench_result *r);
+extern int usb_uevent_id     (const char *devpath);
+extern int usb_index_refresh (void);
 
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
@@ -0,0 +1,206 @@
+//------------------------------------------------------------------------------
+/**
+ * @file evq.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <time.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+
+//------------------------------------------------------------------------------
+#include "evq.h"
+
+//------------------------------------------------------------------------------
+// handler thread stop check period
+#define EVQ_POLL_MS     100
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+static long long time_us (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+//------------------------------------------------------------------------------
+// consumer wake up, once per drain
+//------------------------------------------------------------------------------
+static void evq_wake (struct evq_consumer *c)
+{
+    uint64_t v = 1;
+
+    if (!atomic_exchange (&c->wake_pending, 1))
+        if (write (c->efd, &v, sizeof(v)) != sizeof(v))
+            printf ("%s : eventfd write error\n", __func__);
+}
+
+//------------------------------------------------------------------------------
+// wait for a wake up, then re-arm it before the queue is drained
+//------------------------------------------------------------------------------
+static int evq_sleep (struct evq_consumer *c, int timeout_ms)
+{
+    struct pollfd pfd = { c->efd, POLLIN, 0 };
+    uint64_t v;
+
+    if ((poll (&pfd, 1, timeout_ms) > 0) && (read (c->efd, &v, sizeof(v)) > 0)) {
+        atomic_store (&c->wake_pending, 0);
+        return 1;
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+static void *evq_thread (void *arg)
+{
+    struct evq_consumer *c = (struct evq_consumer *)arg;
+    struct evq_msg m;
+
+    while (!atomic_load (&c->owner->stop)) {
+        evq_sleep (c, EVQ_POLL_MS);
+        while (msgq_get (c->q, &m)) {
+            c->handler (&m, c->arg);
+            atomic_fetch_add (&c->handled, 1);
+        }
+    }
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+evq_t *evq_init (void)
+{
+    return (evq_t *)calloc (1, sizeof(evq_t));
+}
+
+//------------------------------------------------------------------------------
+// Add a consumer (before evq_start). mask : EVQ_EVENT() bits,
+// depth : queued events (power of 2), handler : NULL = polled (evq_get).
+// return the consumer id, -1 = error
+//------------------------------------------------------------------------------
+int evq_add (evq_t *e, unsigned int mask, unsigned int depth,
+             evq_handler_t handler, void *arg)
+{
+    struct evq_consumer *c;
+
+    if (e->running || (e->cnt >= EVQ_CONSUMER_MAX))
+        return -1;
+
+    c = &e->c[e->cnt];
+    memset (c, 0, sizeof(struct evq_consumer));
+    if ((c->q = msgq_init (depth, sizeof(struct evq_msg))) == NULL)
+        return -1;
+    if ((c->efd = eventfd (0, EFD_NONBLOCK | EFD_CLOEXEC)) < 0) {
+        msgq_close (c->q);
+        return -1;
+    }
+    c->owner   = e;
+    c->mask    = mask;
+    c->handler = handler;
+    c->arg     = arg;
+
+    return e->cnt++;
+}
+
+//------------------------------------------------------------------------------
+int evq_start (evq_t *e)
+{
+    int i;
+
+    atomic_store (&e->stop, 0);
+    for (i = 0; i < e->cnt; i++) {
+        if (e->c[i].handler == NULL)
+            continue;
+        if (pthread_create (&e->c[i].thread, NULL, evq_thread, &e->c[i])) {
+            printf ("%s : consumer %d thread error\n", __func__, i);
+            return 0;
+        }
+    }
+    e->running = 1;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// any thread. return the consumers that queued the event
+// (a full consumer queue drops it and counts the drop)
+//------------------------------------------------------------------------------
+int evq_post (evq_t *e, int event, int data)
+{
+    struct evq_msg m;
+    int i, cnt = 0;
+
+    if ((event < 0) || (event >= EVQ_EVENT_MAX))
+        return 0;
+
+    m.event = event;    m.data = data;  m.ts_us = time_us ();
+    for (i = 0; i < e->cnt; i++) {
+        struct evq_consumer *c = &e->c[i];
+
+        if (!(c->mask & EVQ_EVENT(event)))
+            continue;
+        if (!msgq_put (c->q, &m)) {
+            atomic_fetch_add (&c->dropped, 1);
+            continue;
+        }
+        evq_wake (c);
+        cnt++;
+    }
+    return cnt;
+}
+
+//------------------------------------------------------------------------------
+// polled consumer (single thread). return 1 = event, 0 = timeout
+//------------------------------------------------------------------------------
+int evq_get (evq_t *e, int id, struct evq_msg *m, int timeout_ms)
+{
+    struct evq_consumer *c;
+
+    if ((id < 0) || (id >= e->cnt))
+        return 0;
+
+    c = &e->c[id];
+    if (!msgq_get (c->q, m)) {
+        evq_sleep (c, timeout_ms);
+        if (!msgq_get (c->q, m))
+            return 0;
+    }
+    atomic_fetch_add (&c->handled, 1);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+void evq_close (evq_t *e)
+{
+    int i;
+
+    if (e == NULL)
+        return;
+
+    atomic_store (&e->stop, 1);
+    for (i = 0; i < e->cnt; i++) {
+        if (e->running && e->c[i].handler)
+            pthread_join (e->c[i].thread, NULL);
+        close (e->c[i].efd);
+        msgq_close (e->c[i].q);
+    }
+    free (e);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,75 @@
+//------------------------------------------------------------------------------
+/**
+ * @file evq.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef __EVQ_H__
+#define __EVQ_H__
+
+//------------------------------------------------------------------------------
+#include <pthread.h>
+#include <stdatomic.h>
+#include "msgq.h"
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#define EVQ_CONSUMER_MAX    8
+// events 0 ~ 31 (consumer mask bits)
+#define EVQ_EVENT_MAX       32
+#define EVQ_EVENT(e)        (1u << (e))
+
+struct evq_msg {
+    int         event, data;
+    // post time (CLOCK_MONOTONIC usec)
+    long long   ts_us;
+};
+
+typedef void (*evq_handler_t) (const struct evq_msg *m, void *arg);
+
+// one consumer : own queue, own thread (handler) or polled (evq_get)
+struct evq_consumer {
+    struct evq__t   *owner;
+    unsigned int    mask;
+    evq_handler_t   handler;
+    void            *arg;
+    msgq_t          *q;
+    int             efd;
+    atomic_int      wake_pending;
+    pthread_t       thread;
+    // handled, dropped (queue full)
+    atomic_uint     handled, dropped;
+};
+
+// Timestamped event fan-out, any thread posts (lock-free), every consumer
+// whose mask has the event gets a copy in order.
+typedef struct evq__t {
+    int                 cnt, running;
+    atomic_int          stop;
+    struct evq_consumer c [EVQ_CONSUMER_MAX];
+}   evq_t;
+
+//------------------------------------------------------------------------------
+// function prototype
+//------------------------------------------------------------------------------
+extern evq_t    *evq_init   (void);
+extern int      evq_add     (evq_t *e, unsigned int mask, unsigned int depth,
+                             evq_handler_t handler, void *arg);
+extern int      evq_start   (evq_t *e);
+extern int      evq_post    (evq_t *e, int event, int data);
+extern int      evq_get     (evq_t *e, int id, struct evq_msg *m, int timeout_ms);
+extern void     evq_close   (evq_t *e);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#endif  // #define __EVQ_H__
+//------------------------------------------------------------------------------
@@ -0,0 +1,90 @@
+//------------------------------------------------------------------------------
+/**
+ * @file fbmem.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//------------------------------------------------------------------------------
+#include "fbmem.h"
+
+//------------------------------------------------------------------------------
+//
+// Headless framebuffer. Same fb_info_t layout as /dev/fb0 (fd = -1, no mmap),
+// the ui/draw functions render into plain memory.
+// Used as the ui back buffer and for tests without a display.
+//
+//------------------------------------------------------------------------------
+fb_info_t *fb_mem_init (int w, int h, int bpp)
+{
+    fb_info_t *fb;
+
+    if ((w <= 0) || (h <= 0) || ((bpp != 16) && (bpp != 24) && (bpp != 32)))
+        return NULL;
+
+    if ((fb = (fb_info_t *)calloc (1, sizeof(fb_info_t))) == NULL)
+        return NULL;
+
+    fb->fd     = -1;
+    fb->w      = w;
+    fb->h      = h;
+    fb->bpp    = bpp;
+    fb->stride = w * (bpp / 8);
+    fb->size   = fb->stride * h;
+
+    if ((fb->base = (char *)calloc (1, fb->size)) == NULL) {
+        free (fb);
+        return NULL;
+    }
+    fb->data = fb->base;
+    return fb;
+}
+
+//------------------------------------------------------------------------------
+// memory buffer with the geometry and pixel format of fb (contents not copied)
+//------------------------------------------------------------------------------
+fb_info_t *fb_mem_clone (const fb_info_t *fb)
+{
+    fb_info_t *mem;
+
+    if ((mem = fb_mem_init (fb->w, fb->h, fb->bpp)) == NULL)
+        return NULL;
+
+    // keep the stride of the device (line padding)
+    if (fb->stride > mem->stride) {
+        free (mem->base);
+        mem->stride = fb->stride;
+        mem->size   = fb->stride * fb->h;
+        if ((mem->base = (char *)calloc (1, mem->size)) == NULL) {
+            free (mem);
+            return NULL;
+        }
+        mem->data = mem->base;
+    }
+    mem->is_bgr = fb->is_bgr;
+    return mem;
+}
+
+//------------------------------------------------------------------------------
+void fb_mem_close (fb_info_t *fb)
+{
+    if (fb) {
+        free (fb->base);
+        free (fb);
+    }
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,32 @@
+//------------------------------------------------------------------------------
+/**
+ * @file fbmem.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef __FBMEM_H__
+#define __FBMEM_H__
+
+//------------------------------------------------------------------------------
+#include "../lib_fbui/lib_fb.h"
+
+//------------------------------------------------------------------------------
+// function prototype
+//------------------------------------------------------------------------------
+extern fb_info_t *fb_mem_init  (int w, int h, int bpp);
+extern fb_info_t *fb_mem_clone (const fb_info_t *fb);
+extern void       fb_mem_close (fb_info_t *fb);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#endif  // #define __FBMEM_H__
+//------------------------------------------------------------------------------
@@ -0,0 +1,382 @@
+//------------------------------------------------------------------------------
+/**
+ * @file glyph.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <pthread.h>
+
+//------------------------------------------------------------------------------
+#include "glyph.h"
+#include "fbmem.h"
+
+//------------------------------------------------------------------------------
+//
+// Glyph cache for draw_text.
+// Each character (ASCII or UTF-8 Hangul) is rasterized once by draw_text into
+// a scratch memory fb and kept as a pixel block in the native fb format.
+// Strings are then drawn as memcpy runs, one per glyph row.
+// Opaque text (bc drawn) keeps the whole cell, transparent text
+// (bc = GLYPH_COLOR_NONE) keeps a pixel mask and copies the glyph pixels only.
+//
+//------------------------------------------------------------------------------
+struct glyph {
+    // unicode code point (0 = empty slot)
+    unsigned int    code;
+    // cell size (pixels), native pixels (w * h * bytes per pixel)
+    int             w, h;
+    char            *pix;
+    // transparent set : 1 = glyph pixel (w * h), NULL = opaque cell
+    unsigned char   *mask;
+};
+
+struct glyph_set {
+    int             font, scale, bpp, is_bgr;
+    unsigned int    fc, bc;
+    // LRU stamp (0 = unused set)
+    unsigned int    used;
+    struct glyph    g [GLYPH_CACHE_MAX];
+};
+
+static struct glyph_set     GlyphSet [GLYPH_SET_MAX];
+static struct glyph_stats   Stats;
+// full set table : the character is drawn from here, not cached
+static struct glyph         Spill;
+static unsigned int         UseStamp = 0;
+
+// scratch fb (rasterize), reallocated when the scale or pixel format changes
+static fb_info_t            *Scratch = NULL;
+
+static pthread_mutex_t      GlyphLock = PTHREAD_MUTEX_INITIALIZER;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// UTF-8 sequence to code point, return the byte count (0 = end of string)
+//------------------------------------------------------------------------------
+static int utf8_decode (const char *s, unsigned int *code)
+{
+    const unsigned char *p = (const unsigned char *)s;
+    int len, i;
+
+    if (!p[0])
+        return 0;
+
+    if      (p[0] < 0x80)           { *code = p[0];         len = 1; }
+    else if ((p[0] & 0xE0) == 0xC0) { *code = p[0] & 0x1F;  len = 2; }
+    else if ((p[0] & 0xF0) == 0xE0) { *code = p[0] & 0x0F;  len = 3; }
+    else if ((p[0] & 0xF8) == 0xF0) { *code = p[0] & 0x07;  len = 4; }
+    else                            { *code = p[0];         return 1; }
+
+    for (i = 1; i < len; i++) {
+        // broken sequence, take the lead byte alone
+        if ((p[i] & 0xC0) != 0x80) {
+            *code = p[0];
+            return 1;
+        }
+        *code = (*code << 6) | (p[i] & 0x3F);
+    }
+    return len;
+}
+
+//------------------------------------------------------------------------------
+static void glyph_set_free (struct glyph_set *set)
+{
+    int i;
+
+    for (i = 0; i < GLYPH_CACHE_MAX; i++) {
+        free (set->g[i].pix);
+        free (set->g[i].mask);
+    }
+    memset (set, 0, sizeof(struct glyph_set));
+}
+
+//------------------------------------------------------------------------------
+static struct glyph_set *glyph_set_find (fb_info_t *fb, int font,
+                                         unsigned int fc, unsigned int bc, int scale)
+{
+    struct glyph_set *set, *lru = &GlyphSet[0];
+    int i;
+
+    for (i = 0; i < GLYPH_SET_MAX; i++) {
+        set = &GlyphSet[i];
+        if (set->used && (set->font == font) && (set->scale == scale) &&
+            (set->fc == fc) && (set->bc == bc) &&
+            (set->bpp == fb->bpp) && (set->is_bgr == fb->is_bgr)) {
+            set->used = ++UseStamp;
+            return set;
+        }
+        if (set->used < lru->used)
+            lru = set;
+    }
+    if (lru->used)
+        Stats.evict++;
+    glyph_set_free (lru);
+
+    lru->font   = font;     lru->scale  = scale;
+    lru->fc     = fc;       lru->bc     = bc;
+    lru->bpp    = fb->bpp;  lru->is_bgr = fb->is_bgr;
+    lru->used   = ++UseStamp;
+    return lru;
+}
+
+//------------------------------------------------------------------------------
+static int glyph_scratch (fb_info_t *fb, int scale)
+{
+    int size = GLYPH_CELL_MAX * scale;
+
+    if (Scratch && (Scratch->w == size) && (Scratch->bpp == fb->bpp) &&
+        (Scratch->is_bgr == fb->is_bgr))
+        return 1;
+
+    fb_mem_close (Scratch);
+    if ((Scratch = fb_mem_init (size, size, fb->bpp)) == NULL)
+        return 0;
+    Scratch->is_bgr = fb->is_bgr;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+static void glyph_pass (const struct glyph_set *set, char *str, char fill, unsigned int bc)
+{
+    memset (Scratch->data, fill, Scratch->size);
+    draw_text (Scratch, 0, 0, set->fc, bc, set->scale, "%s", str);
+}
+
+//------------------------------------------------------------------------------
+// grow w, h to every pixel that differs from the fill
+//------------------------------------------------------------------------------
+static void glyph_extent (char fill, int bpp, int *w, int *h)
+{
+    char *row;
+    int x, y;
+
+    for (y = 0; y < Scratch->h; y++) {
+        row = Scratch->data + y * Scratch->stride;
+        for (x = 0; x < Scratch->w * bpp; x++) {
+            if (row[x] != fill) {
+                if (y + 1 > *h)         *h = y + 1;
+                if (x / bpp + 1 > *w)   *w = x / bpp + 1;
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// The cell is measured with the background drawn on two fills (0x00, 0xFF),
+// every pixel that changed on either fill. A transparent set draws twice more
+// without the background, a pixel that is the same on both fills is the glyph.
+//------------------------------------------------------------------------------
+static int glyph_raster (struct glyph_set *set, const char *ch, int len, struct glyph *g)
+{
+    char str[8], *row, *pix;
+    int x, y, bpp = set->bpp / 8, w = 0, h = 0;
+    const char fill[2] = { 0x00, (char)0xFF };
+    int opaque = (set->bc != GLYPH_COLOR_NONE);
+
+    memset (str, 0, sizeof(str));
+    memcpy (str, ch, len);
+
+    // lib_fb draws with the current font
+    set_font (set->font);
+
+    glyph_pass (set, str, fill[0], opaque ? set->bc : 0);
+    glyph_extent (fill[0], bpp, &w, &h);
+    glyph_pass (set, str, fill[1], opaque ? set->bc : 0);
+    glyph_extent (fill[1], bpp, &w, &h);
+
+    if (!w || !h || ((g->pix = (char *)malloc (w * h * bpp)) == NULL))
+        return 0;
+
+    if (!opaque) {
+        if ((g->mask = (unsigned char *)malloc (w * h)) == NULL) {
+            free (g->pix);  g->pix = NULL;
+            return 0;
+        }
+        glyph_pass (set, str, fill[0], GLYPH_COLOR_NONE);
+    }
+    // the last pass is still in the scratch fb
+    for (y = 0; y < h; y++)
+        memcpy (g->pix + y * w * bpp, Scratch->data + y * Scratch->stride, w * bpp);
+
+    if (!opaque) {
+        glyph_pass (set, str, fill[1], GLYPH_COLOR_NONE);
+        for (y = 0; y < h; y++) {
+            row = Scratch->data + y * Scratch->stride;
+            pix = g->pix + y * w * bpp;
+            for (x = 0; x < w; x++)
+                g->mask[y * w + x] = !memcmp (row + x * bpp, pix + x * bpp, bpp);
+        }
+    }
+    g->w = w;   g->h = h;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+static struct glyph *glyph_find (struct glyph_set *set, const char *ch, int len,
+                                 unsigned int code)
+{
+    struct glyph *g;
+    int i, slot = code & (GLYPH_CACHE_MAX - 1);
+
+    Stats.lookup++;
+    for (i = 0; i < GLYPH_CACHE_MAX; i++) {
+        g = &set->g[(slot + i) & (GLYPH_CACHE_MAX - 1)];
+        if (g->code == code)
+            return g;
+        if (!g->code)
+            break;
+    }
+    Stats.miss++;
+    // table full, rasterize into the spill glyph (drawn, not cached)
+    if (i == GLYPH_CACHE_MAX) {
+        Stats.spill++;
+        g = &Spill;
+        free (g->pix);
+        free (g->mask);
+        memset (g, 0, sizeof(struct glyph));
+        return glyph_raster (set, ch, len, g) ? g : NULL;
+    }
+    if (!glyph_raster (set, ch, len, g))
+        return NULL;
+    g->code = code;
+    return g;
+}
+
+//------------------------------------------------------------------------------
+static void glyph_blit (fb_info_t *fb, int x, int y, const struct glyph *g)
+{
+    int bpp = fb->bpp / 8, r, c, run, w = g->w, h = g->h;
+    const unsigned char *m;
+    char *dst, *src;
+
+    if ((x >= fb->w) || (y >= fb->h))
+        return;
+    if (x + w > fb->w)  w = fb->w - x;
+    if (y + h > fb->h)  h = fb->h - y;
+
+    for (r = 0; r < h; r++) {
+        dst = fb->data + (y + r) * fb->stride + x * bpp;
+        src = g->pix + r * g->w * bpp;
+        if (g->mask == NULL) {
+            memcpy (dst, src, w * bpp);
+            continue;
+        }
+        // transparent, one memcpy per run of glyph pixels
+        m = g->mask + r * g->w;
+        for (c = 0; c < w; c += run) {
+            for (run = 0; (c + run < w) && (m[c + run] == m[c]); run++)
+                ;
+            if (m[c])
+                memcpy (dst + c * bpp, src + c * bpp, run * bpp);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// Same arguments as draw_text, plus the font (m1.cfg 'C' fn) to draw with.
+// bc = GLYPH_COLOR_NONE : no background. return the drawn width (pixels)
+//------------------------------------------------------------------------------
+int glyph_draw_text (fb_info_t *fb, int font, int x, int y,
+                     unsigned int fc, unsigned int bc, int scale, const char *fmt, ...)
+{
+    struct glyph_set *set;
+    struct glyph *g;
+    unsigned int code;
+    char str[256], *p;
+    va_list va;
+    int len, sx = x;
+
+    memset (str, 0, sizeof(str));
+    va_start  (va, fmt);
+    vsnprintf (str, sizeof(str), fmt, va);
+    va_end    (va);
+
+    if ((x < 0) || (y < 0) || (scale <= 0))
+        return 0;
+
+    pthread_mutex_lock (&GlyphLock);
+    if (!glyph_scratch (fb, scale)) {
+        pthread_mutex_unlock (&GlyphLock);
+        draw_text (fb, x, y, fc, bc, scale, "%s", str);
+        return 0;
+    }
+    set = glyph_set_find (fb, font, fc, bc, scale);
+
+    for (p = str; (len = utf8_decode (p, &code)) != 0; p += len) {
+        if ((g = glyph_find (set, p, len, code)) != NULL) {
+            glyph_blit (fb, x, y, g);
+            x += g->w;
+        }
+    }
+    pthread_mutex_unlock (&GlyphLock);
+    return x - sx;
+}
+
+//------------------------------------------------------------------------------
+// width of the string drawn by glyph_draw_text (pixels), the glyphs are cached
+//------------------------------------------------------------------------------
+int glyph_text_width (fb_info_t *fb, int font, unsigned int fc, unsigned int bc,
+                      int scale, const char *str)
+{
+    struct glyph_set *set;
+    struct glyph *g;
+    unsigned int code;
+    const char *p;
+    int len, w = 0;
+
+    if (scale <= 0)
+        return 0;
+
+    pthread_mutex_lock (&GlyphLock);
+    if (glyph_scratch (fb, scale)) {
+        set = glyph_set_find (fb, font, fc, bc, scale);
+        for (p = str; (len = utf8_decode (p, &code)) != 0; p += len)
+            if ((g = glyph_find (set, p, len, code)) != NULL)
+                w += g->w;
+    }
+    pthread_mutex_unlock (&GlyphLock);
+    return w;
+}
+
+//------------------------------------------------------------------------------
+void glyph_get_stats (struct glyph_stats *st)
+{
+    pthread_mutex_lock   (&GlyphLock);
+    memcpy (st, &Stats, sizeof(struct glyph_stats));
+    pthread_mutex_unlock (&GlyphLock);
+}
+
+//------------------------------------------------------------------------------
+// drop all cached glyphs (font change)
+//------------------------------------------------------------------------------
+void glyph_flush (void)
+{
+    int i;
+
+    pthread_mutex_lock   (&GlyphLock);
+    for (i = 0; i < GLYPH_SET_MAX; i++)
+        glyph_set_free (&GlyphSet[i]);
+    free (Spill.pix);
+    free (Spill.mask);
+    memset (&Spill, 0, sizeof(struct glyph));
+    fb_mem_close (Scratch);
+    Scratch = NULL;
+    pthread_mutex_unlock (&GlyphLock);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,53 @@
+//------------------------------------------------------------------------------
+/**
+ * @file glyph.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef __GLYPH_H__
+#define __GLYPH_H__
+
+//------------------------------------------------------------------------------
+#include "../lib_fbui/lib_fb.h"
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// cached (font, scale, fc, bc, pixel format) sets, glyphs per set (power of 2)
+#define GLYPH_SET_MAX       8
+#define GLYPH_CACHE_MAX     256
+
+// max glyph cell (pixels, scale 1)
+#define GLYPH_CELL_MAX      32
+
+// bc : no background, the fb shows through (lib_fb draw_text bc -1)
+#define GLYPH_COLOR_NONE    0xFFFFFFFFu
+
+struct glyph_stats {
+    // glyph lookups, cache miss (rasterized by draw_text), set evictions,
+    // miss on a full set table (drawn, not cached)
+    unsigned int    lookup, miss, evict, spill;
+};
+
+//------------------------------------------------------------------------------
+// function prototype
+//------------------------------------------------------------------------------
+extern int  glyph_draw_text  (fb_info_t *fb, int font, int x, int y,
+                              unsigned int fc, unsigned int bc, int scale, const char *fmt, ...);
+extern int  glyph_text_width (fb_info_t *fb, int font, unsigned int fc, unsigned int bc,
+                              int scale, const char *str);
+extern void glyph_get_stats  (struct glyph_stats *st);
+extern void glyph_flush      (void);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#endif  // #define __GLYPH_H__
+//------------------------------------------------------------------------------
@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------------
+/**
+ * @file hotplug.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/inotify.h>
+
+//------------------------------------------------------------------------------
+#include "hotplug.h"
+
+//------------------------------------------------------------------------------
+//
+// Device hotplug notify. The storage/usb test threads sleep in hotplug_wait()
+// and wake up as soon as one of their test devices is added or removed.
+// The filter maps a uevent to device bits, a waiter takes only the bits it
+// watches. inotify has no device info and wakes up every waiter.
+// Event source : kernel uevent (netlink) -> /dev inotify -> timed polling.
+//
+//------------------------------------------------------------------------------
+static pthread_mutex_t  HotplugLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   HotplugCond = PTHREAD_COND_INITIALIZER;
+// device bits not taken by a waiter yet
+static unsigned int     HotplugPending = 0;
+
+static int              HotplugMode = eHOTPLUG_POLL;
+static hotplug_filter_t HotplugFilter = NULL;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+static void hotplug_uevent (const struct uevent *ev, void *arg)
+{
+    unsigned int mask;
+
+    (void)arg;
+
+    mask = (HotplugFilter == NULL) ? HOTPLUG_ALL : HotplugFilter (ev);
+    if (mask)
+        hotplug_notify (mask);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// return event fd (register hotplug_event to the reactor), -1 = polling mode
+//------------------------------------------------------------------------------
+int hotplug_init (const char *dev_dir)
+{
+    int fd;
+
+    if ((fd = uevent_open ()) >= 0) {
+        HotplugMode = eHOTPLUG_UEVENT;
+        return fd;
+    }
+
+    if ((fd = inotify_init1 (IN_NONBLOCK | IN_CLOEXEC)) >= 0) {
+        if (inotify_add_watch (fd, dev_dir, IN_CREATE | IN_DELETE) >= 0) {
+            HotplugMode = eHOTPLUG_INOTIFY;
+            return fd;
+        }
+        printf ("%s : %s watch error!\n", __func__, dev_dir);
+        close (fd);
+    }
+    HotplugMode = eHOTPLUG_POLL;
+    return -1;
+}
+
+//------------------------------------------------------------------------------
+int hotplug_mode (void)
+{
+    return HotplugMode;
+}
+
+//------------------------------------------------------------------------------
+void hotplug_set_filter (hotplug_filter_t filter)
+{
+    HotplugFilter = filter;
+}
+
+//------------------------------------------------------------------------------
+// reactor handler (uevent socket or inotify fd)
+//------------------------------------------------------------------------------
+int hotplug_event (int fd, unsigned int events, void *arg)
+{
+    struct uevent ev;
+    char buf[1024];
+    int notify = 0;
+
+    (void)events;   (void)arg;
+
+    if (HotplugMode == eHOTPLUG_UEVENT) {
+        while (uevent_recv (fd, &ev))
+            hotplug_uevent (&ev, NULL);
+        return 0;
+    }
+
+    // drain the queued inotify events
+    while (read (fd, buf, sizeof(buf)) > 0)
+        notify = 1;
+
+    if (notify)
+        hotplug_notify (HOTPLUG_ALL);
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// feed a recorded uevent stream (uevent_replay format) through the filter
+//------------------------------------------------------------------------------
+int hotplug_replay (const char *fname)
+{
+    return uevent_replay (fname, hotplug_uevent, NULL);
+}
+
+//------------------------------------------------------------------------------
+void hotplug_notify (unsigned int mask)
+{
+    pthread_mutex_lock   (&HotplugLock);
+    HotplugPending |= mask;
+    pthread_cond_broadcast (&HotplugCond);
+    pthread_mutex_unlock (&HotplugLock);
+}
+
+//------------------------------------------------------------------------------
+// wait for an event of the watched device bits (taken, other bits are left
+// to their waiters). A device bit is watched by one waiter.
+// return device bits, 0 = timeout (fallback poll)
+//------------------------------------------------------------------------------
+unsigned int hotplug_wait (unsigned int watch, int timeout_ms)
+{
+    struct timespec ts;
+    unsigned int mask;
+
+    // HotplugCond uses the default clock (CLOCK_REALTIME)
+    clock_gettime (CLOCK_REALTIME, &ts);
+    ts.tv_sec  += timeout_ms / 1000;
+    ts.tv_nsec += (timeout_ms % 1000) * 1000000;
+    if (ts.tv_nsec >= 1000000000) {
+        ts.tv_sec++;    ts.tv_nsec -= 1000000000;
+    }
+
+    pthread_mutex_lock (&HotplugLock);
+    while (!(HotplugPending & watch)) {
+        if (pthread_cond_timedwait (&HotplugCond, &HotplugLock, &ts) == ETIMEDOUT)
+            break;
+    }
+    mask = HotplugPending & watch;
+    HotplugPending &= ~watch;
+    pthread_mutex_unlock (&HotplugLock);
+
+    return mask;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
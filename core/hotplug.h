@@ -0,0 +1,55 @@
+//------------------------------------------------------------------------------
+/**
+ * @file hotplug.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef __HOTPLUG_H__
+#define __HOTPLUG_H__
+
+//------------------------------------------------------------------------------
+#include "uevent.h"
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+enum {
+    // no event source, timed polling only
+    eHOTPLUG_POLL = 0,
+    // kernel uevent (netlink)
+    eHOTPLUG_UEVENT,
+    // device node create/delete (inotify)
+    eHOTPLUG_INOTIFY,
+};
+
+// test device bits (assigned by the filter), all devices (no device info)
+#define HOTPLUG_DEV(n)      (1u << (n))
+#define HOTPLUG_ALL         0xFFFFFFFFu
+
+// uevent filter. return the device bits of the event (wake up only their
+// tests), 0 = not a test device
+typedef unsigned int (*hotplug_filter_t) (const struct uevent *ev);
+
+//------------------------------------------------------------------------------
+// function prototype
+//------------------------------------------------------------------------------
+extern int  hotplug_init        (const char *dev_dir);
+extern int  hotplug_mode        (void);
+extern void hotplug_set_filter  (hotplug_filter_t filter);
+extern int  hotplug_event       (int fd, unsigned int events, void *arg);
+extern int  hotplug_replay      (const char *fname);
+extern void hotplug_notify      (unsigned int mask);
+extern unsigned int hotplug_wait (unsigned int watch, int timeout_ms);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#endif  // #define __HOTPLUG_H__
+//------------------------------------------------------------------------------
@@ -0,0 +1,200 @@
+//------------------------------------------------------------------------------
+/**
+ * @file itemstate.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+
+//------------------------------------------------------------------------------
+#include "itemstate.h"
+
+//------------------------------------------------------------------------------
+#define STATE(status, result)   (((unsigned int)(status) << 8) | ((unsigned int)(result) & 0xFF))
+#define STATE_STATUS(v)         (int)((v) >> 8)
+#define STATE_RESULT(v)         (int)((v) & 0xFF)
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// all items : status / result, done : status of a finished item
+//------------------------------------------------------------------------------
+itemstate_t *itemstate_init (int cnt, int status, int result, int done)
+{
+    itemstate_t *s;
+    int i;
+
+    if ((cnt <= 0) || ((s = (itemstate_t *)calloc (1, sizeof(itemstate_t))) == NULL))
+        return NULL;
+
+    if ((s->state = (atomic_uint *)calloc (cnt, sizeof(atomic_uint))) == NULL) {
+        free (s);
+        return NULL;
+    }
+    if ((s->efd = eventfd (0, EFD_NONBLOCK | EFD_CLOEXEC)) < 0) {
+        free (s->state);    free (s);
+        return NULL;
+    }
+    s->cnt  = cnt;
+    s->done = done;
+    for (i = 0; i < cnt; i++)
+        atomic_init (&s->state[i], STATE(status, result));
+    atomic_init (&s->remaining, (status == done) ? 0 : cnt);
+
+    return s;
+}
+
+//------------------------------------------------------------------------------
+int itemstate_status (itemstate_t *s, int id)
+{
+    return STATE_STATUS(atomic_load_explicit (&s->state[id], memory_order_acquire));
+}
+
+//------------------------------------------------------------------------------
+int itemstate_result (itemstate_t *s, int id)
+{
+    return STATE_RESULT(atomic_load_explicit (&s->state[id], memory_order_acquire));
+}
+
+//------------------------------------------------------------------------------
+// one item less to wait for, the last one signals the eventfd
+//------------------------------------------------------------------------------
+static void remaining_dec (itemstate_t *s)
+{
+    uint64_t v = 1;
+
+    if (atomic_fetch_sub_explicit (&s->remaining, 1, memory_order_acq_rel) == 1) {
+        if (write (s->efd, &v, sizeof(v)) < 0)
+            printf ("%s : eventfd write error\n", __func__);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Transition from the from status only (ITEM_KEEP = any status).
+// status / result : ITEM_KEEP keeps the current value.
+// remaining never drops below the items not done : a restart (done -> not
+// done) counts before its CAS, a finish after it.
+// return 1 = changed, 0 = the item was not in the from status
+//------------------------------------------------------------------------------
+int itemstate_cas (itemstate_t *s, int id, int from, int status, int result)
+{
+    unsigned int old, new;
+    int restart = 0, ret = 0;
+
+    if ((id < 0) || (id >= s->cnt))
+        return 0;
+
+    old = atomic_load_explicit (&s->state[id], memory_order_acquire);
+    while (1) {
+        if ((from != ITEM_KEEP) && (STATE_STATUS(old) != from))
+            break;
+        new = STATE((status == ITEM_KEEP) ? STATE_STATUS(old) : status,
+                    (result == ITEM_KEEP) ? STATE_RESULT(old) : result);
+        if (new == old) {
+            ret = 1;
+            break;
+        }
+        if (!restart && (STATE_STATUS(old) == s->done) && (STATE_STATUS(new) != s->done)) {
+            atomic_fetch_add_explicit (&s->remaining, 1, memory_order_acq_rel);
+            restart = 1;
+        }
+        if (atomic_compare_exchange_weak_explicit (&s->state[id], &old, new,
+                                memory_order_acq_rel, memory_order_acquire)) {
+            if ((STATE_STATUS(old) == s->done) && (STATE_STATUS(new) != s->done))
+                restart = 0;
+            else if ((STATE_STATUS(old) != s->done) && (STATE_STATUS(new) == s->done))
+                remaining_dec (s);
+            if (s->trace && (STATE_STATUS(old) != STATE_STATUS(new)))
+                trace_put (s->trace, id, STATE_STATUS(old), STATE_STATUS(new),
+                           STATE_RESULT(new));
+            ret = 1;
+            break;
+        }
+    }
+    // restart counted but not done
+    if (restart)
+        remaining_dec (s);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+int itemstate_set (itemstate_t *s, int id, int status, int result)
+{
+    return itemstate_cas (s, id, ITEM_KEEP, status, result);
+}
+
+//------------------------------------------------------------------------------
+int itemstate_remaining (itemstate_t *s)
+{
+    return atomic_load_explicit (&s->remaining, memory_order_acquire);
+}
+
+//------------------------------------------------------------------------------
+// Shared countdown (test timeout), another thread may clear it at any time.
+// CAS decrement, never below 0. return 1 = decremented, 0 = already 0
+//------------------------------------------------------------------------------
+int itemstate_countdown (atomic_int *cnt)
+{
+    int v = atomic_load (cnt);
+
+    while (v > 0) {
+        if (atomic_compare_exchange_weak (cnt, &v, v - 1))
+            return 1;
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// return 1 = all items done, 0 = timeout (timeout_ms < 0 : wait forever)
+//------------------------------------------------------------------------------
+int itemstate_wait (itemstate_t *s, int timeout_ms)
+{
+    struct pollfd pfd = { s->efd, POLLIN, 0 };
+    uint64_t v;
+
+    if (!itemstate_remaining (s))
+        return 1;
+
+    if (poll (&pfd, 1, timeout_ms) > 0) {
+        // consume the wake up, an item may have restarted since
+        if (read (s->efd, &v, sizeof(v)) < 0)
+            v = 0;
+    }
+    return itemstate_remaining (s) ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+// attach before the test threads start (NULL = off)
+//------------------------------------------------------------------------------
+void itemstate_trace (itemstate_t *s, trace_t *t)
+{
+    s->trace = t;
+}
+
+//------------------------------------------------------------------------------
+void itemstate_close (itemstate_t *s)
+{
+    if (s == NULL)
+        return;
+    if (s->efd >= 0)
+        close (s->efd);
+    free (s->state);
+    free (s);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,60 @@
+//------------------------------------------------------------------------------
+/**
+ * @file itemstate.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef __ITEMSTATE_H__
+#define __ITEMSTATE_H__
+
+//------------------------------------------------------------------------------
+#include <stdatomic.h>
+
+//------------------------------------------------------------------------------
+#include "trace.h"
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// keep the current status / result (itemstate_set)
+#define ITEM_KEEP   -1
+
+// Test item status / result shared by the test threads.
+// status and result are packed in one word (status << 8 | result), every
+// change is a CAS. remaining counts the items not in the done status, the
+// eventfd is signaled when it drops to 0. Status transitions are recorded
+// in the trace when one is attached.
+typedef struct itemstate__t {
+    int             cnt, done;
+    atomic_uint     *state;
+    atomic_int      remaining;
+    int             efd;
+    trace_t         *trace;
+}   itemstate_t;
+
+//------------------------------------------------------------------------------
+// function prototype
+//------------------------------------------------------------------------------
+extern itemstate_t  *itemstate_init     (int cnt, int status, int result, int done);
+extern int          itemstate_status    (itemstate_t *s, int id);
+extern int          itemstate_result    (itemstate_t *s, int id);
+extern int          itemstate_set       (itemstate_t *s, int id, int status, int result);
+extern int          itemstate_cas       (itemstate_t *s, int id, int from, int status, int result);
+extern int          itemstate_remaining (itemstate_t *s);
+extern int          itemstate_countdown (atomic_int *cnt);
+extern int          itemstate_wait      (itemstate_t *s, int timeout_ms);
+extern void         itemstate_trace     (itemstate_t *s, trace_t *t);
+extern void         itemstate_close     (itemstate_t *s);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#endif  // #define __ITEMSTATE_H__
+//------------------------------------------------------------------------------
@@ -0,0 +1,307 @@
+//------------------------------------------------------------------------------
+/**
+ * @file layout.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <limits.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+//------------------------------------------------------------------------------
+#include "layout.h"
+
+//------------------------------------------------------------------------------
+//
+// The text config (m1.cfg) is compiled at build time (make layout,
+// tools/layout_compile) into header + item array with pixel coordinates for
+// the target resolution. The app mmaps the blob and uses the items in place
+// (no copy), the text config is parsed only when the blob is missing/stale.
+//
+//------------------------------------------------------------------------------
+#define CFG_SIGNATURE   "ODROID-UI-CONFIG"
+#define CFG_FIELD_MAX   12
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+static uint32_t crc32_calc (const void *buf, size_t size)
+{
+    static uint32_t table[256];
+    const unsigned char *p = (const unsigned char *)buf;
+    uint32_t crc, i, j;
+
+    if (!table[1]) {
+        for (i = 0; i < 256; i++) {
+            for (crc = i, j = 0; j < 8; j++)
+                crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+            table[i] = crc;
+        }
+    }
+    for (crc = 0xFFFFFFFF; size--; p++)
+        crc = table[(crc ^ *p) & 0xFF] ^ (crc >> 8);
+
+    return ~crc;
+}
+
+//------------------------------------------------------------------------------
+// split "B, 000, 00, ..., str," into trimmed fields, return the field count
+//------------------------------------------------------------------------------
+static int cfg_split (char *line, char **field)
+{
+    char *p = line, *end;
+    int cnt = 0;
+
+    line[strcspn (line, "\r\n")] = 0;
+    while (p && (cnt < CFG_FIELD_MAX)) {
+        if ((end = strchr (p, ',')) != NULL)
+            *end++ = 0;
+        while (isspace ((unsigned char)*p))
+            p++;
+        field[cnt] = p;
+        p += strlen (p);
+        while ((p > field[cnt]) && isspace ((unsigned char)p[-1]))
+            *--p = 0;
+        cnt++;
+        p = end;
+    }
+    return cnt;
+}
+
+//------------------------------------------------------------------------------
+static int layout_scale (int percent, int size)
+{
+    int v = (percent * size) / 100;
+
+    return (v < 0) ? 0 : ((v > size) ? size : v);
+}
+
+//------------------------------------------------------------------------------
+static int layout_stamp (const char *cfg_file, int64_t *mtime, int64_t *size)
+{
+    struct stat st;
+
+    if (stat (cfg_file, &st) < 0)
+        return 0;
+
+    *mtime = (int64_t)st.st_mtime;
+    *size  = (int64_t)st.st_size;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// Text config parser, the result has the same memory layout as the blob.
+//------------------------------------------------------------------------------
+layout_t *layout_parse (const char *cfg_file, int fb_w, int fb_h)
+{
+    FILE *fp;
+    layout_t *ly;
+    struct layout_hdr *hdr;
+    struct layout_item *item;
+    char line[512], *f[CFG_FIELD_MAX];
+    int cnt, sig = 0;
+
+    if ((fb_w <= 0) || (fb_h <= 0) || ((fp = fopen (cfg_file, "r")) == NULL))
+        return NULL;
+
+    if ((ly = (layout_t *)calloc (1, sizeof(layout_t))) == NULL)
+        goto out;
+
+    ly->buf_size = sizeof(struct layout_hdr) + LAYOUT_ITEM_MAX * sizeof(struct layout_item);
+    if ((ly->buf = calloc (1, ly->buf_size)) == NULL) {
+        free (ly);  ly = NULL;
+        goto out;
+    }
+    hdr  = (struct layout_hdr *)ly->buf;
+    item = (struct layout_item *)(hdr + 1);
+
+    hdr->magic   = LAYOUT_MAGIC;
+    hdr->version = LAYOUT_VERSION;
+    hdr->fb_w    = fb_w;
+    hdr->fb_h    = fb_h;
+    layout_stamp (cfg_file, &hdr->cfg_mtime, &hdr->cfg_size);
+
+    while (fgets (line, sizeof(line), fp) != NULL) {
+        if ((line[0] == '#') || (line[0] == '\r') || (line[0] == '\n'))
+            continue;
+        // the items are valid after the signature line
+        if (!sig) {
+            sig = !strncmp (line, CFG_SIGNATURE, strlen (CFG_SIGNATURE));
+            continue;
+        }
+        cnt = cfg_split (line, f);
+
+        if (!strcmp (f[0], "C") && (cnt >= 6)) {
+            hdr->cfg.is_bgr = atoi (f[1]);
+            hdr->cfg.fc     = strtoul (f[2], NULL, 16);
+            hdr->cfg.rc     = strtoul (f[3], NULL, 16);
+            hdr->cfg.lc     = strtoul (f[4], NULL, 16);
+            hdr->cfg.font   = atoi (f[5]);
+        }
+        if (!strcmp (f[0], "B") && (cnt >= 11)) {
+            if (hdr->item_cnt >= LAYOUT_ITEM_MAX) {
+                printf ("%s : %s, too many items\n", __func__, cfg_file);
+                break;
+            }
+            item->id    = atoi (f[1]);
+            item->x     = layout_scale (atoi (f[2]), fb_w);
+            item->y     = layout_scale (atoi (f[3]), fb_h);
+            item->w     = layout_scale (atoi (f[4]), fb_w);
+            item->h     = layout_scale (atoi (f[5]), fb_h);
+            item->lw    = atoi (f[6]);
+            item->scale = atoi (f[7]);
+            item->align = atoi (f[8]);
+            item->group = atoi (f[9]);
+            strncpy (item->str, f[10], LAYOUT_STR_MAX -1);
+
+            if (item->x + item->w > fb_w)   item->w = fb_w - item->x;
+            if (item->y + item->h > fb_h)   item->h = fb_h - item->y;
+            item++;     hdr->item_cnt++;
+        }
+    }
+    hdr->size = sizeof(struct layout_hdr) + hdr->item_cnt * sizeof(struct layout_item);
+    hdr->crc  = crc32_calc (hdr + 1, hdr->size - sizeof(struct layout_hdr));
+
+    ly->hdr  = hdr;
+    ly->item = (const struct layout_item *)(hdr + 1);
+    ly->cnt  = hdr->item_cnt;
+out:
+    fclose (fp);
+    return ly;
+}
+
+//------------------------------------------------------------------------------
+// mmap the compiled blob, NULL = missing, broken or stale (cfg changed, resolution)
+//------------------------------------------------------------------------------
+layout_t *layout_map (const char *blob_file, const char *cfg_file, int fb_w, int fb_h)
+{
+    const struct layout_hdr *hdr;
+    struct stat st;
+    layout_t *ly;
+    int64_t mtime, size;
+    void *map;
+    int fd;
+
+    if ((fd = open (blob_file, O_RDONLY)) < 0)
+        return NULL;
+
+    if ((fstat (fd, &st) < 0) || (st.st_size < (off_t)sizeof(struct layout_hdr))) {
+        close (fd);
+        return NULL;
+    }
+    map = mmap (NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close (fd);
+    if (map == MAP_FAILED)
+        return NULL;
+
+    hdr = (const struct layout_hdr *)map;
+    if ((hdr->magic != LAYOUT_MAGIC) || (hdr->version != LAYOUT_VERSION) ||
+        (hdr->size != (uint32_t)st.st_size) ||
+        (hdr->item_cnt < 0) || (hdr->item_cnt > LAYOUT_ITEM_MAX) ||
+        (hdr->size != sizeof(struct layout_hdr) + hdr->item_cnt * sizeof(struct layout_item)))
+        goto err;
+
+    if ((hdr->fb_w != fb_w) || (hdr->fb_h != fb_h))
+        goto err;
+
+    // source config changed after the compile
+    if (layout_stamp (cfg_file, &mtime, &size) &&
+        ((mtime != hdr->cfg_mtime) || (size != hdr->cfg_size)))
+        goto err;
+
+    if (hdr->crc != crc32_calc (hdr + 1, hdr->size - sizeof(struct layout_hdr)))
+        goto err;
+
+    if ((ly = (layout_t *)calloc (1, sizeof(layout_t))) == NULL)
+        goto err;
+
+    ly->hdr      = hdr;
+    ly->item     = (const struct layout_item *)(hdr + 1);
+    ly->cnt      = hdr->item_cnt;
+    ly->mapped   = 1;
+    ly->buf      = map;
+    ly->buf_size = st.st_size;
+    return ly;
+err:
+    munmap (map, st.st_size);
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+// Compiled blob first, text config fallback (the app never writes the blob).
+//------------------------------------------------------------------------------
+layout_t *layout_load (const char *blob_file, const char *cfg_file, int fb_w, int fb_h)
+{
+    layout_t *ly;
+
+    if ((ly = layout_map (blob_file, cfg_file, fb_w, fb_h)) != NULL)
+        return ly;
+
+    printf ("%s : %s missing or stale (make layout), parse %s\n", __func__, blob_file, cfg_file);
+    return layout_parse (cfg_file, fb_w, fb_h);
+}
+
+//------------------------------------------------------------------------------
+// write to a temp file and rename (a reader never sees a partial blob)
+//------------------------------------------------------------------------------
+int layout_write (const layout_t *ly, const char *blob_file)
+{
+    char tmp[PATH_MAX];
+    int fd, ret;
+
+    snprintf (tmp, sizeof(tmp), "%s.tmp", blob_file);
+    if ((fd = open (tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0)
+        return 0;
+
+    ret = (write (fd, ly->hdr, ly->hdr->size) == (ssize_t)ly->hdr->size);
+    close (fd);
+
+    if (!ret || rename (tmp, blob_file) < 0) {
+        unlink (tmp);
+        return 0;
+    }
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+const struct layout_item *layout_find (const layout_t *ly, int id)
+{
+    int i;
+
+    for (i = 0; i < ly->cnt; i++)
+        if (ly->item[i].id == id)
+            return &ly->item[i];
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+void layout_close (layout_t *ly)
+{
+    if (ly) {
+        if (ly->mapped)
+            munmap (ly->buf, ly->buf_size);
+        else
+            free (ly->buf);
+        free (ly);
+    }
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
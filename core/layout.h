@@ -0,0 +1,85 @@
+//------------------------------------------------------------------------------
+/**
+ * @file layout.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef __LAYOUT_H__
+#define __LAYOUT_H__
+
+//------------------------------------------------------------------------------
+#include <stdint.h>
+#include <stddef.h>
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// Compiled ui layout (m1.cfg -> m1.lyt), all fields little endian int32.
+//------------------------------------------------------------------------------
+// "JIGL"
+#define LAYOUT_MAGIC        0x4C47494A
+#define LAYOUT_VERSION      1
+
+#define LAYOUT_ITEM_MAX     256
+#define LAYOUT_STR_MAX      64
+
+// 'C' command
+struct layout_cfg {
+    // 0 = RGB, 1 = BGR, font (0 ~ 4)
+    int32_t     is_bgr, font;
+    // default string, box, line color (0xRRGGBB)
+    uint32_t    fc, rc, lc;
+};
+
+// 'B' command, coordinates resolved to pixels
+struct layout_item {
+    int32_t     id;
+    int32_t     x, y, w, h;
+    int32_t     lw, scale, align, group;
+    char        str [LAYOUT_STR_MAX];
+};
+
+struct layout_hdr {
+    uint32_t    magic, version;
+    // blob size (bytes), crc32 of everything after the header
+    uint32_t    size, crc;
+    // target resolution
+    int32_t     fb_w, fb_h;
+    // source m1.cfg stamp (stale check)
+    int64_t     cfg_mtime, cfg_size;
+    int32_t     item_cnt, reserved;
+    struct layout_cfg   cfg;
+};
+
+typedef struct layout__t {
+    const struct layout_hdr     *hdr;
+    const struct layout_item    *item;
+    int     cnt;
+    // 1 = mmap of the compiled blob, 0 = parsed from the text config
+    int     mapped;
+    void    *buf;
+    size_t  buf_size;
+}   layout_t;
+
+//------------------------------------------------------------------------------
+// function prototype
+//------------------------------------------------------------------------------
+extern layout_t *layout_parse   (const char *cfg_file, int fb_w, int fb_h);
+extern layout_t *layout_map     (const char *blob_file, const char *cfg_file, int fb_w, int fb_h);
+extern layout_t *layout_load    (const char *blob_file, const char *cfg_file, int fb_w, int fb_h);
+extern int      layout_write    (const layout_t *ly, const char *blob_file);
+extern const struct layout_item *layout_find (const layout_t *ly, int id);
+extern void     layout_close    (layout_t *ly);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#endif  // #define __LAYOUT_H__
+//------------------------------------------------------------------------------
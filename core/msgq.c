@@ -0,0 +1,115 @@
+//------------------------------------------------------------------------------
+/**
+ * @file msgq.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//------------------------------------------------------------------------------
+#include "msgq.h"
+
+//------------------------------------------------------------------------------
+//
+// Each cell carries a sequence number. Producers claim a position with a CAS
+// on head and publish the cell by storing pos + 1 into its sequence.
+// The consumer frees the cell by storing pos + count (next lap).
+//
+//------------------------------------------------------------------------------
+msgq_t *msgq_init (unsigned int count, unsigned int esize)
+{
+    msgq_t *q;
+    unsigned int i;
+
+    // power of 2
+    if ((count < 2) || (count & (count - 1)) || !esize)
+        return NULL;
+
+    if ((q = (msgq_t *)calloc (1, sizeof(msgq_t))) == NULL)
+        return NULL;
+
+    q->seq  = (atomic_uint *)calloc (count, sizeof(atomic_uint));
+    q->data = (char *)calloc (count, esize);
+    if ((q->seq == NULL) || (q->data == NULL)) {
+        msgq_close (q);
+        return NULL;
+    }
+    q->count = count;
+    q->mask  = count - 1;
+    q->esize = esize;
+    q->tail  = 0;
+    atomic_init (&q->head, 0);
+    for (i = 0; i < count; i++)
+        atomic_init (&q->seq[i], i);
+
+    return q;
+}
+
+//------------------------------------------------------------------------------
+// any thread. return 0 = queue full
+//------------------------------------------------------------------------------
+int msgq_put (msgq_t *q, const void *msg)
+{
+    unsigned int pos, seq;
+    int diff;
+
+    pos = atomic_load_explicit (&q->head, memory_order_relaxed);
+    while (1) {
+        seq  = atomic_load_explicit (&q->seq[pos & q->mask], memory_order_acquire);
+        diff = (int)(seq - pos);
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit (&q->head, &pos, pos + 1,
+                                memory_order_relaxed, memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+            return 0;
+        else
+            pos = atomic_load_explicit (&q->head, memory_order_relaxed);
+    }
+    memcpy (q->data + (pos & q->mask) * q->esize, msg, q->esize);
+    atomic_store_explicit (&q->seq[pos & q->mask], pos + 1, memory_order_release);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// consumer thread only. return 0 = queue empty
+//------------------------------------------------------------------------------
+int msgq_get (msgq_t *q, void *msg)
+{
+    unsigned int pos = q->tail, seq;
+
+    seq = atomic_load_explicit (&q->seq[pos & q->mask], memory_order_acquire);
+    if ((int)(seq - (pos + 1)) < 0)
+        return 0;
+
+    memcpy (msg, q->data + (pos & q->mask) * q->esize, q->esize);
+    atomic_store_explicit (&q->seq[pos & q->mask], pos + q->count, memory_order_release);
+    q->tail = pos + 1;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+void msgq_close (msgq_t *q)
+{
+    if (q) {
+        free (q->seq);
+        free (q->data);
+        free (q);
+    }
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
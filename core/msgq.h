@@ -0,0 +1,47 @@
+//------------------------------------------------------------------------------
+/**
+ * @file msgq.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef __MSGQ_H__
+#define __MSGQ_H__
+
+//------------------------------------------------------------------------------
+#include <stdatomic.h>
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// Bounded lock-free queue, multi producer / single consumer.
+// (fixed size messages, copied in/out)
+typedef struct msgq__t {
+    unsigned int    count, mask, esize;
+    // producer / consumer position
+    atomic_uint     head;
+    unsigned int    tail;
+    // per cell sequence number
+    atomic_uint     *seq;
+    char            *data;
+}   msgq_t;
+
+//------------------------------------------------------------------------------
+// function prototype
+//------------------------------------------------------------------------------
+extern msgq_t   *msgq_init  (unsigned int count, unsigned int esize);
+extern int      msgq_put    (msgq_t *q, const void *msg);
+extern int      msgq_get    (msgq_t *q, void *msg);
+extern void     msgq_close  (msgq_t *q);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#endif  // #define __MSGQ_H__
+//------------------------------------------------------------------------------
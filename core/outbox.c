@@ -0,0 +1,308 @@
+//------------------------------------------------------------------------------
+/**
+ * @file outbox.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//------------------------------------------------------------------------------
+#include "outbox.h"
+
+//------------------------------------------------------------------------------
+//
+// Tests post their server messages (error codes, mac label) at any time.
+// Until the server is found they wait in a fifo, outbox_set_dst() sends
+// them in the posted order. Without the sender thread the sends run in the
+// caller under the lock, so a message posted during a flush can not pass
+// the queued ones. With outbox_start() a single sender thread takes every
+// queued message as one batch (batch writer, else one send per message)
+// and the callers never wait for the network. The jig has no batch writer
+// (nlp_server_write per message), the batch hook is for a transport with
+// a persistent connection (tools/outbox_bench pipe).
+//
+//------------------------------------------------------------------------------
+// lock held. copy of the queued messages (oldest first)
+//------------------------------------------------------------------------------
+static int queue_copy (outbox_t *o, struct outbox_msg *m)
+{
+    int i;
+
+    for (i = 0; i < o->cnt; i++)
+        m[i] = o->q[(o->head + i) % OUTBOX_MSG_MAX];
+    return o->cnt;
+}
+
+//------------------------------------------------------------------------------
+// lock held. remove the sent messages
+//------------------------------------------------------------------------------
+static void queue_pop (outbox_t *o, int cnt)
+{
+    o->head = (o->head + cnt) % OUTBOX_MSG_MAX;
+    o->cnt -= cnt;
+    o->sent += cnt;
+}
+
+//------------------------------------------------------------------------------
+// return messages sent (in order, stops at the first failure)
+//------------------------------------------------------------------------------
+static int send_batch (outbox_t *o, char *dst, struct outbox_msg *m, int cnt)
+{
+    int i;
+
+    if (o->batch)
+        return o->batch (dst, m, cnt, o->batch_arg);
+
+    for (i = 0; i < cnt; i++)
+        if (!o->send (dst, m[i].type, m[i].msg, m[i].ch))
+            break;
+    return i;
+}
+
+//------------------------------------------------------------------------------
+// lock held (no sender thread). return messages sent
+//------------------------------------------------------------------------------
+static int flush_locked (outbox_t *o)
+{
+    struct outbox_msg m [OUTBOX_MSG_MAX];
+    int cnt;
+
+    if (!o->cnt || !o->dst[0])
+        return 0;
+
+    cnt = send_batch (o, o->dst, m, queue_copy (o, m));
+    queue_pop (o, cnt);
+    if (cnt)
+        o->batches++;
+    return cnt;
+}
+
+//------------------------------------------------------------------------------
+static void cond_wait_ms (outbox_t *o, int timeout_ms)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_REALTIME, &ts);
+    ts.tv_sec  += timeout_ms / 1000;
+    ts.tv_nsec += (timeout_ms % 1000) * 1000000;
+    if (ts.tv_nsec >= 1000000000) {
+        ts.tv_sec++;    ts.tv_nsec -= 1000000000;
+    }
+    pthread_cond_timedwait (&o->cond, &o->lock, &ts);
+}
+
+//------------------------------------------------------------------------------
+static void *outbox_thread (void *arg)
+{
+    outbox_t *o = (outbox_t *)arg;
+    struct outbox_msg m [OUTBOX_MSG_MAX];
+    char dst [OUTBOX_DST_SIZE];
+    int cnt, sent;
+
+    pthread_mutex_lock (&o->lock);
+    while (!o->stop) {
+        if (!o->cnt || !o->dst[0]) {
+            pthread_cond_wait (&o->cond, &o->lock);
+            continue;
+        }
+        cnt = queue_copy (o, m);
+        memcpy (dst, o->dst, sizeof(dst));
+        o->busy = 1;
+        pthread_mutex_unlock (&o->lock);
+
+        // network without the lock, posts keep queueing behind this batch
+        sent = send_batch (o, dst, m, cnt);
+
+        pthread_mutex_lock (&o->lock);
+        queue_pop (o, sent);
+        o->batches++;
+        o->busy = 0;
+        pthread_cond_broadcast (&o->cond);
+
+        // server gone : retry later (or on outbox_set_dst)
+        if ((sent < cnt) && !o->stop)
+            cond_wait_ms (o, OUTBOX_RETRY_MS);
+    }
+    pthread_mutex_unlock (&o->lock);
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+outbox_t *outbox_init (outbox_send_t send)
+{
+    outbox_t *o;
+
+    if ((o = (outbox_t *)calloc (1, sizeof(outbox_t))) == NULL)
+        return NULL;
+
+    pthread_mutex_init (&o->lock, NULL);
+    pthread_cond_init  (&o->cond, NULL);
+    o->send = send;
+    return o;
+}
+
+//------------------------------------------------------------------------------
+// batch writer instead of send() per message (before outbox_start)
+//------------------------------------------------------------------------------
+void outbox_set_batch (outbox_t *o, outbox_batch_t batch, void *arg)
+{
+    pthread_mutex_lock (&o->lock);
+    o->batch     = batch;
+    o->batch_arg = arg;
+    pthread_mutex_unlock (&o->lock);
+}
+
+//------------------------------------------------------------------------------
+// asynchronous sends. return 1 = sender thread running
+//------------------------------------------------------------------------------
+int outbox_start (outbox_t *o)
+{
+    int ret = 1;
+
+    pthread_mutex_lock (&o->lock);
+    if (!o->running) {
+        if (pthread_create (&o->thread, NULL, outbox_thread, o))
+            ret = 0;
+        else
+            o->running = 1;
+    }
+    pthread_mutex_unlock (&o->lock);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+// any thread. queued, sent when the server is known.
+// return 0 = queue full (message dropped)
+//------------------------------------------------------------------------------
+int outbox_post (outbox_t *o, char type, const char *msg, char ch)
+{
+    struct outbox_msg *m;
+    int ret = 1;
+
+    pthread_mutex_lock (&o->lock);
+    if (o->cnt < OUTBOX_MSG_MAX) {
+        m = &o->q[(o->head + o->cnt) % OUTBOX_MSG_MAX];
+        m->type = type;
+        m->ch   = ch;
+        snprintf (m->msg, sizeof(m->msg), "%s", msg);
+        o->cnt++;
+        if (o->running)
+            pthread_cond_broadcast (&o->cond);
+        else
+            flush_locked (o);
+    } else {
+        printf ("%s : queue full, '%s' dropped\n", __func__, msg);
+        o->dropped++;
+        ret = 0;
+    }
+    pthread_mutex_unlock (&o->lock);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+// server found (NULL / "" = lost). return messages sent (0 : sender thread)
+//------------------------------------------------------------------------------
+int outbox_set_dst (outbox_t *o, const char *dst)
+{
+    int cnt = 0, pending, running;
+
+    pthread_mutex_lock (&o->lock);
+    snprintf (o->dst, sizeof(o->dst), "%s", dst ? dst : "");
+    if ((running = o->running))
+        pthread_cond_broadcast (&o->cond);
+    else
+        cnt = flush_locked (o);
+    pending = o->cnt;
+    pthread_mutex_unlock (&o->lock);
+
+    printf ("%s : %s, %d queued messages %s\n", __func__, dst ? dst : "",
+            running ? pending : cnt, running ? "to send" : "sent");
+    return cnt;
+}
+
+//------------------------------------------------------------------------------
+// retry after a failed send (no sender thread). return messages sent
+//------------------------------------------------------------------------------
+int outbox_flush (outbox_t *o)
+{
+    int cnt = 0;
+
+    pthread_mutex_lock (&o->lock);
+    if (o->running)
+        pthread_cond_broadcast (&o->cond);
+    else
+        cnt = flush_locked (o);
+    pthread_mutex_unlock (&o->lock);
+    return cnt;
+}
+
+//------------------------------------------------------------------------------
+int outbox_pending (outbox_t *o)
+{
+    int cnt;
+
+    pthread_mutex_lock (&o->lock);
+    cnt = o->cnt;
+    pthread_mutex_unlock (&o->lock);
+    return cnt;
+}
+
+//------------------------------------------------------------------------------
+// wait for the sender thread to empty the queue. return 1 = all sent
+//------------------------------------------------------------------------------
+int outbox_wait (outbox_t *o, int timeout_ms)
+{
+    struct timespec now;
+    long long end;
+    int ret;
+
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    end = (long long)now.tv_sec * 1000 + now.tv_nsec / 1000000 + timeout_ms;
+
+    pthread_mutex_lock (&o->lock);
+    while (o->running && (o->cnt || o->busy)) {
+        clock_gettime (CLOCK_MONOTONIC, &now);
+        if ((ret = (int)(end - ((long long)now.tv_sec * 1000 + now.tv_nsec / 1000000))) <= 0)
+            break;
+        cond_wait_ms (o, ret);
+    }
+    ret = o->cnt ? 0 : 1;
+    pthread_mutex_unlock (&o->lock);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+// queued messages are not sent (outbox_wait first)
+//------------------------------------------------------------------------------
+void outbox_close (outbox_t *o)
+{
+    int running;
+
+    if (o == NULL)
+        return;
+    pthread_mutex_lock (&o->lock);
+    running = o->running;
+    o->stop = 1;
+    pthread_cond_broadcast (&o->cond);
+    pthread_mutex_unlock (&o->lock);
+    if (running)
+        pthread_join (o->thread, NULL);
+    pthread_cond_destroy  (&o->cond);
+    pthread_mutex_destroy (&o->lock);
+    free (o);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
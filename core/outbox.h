@@ -0,0 +1,80 @@
+//------------------------------------------------------------------------------
+/**
+ * @file outbox.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef __OUTBOX_H__
+#define __OUTBOX_H__
+
+//------------------------------------------------------------------------------
+#include <pthread.h>
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#define OUTBOX_MSG_MAX      32
+#define OUTBOX_MSG_SIZE     64
+#define OUTBOX_DST_SIZE     20
+// sender thread retry period after a failed send (msec)
+#define OUTBOX_RETRY_MS     500
+
+struct outbox_msg {
+    char    type, ch;
+    char    msg [OUTBOX_MSG_SIZE];
+};
+
+// server message writer (nlp_server_write). return 1 = sent
+typedef int (*outbox_send_t)  (char *dst, char type, char *msg, char ch);
+// batch writer (persistent / pipelined transport). return messages sent
+// not used by the jig yet, nlp_server_ctrl has no connection api
+typedef int (*outbox_batch_t) (const char *dst, const struct outbox_msg *m, int cnt, void *arg);
+
+// Messages for a server that may not be found yet. Kept in order until the
+// destination is set, a failed send stays queued for the next flush.
+// With the sender thread started the callers only queue, every wake up
+// sends all queued messages as one batch.
+typedef struct outbox__t {
+    pthread_mutex_t     lock;
+    pthread_cond_t      cond;
+    outbox_send_t       send;
+    outbox_batch_t      batch;
+    void                *batch_arg;
+    // "" = server not known
+    char                dst [OUTBOX_DST_SIZE];
+
+    struct outbox_msg   q [OUTBOX_MSG_MAX];
+    int                 head, cnt;
+    // sent, dropped (queue full), batches
+    int                 sent, dropped, batches;
+
+    // sender thread
+    pthread_t           thread;
+    int                 running, stop, busy;
+}   outbox_t;
+
+//------------------------------------------------------------------------------
+// function prototype
+//------------------------------------------------------------------------------
+extern outbox_t *outbox_init        (outbox_send_t send);
+extern void     outbox_set_batch    (outbox_t *o, outbox_batch_t batch, void *arg);
+extern int      outbox_start        (outbox_t *o);
+extern int      outbox_post         (outbox_t *o, char type, const char *msg, char ch);
+extern int      outbox_set_dst      (outbox_t *o, const char *dst);
+extern int      outbox_flush        (outbox_t *o);
+extern int      outbox_pending      (outbox_t *o);
+extern int      outbox_wait         (outbox_t *o, int timeout_ms);
+extern void     outbox_close        (outbox_t *o);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#endif  // #define __OUTBOX_H__
+//------------------------------------------------------------------------------
@@ -0,0 +1,246 @@
+//------------------------------------------------------------------------------
+/**
+ * @file reactor.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/eventfd.h>
+
+//------------------------------------------------------------------------------
+#include "reactor.h"
+
+//------------------------------------------------------------------------------
+//
+// Single epoll event loop. Input devices, timers (timerfd) and hotplug fds are
+// registered with a handler and dispatched from one thread, no polling.
+// Any fd can be registered (pipe, uinput device...) to inject events.
+//
+//------------------------------------------------------------------------------
+#define REACTOR_EVENT_MAX   8
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+static int reactor_add (reactor_t *r, int fd, int timer, reactor_func_t func, void *arg)
+{
+    struct epoll_event ev;
+    int i;
+
+    pthread_mutex_lock (&r->lock);
+    for (i = 0; i < REACTOR_SRC_MAX; i++) {
+        if (r->src[i].func == NULL)
+            break;
+    }
+    if (i == REACTOR_SRC_MAX) {
+        pthread_mutex_unlock (&r->lock);
+        return -1;
+    }
+    r->src[i].fd    = fd;
+    r->src[i].timer = timer;
+    r->src[i].func  = func;
+    r->src[i].arg   = arg;
+
+    memset (&ev, 0, sizeof(ev));
+    ev.events   = EPOLLIN;
+    ev.data.u32 = i;
+    if (epoll_ctl (r->epfd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        memset (&r->src[i], 0, sizeof(struct reactor_src));
+        i = -1;
+    }
+    pthread_mutex_unlock (&r->lock);
+
+    return i;
+}
+
+//------------------------------------------------------------------------------
+// lock held
+//------------------------------------------------------------------------------
+static void reactor_release (reactor_t *r, int i)
+{
+    epoll_ctl (r->epfd, EPOLL_CTL_DEL, r->src[i].fd, NULL);
+    if (r->src[i].timer)
+        close (r->src[i].fd);
+    memset (&r->src[i], 0, sizeof(struct reactor_src));
+}
+
+//------------------------------------------------------------------------------
+static void *reactor_thread (void *arg)
+{
+    reactor_run ((reactor_t *)arg);
+    return arg;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+reactor_t *reactor_init (void)
+{
+    struct epoll_event ev;
+    reactor_t *r;
+
+    if ((r = (reactor_t *)calloc (1, sizeof(reactor_t))) == NULL)
+        return NULL;
+
+    if ((r->epfd = epoll_create1 (EPOLL_CLOEXEC)) < 0) {
+        free (r);
+        return NULL;
+    }
+    // wake up source (not in the dispatch table)
+    if ((r->wfd = eventfd (0, EFD_NONBLOCK | EFD_CLOEXEC)) >= 0) {
+        memset (&ev, 0, sizeof(ev));
+        ev.events   = EPOLLIN;
+        ev.data.u32 = REACTOR_SRC_MAX;
+        epoll_ctl (r->epfd, EPOLL_CTL_ADD, r->wfd, &ev);
+    }
+    pthread_mutex_init (&r->lock, NULL);
+    return r;
+}
+
+//------------------------------------------------------------------------------
+// return source id, -1 = error
+//------------------------------------------------------------------------------
+int reactor_add_fd (reactor_t *r, int fd, reactor_func_t func, void *arg)
+{
+    if ((fd < 0) || (func == NULL))
+        return -1;
+
+    return reactor_add (r, fd, 0, func, arg);
+}
+
+//------------------------------------------------------------------------------
+// periodic timer. return timer fd, -1 = error
+//------------------------------------------------------------------------------
+int reactor_add_timer (reactor_t *r, int period_ms, reactor_func_t func, void *arg)
+{
+    struct itimerspec its;
+    int fd;
+
+    if ((period_ms <= 0) || (func == NULL))
+        return -1;
+
+    if ((fd = timerfd_create (CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)) < 0)
+        return -1;
+
+    memset (&its, 0, sizeof(its));
+    its.it_value.tv_sec     = period_ms / 1000;
+    its.it_value.tv_nsec    = (period_ms % 1000) * 1000000;
+    its.it_interval         = its.it_value;
+
+    if ((timerfd_settime (fd, 0, &its, NULL) < 0) || (reactor_add (r, fd, 1, func, arg) < 0)) {
+        close (fd);
+        return -1;
+    }
+    return fd;
+}
+
+//------------------------------------------------------------------------------
+int reactor_remove (reactor_t *r, int fd)
+{
+    int i, ret = 0;
+
+    pthread_mutex_lock (&r->lock);
+    for (i = 0; i < REACTOR_SRC_MAX; i++) {
+        if (r->src[i].func && (r->src[i].fd == fd)) {
+            reactor_release (r, i);
+            ret = 1;
+            break;
+        }
+    }
+    pthread_mutex_unlock (&r->lock);
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+int reactor_run (reactor_t *r)
+{
+    struct epoll_event ev [REACTOR_EVENT_MAX];
+    struct reactor_src src;
+    uint64_t expire;
+    int i, n, id;
+
+    while (!atomic_load (&r->stop)) {
+        if ((n = epoll_wait (r->epfd, ev, REACTOR_EVENT_MAX, -1)) < 0) {
+            if (errno == EINTR)
+                continue;
+            return 0;
+        }
+        for (i = 0; i < n; i++) {
+            if ((id = ev[i].data.u32) >= REACTOR_SRC_MAX)
+                continue;
+
+            pthread_mutex_lock (&r->lock);
+            src = r->src[id];
+            pthread_mutex_unlock (&r->lock);
+
+            if (src.func == NULL)
+                continue;
+
+            // timer expire count
+            if (src.timer && (read (src.fd, &expire, sizeof(expire)) != sizeof(expire)))
+                continue;
+
+            if (src.func (src.fd, ev[i].events, src.arg) < 0) {
+                pthread_mutex_lock (&r->lock);
+                if (r->src[id].fd == src.fd)
+                    reactor_release (r, id);
+                pthread_mutex_unlock (&r->lock);
+            }
+        }
+    }
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+int reactor_start (reactor_t *r)
+{
+    if (pthread_create (&r->thread, NULL, reactor_thread, r))
+        return 0;
+
+    r->running = 1;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+void reactor_close (reactor_t *r)
+{
+    uint64_t wake = 1;
+    int i;
+
+    atomic_store (&r->stop, 1);
+    if (r->running) {
+        if (write (r->wfd, &wake, sizeof(wake)) == sizeof(wake))
+            pthread_join (r->thread, NULL);
+    }
+    pthread_mutex_lock (&r->lock);
+    for (i = 0; i < REACTOR_SRC_MAX; i++) {
+        if (r->src[i].func)
+            reactor_release (r, i);
+    }
+    pthread_mutex_unlock (&r->lock);
+
+    if (r->wfd >= 0)
+        close (r->wfd);
+    close (r->epfd);
+    pthread_mutex_destroy (&r->lock);
+    free (r);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,63 @@
+//------------------------------------------------------------------------------
+/**
+ * @file reactor.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef __REACTOR_H__
+#define __REACTOR_H__
+
+//------------------------------------------------------------------------------
+#include <pthread.h>
+#include <stdatomic.h>
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#define REACTOR_SRC_MAX     16
+
+// event handler. return 0 = keep, -1 = remove the source
+typedef int (*reactor_func_t) (int fd, unsigned int events, void *arg);
+
+struct reactor_src {
+    int             fd;
+    // 1 = timerfd (owned by the reactor)
+    int             timer;
+    reactor_func_t  func;
+    void            *arg;
+};
+
+typedef struct reactor__t {
+    int                 epfd;
+    // set by reactor_close or a handler (reactor_run returns)
+    atomic_int          stop;
+    // wake up fd (reactor_close), 1 = reactor_start thread running
+    int                 wfd, running;
+    struct reactor_src  src [REACTOR_SRC_MAX];
+    pthread_mutex_t     lock;
+    pthread_t           thread;
+}   reactor_t;
+
+//------------------------------------------------------------------------------
+// function prototype
+//------------------------------------------------------------------------------
+extern reactor_t    *reactor_init       (void);
+extern int          reactor_add_fd      (reactor_t *r, int fd, reactor_func_t func, void *arg);
+extern int          reactor_add_timer   (reactor_t *r, int period_ms, reactor_func_t func, void *arg);
+extern int          reactor_remove      (reactor_t *r, int fd);
+extern int          reactor_run         (reactor_t *r);
+extern int          reactor_start       (reactor_t *r);
+extern void         reactor_close       (reactor_t *r);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#endif  // #define __REACTOR_H__
+//------------------------------------------------------------------------------
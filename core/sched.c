@@ -0,0 +1,255 @@
+//------------------------------------------------------------------------------
+/**
+ * @file sched.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+
+//------------------------------------------------------------------------------
+#include "sched.h"
+
+//------------------------------------------------------------------------------
+//
+// Test graph scheduler.
+// Every task declares the tasks it depends on. The worker pool runs all the
+// tasks whose prerequisites are done, a task that is not finished yet is run
+// again after its retry period. Tasks that share hardware are excluded from
+// each other (sched_exclude) and are never run at the same time.
+//
+//------------------------------------------------------------------------------
+static long long time_ms (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+//------------------------------------------------------------------------------
+static void time_to_ts (long long ms, struct timespec *ts)
+{
+    ts->tv_sec  = ms / 1000;
+    ts->tv_nsec = (ms % 1000) * 1000000;
+}
+
+//------------------------------------------------------------------------------
+// lock held. return ready task id, -1 = none (*wake_ms = next retry time)
+//------------------------------------------------------------------------------
+static int sched_pick (sched_t *s, long long now, long long *wake_ms)
+{
+    struct sched_task *t;
+    unsigned int run_mask = 0;
+    int i;
+
+    for (i = 0; i < SCHED_TASK_MAX; i++)
+        if (s->task[i].state == eSCHED_RUN)
+            run_mask |= SCHED_DEP(i);
+
+    *wake_ms = 0;
+    for (i = 0; i < SCHED_TASK_MAX; i++) {
+        t = &s->task[i];
+        if ((t->state != eSCHED_WAIT) || ((t->deps & s->done_mask) != t->deps))
+            continue;
+        // picked again when the excluded task leaves RUN (broadcast)
+        if (t->excl & run_mask)
+            continue;
+        if (t->next_ms <= now)
+            return i;
+        if (!*wake_ms || (t->next_ms < *wake_ms))
+            *wake_ms = t->next_ms;
+    }
+    return -1;
+}
+
+//------------------------------------------------------------------------------
+static void *sched_worker (void *arg)
+{
+    sched_t *s = (sched_t *)arg;
+    struct sched_task *t;
+    struct timespec ts;
+    long long wake_ms;
+    int id, ret;
+
+    pthread_mutex_lock (&s->lock);
+    while (!s->stop && (s->done_mask != s->task_mask)) {
+        if ((id = sched_pick (s, time_ms (), &wake_ms)) < 0) {
+            if (wake_ms) {
+                time_to_ts (wake_ms, &ts);
+                pthread_cond_timedwait (&s->cond, &s->lock, &ts);
+            } else {
+                pthread_cond_wait (&s->cond, &s->lock);
+            }
+            continue;
+        }
+        t = &s->task[id];
+        t->state = eSCHED_RUN;
+        if (!t->start_ms)
+            t->start_ms = time_ms ();
+        pthread_mutex_unlock (&s->lock);
+
+        ret = t->func (s->arg);
+
+        pthread_mutex_lock (&s->lock);
+        if (ret || !t->retry_ms) {
+            t->state   = eSCHED_DONE;
+            t->done_ms = time_ms ();
+            s->done_mask |= SCHED_DEP(id);
+            printf ("%s : %s done (%lld ms)\n", __func__, t->name, t->done_ms - t->start_ms);
+        } else {
+            t->state   = eSCHED_WAIT;
+            t->next_ms = time_ms () + t->retry_ms;
+        }
+        // new tasks may be ready (prerequisite done, excluded task stopped)
+        pthread_cond_broadcast (&s->cond);
+    }
+    // wake up the other workers
+    pthread_cond_broadcast (&s->cond);
+    pthread_mutex_unlock (&s->lock);
+    return arg;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+sched_t *sched_init (int worker_cnt, void *arg)
+{
+    sched_t *s;
+    pthread_condattr_t attr;
+
+    if ((s = (sched_t *)calloc (1, sizeof(sched_t))) == NULL)
+        return NULL;
+
+    s->worker_cnt = (worker_cnt > SCHED_WORKER_MAX) ? SCHED_WORKER_MAX : worker_cnt;
+    s->arg        = arg;
+
+    pthread_mutex_init (&s->lock, NULL);
+    pthread_condattr_init (&attr);
+    pthread_condattr_setclock (&attr, CLOCK_MONOTONIC);
+    pthread_cond_init (&s->cond, &attr);
+    pthread_condattr_destroy (&attr);
+
+    return s;
+}
+
+//------------------------------------------------------------------------------
+int sched_add (sched_t *s, int id, const char *name,
+               sched_func_t func, unsigned int deps, int retry_ms)
+{
+    if ((id < 0) || (id >= SCHED_TASK_MAX) || (func == NULL))
+        return 0;
+
+    pthread_mutex_lock (&s->lock);
+    memset (&s->task[id], 0, sizeof(struct sched_task));
+    s->task[id].name     = name;
+    s->task[id].func     = func;
+    s->task[id].deps     = deps;
+    s->task[id].retry_ms = retry_ms;
+    s->task[id].state    = eSCHED_WAIT;
+    s->task_mask |= SCHED_DEP(id);
+    pthread_cond_broadcast (&s->cond);
+    pthread_mutex_unlock (&s->lock);
+
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// id_a and id_b use the same hardware, never run them at the same time
+//------------------------------------------------------------------------------
+int sched_exclude (sched_t *s, int id_a, int id_b)
+{
+    if ((id_a < 0) || (id_a >= SCHED_TASK_MAX) || (id_b < 0) || (id_b >= SCHED_TASK_MAX))
+        return 0;
+
+    pthread_mutex_lock (&s->lock);
+    s->task[id_a].excl |= SCHED_DEP(id_b);
+    s->task[id_b].excl |= SCHED_DEP(id_a);
+    pthread_mutex_unlock (&s->lock);
+
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+int sched_start (sched_t *s)
+{
+    int i;
+
+    for (i = 0; i < s->worker_cnt; i++) {
+        if (pthread_create (&s->worker[i], NULL, sched_worker, s))
+            break;
+    }
+    s->worker_cnt = i;
+    return i;
+}
+
+//------------------------------------------------------------------------------
+int sched_is_done (sched_t *s, int id)
+{
+    int done;
+
+    pthread_mutex_lock (&s->lock);
+    done = (s->done_mask & SCHED_DEP(id)) ? 1 : 0;
+    pthread_mutex_unlock (&s->lock);
+
+    return done;
+}
+
+//------------------------------------------------------------------------------
+// wait until all tasks in mask are done. timeout_ms < 0 : wait forever
+// return 1 = done, 0 = timeout
+//------------------------------------------------------------------------------
+int sched_wait (sched_t *s, unsigned int mask, int timeout_ms)
+{
+    struct timespec ts;
+    int ret = 1;
+
+    time_to_ts (time_ms () + timeout_ms, &ts);
+
+    pthread_mutex_lock (&s->lock);
+    while ((s->done_mask & mask) != mask) {
+        if (timeout_ms < 0) {
+            pthread_cond_wait (&s->cond, &s->lock);
+        } else if (pthread_cond_timedwait (&s->cond, &s->lock, &ts) == ETIMEDOUT) {
+            ret = ((s->done_mask & mask) == mask);
+            break;
+        }
+    }
+    pthread_mutex_unlock (&s->lock);
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+void sched_close (sched_t *s)
+{
+    int i;
+
+    pthread_mutex_lock (&s->lock);
+    s->stop = 1;
+    pthread_cond_broadcast (&s->cond);
+    pthread_mutex_unlock (&s->lock);
+
+    for (i = 0; i < s->worker_cnt; i++)
+        pthread_join (s->worker[i], NULL);
+
+    pthread_cond_destroy  (&s->cond);
+    pthread_mutex_destroy (&s->lock);
+    free (s);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,82 @@
+//------------------------------------------------------------------------------
+/**
+ * @file sched.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef __SCHED_H__
+#define __SCHED_H__
+
+//------------------------------------------------------------------------------
+#include <pthread.h>
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#define SCHED_TASK_MAX      32
+#define SCHED_WORKER_MAX    8
+
+// prerequisite mask of the task id
+#define SCHED_DEP(id)       (1u << (id))
+
+// test function. return 1 = done, 0 = not yet (run again after retry_ms)
+typedef int (*sched_func_t) (void *arg);
+
+enum {
+    eSCHED_NONE = 0,
+    eSCHED_WAIT,
+    eSCHED_RUN,
+    eSCHED_DONE,
+};
+
+struct sched_task {
+    const char      *name;
+    sched_func_t    func;
+    // prerequisite task mask (SCHED_DEP), tasks that must not run at the same time
+    unsigned int    deps, excl;
+    // 0 = run once, > 0 = rerun period until func return 1
+    int             retry_ms;
+
+    int             state;
+    long long       next_ms;
+    // first start, done time (CLOCK_MONOTONIC ms)
+    long long       start_ms, done_ms;
+};
+
+typedef struct sched__t {
+    struct sched_task   task [SCHED_TASK_MAX];
+    unsigned int        task_mask, done_mask;
+
+    pthread_mutex_t     lock;
+    pthread_cond_t      cond;
+    pthread_t           worker [SCHED_WORKER_MAX];
+    int                 worker_cnt, stop;
+
+    // func argument
+    void                *arg;
+}   sched_t;
+
+//------------------------------------------------------------------------------
+// function prototype
+//------------------------------------------------------------------------------
+extern sched_t  *sched_init     (int worker_cnt, void *arg);
+extern int      sched_add       (sched_t *s, int id, const char *name,
+                                 sched_func_t func, unsigned int deps, int retry_ms);
+extern int      sched_exclude   (sched_t *s, int id_a, int id_b);
+extern int      sched_start     (sched_t *s);
+extern int      sched_is_done   (sched_t *s, int id);
+extern int      sched_wait      (sched_t *s, unsigned int mask, int timeout_ms);
+extern void     sched_close     (sched_t *s);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#endif  // #define __SCHED_H__
+//------------------------------------------------------------------------------
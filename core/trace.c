@@ -0,0 +1,267 @@
+//------------------------------------------------------------------------------
+/**
+ * @file trace.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+//------------------------------------------------------------------------------
+#include "trace.h"
+
+//------------------------------------------------------------------------------
+//
+// Status transitions of the test items in a lock-free ring (any thread).
+// A writer claims a position with fetch_add, marks the slot busy and
+// publishes the record by storing pos + 1 into its sequence. Exported at the end of the run as
+// Chrome trace-event JSON (chrome://tracing, ui.perfetto.dev) and as one
+// CSV line (per item start / duration).
+//
+//------------------------------------------------------------------------------
+static long long time_us (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+trace_t *trace_init (unsigned int count, int run, int done)
+{
+    trace_t *t;
+
+    // power of 2
+    if ((count < 2) || (count & (count - 1)))
+        return NULL;
+
+    if ((t = (trace_t *)calloc (1, sizeof(trace_t))) == NULL)
+        return NULL;
+
+    t->seq = (atomic_uint *)calloc (count, sizeof(atomic_uint));
+    t->rec = (struct trace_rec *)calloc (count, sizeof(struct trace_rec));
+    if ((t->seq == NULL) || (t->rec == NULL)) {
+        trace_close (t);
+        return NULL;
+    }
+    t->count    = count;
+    t->mask     = count - 1;
+    t->run      = run;
+    t->done     = done;
+    t->start_us = time_us ();
+    atomic_init (&t->head, 0);
+    atomic_init (&t->dropped, 0);
+
+    return t;
+}
+
+//------------------------------------------------------------------------------
+// names[id] : item name in the exports (kept by the caller)
+//------------------------------------------------------------------------------
+void trace_set_names (trace_t *t, const char * const *names, int cnt)
+{
+    t->names    = names;
+    t->name_cnt = cnt;
+}
+
+//------------------------------------------------------------------------------
+// any thread
+//------------------------------------------------------------------------------
+void trace_put (trace_t *t, int id, int from, int to, int result)
+{
+    unsigned int pos = atomic_fetch_add_explicit (&t->head, 1, memory_order_relaxed);
+    atomic_uint *seq = &t->seq[pos & t->mask];
+    struct trace_rec *r = &t->rec[pos & t->mask];
+    unsigned int cur = atomic_load_explicit (seq, memory_order_relaxed);
+
+    // slot still written by a writer one lap behind : drop the record
+    if ((cur == TRACE_SEQ_BUSY) ||
+        !atomic_compare_exchange_strong_explicit (seq, &cur, TRACE_SEQ_BUSY,
+                                memory_order_acquire, memory_order_relaxed)) {
+        atomic_fetch_add_explicit (&t->dropped, 1, memory_order_relaxed);
+        return;
+    }
+    r->ts_us  = time_us ();
+    r->id     = id;
+    r->from   = (unsigned char)from;
+    r->to     = (unsigned char)to;
+    r->result = (unsigned char)result;
+    atomic_store_explicit (seq, pos + 1, memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+// published records, oldest first. return the record count
+//------------------------------------------------------------------------------
+int trace_read (trace_t *t, struct trace_rec *rec, int max)
+{
+    unsigned int head = atomic_load_explicit (&t->head, memory_order_acquire);
+    unsigned int pos  = (head > t->count) ? head - t->count : 0;
+    int cnt = 0;
+
+    for (; (pos != head) && (cnt < max); pos++) {
+        atomic_uint *seq = &t->seq[pos & t->mask];
+
+        if (atomic_load_explicit (seq, memory_order_acquire) != pos + 1)
+            continue;
+        rec[cnt] = t->rec[pos & t->mask];
+        // overwritten while copied
+        if (atomic_load_explicit (seq, memory_order_acquire) == pos + 1)
+            cnt++;
+    }
+    return cnt;
+}
+
+//------------------------------------------------------------------------------
+static const char *trace_name (trace_t *t, int id, char *buf, int size)
+{
+    if ((id >= 0) && (id < t->name_cnt) && t->names[id])
+        return t->names[id];
+    snprintf (buf, size, "item%d", id);
+    return buf;
+}
+
+//------------------------------------------------------------------------------
+static struct trace_rec *trace_snapshot (trace_t *t, int *cnt)
+{
+    struct trace_rec *rec;
+
+    if ((rec = (struct trace_rec *)malloc (t->count * sizeof(struct trace_rec))) != NULL)
+        *cnt = trace_read (t, rec, t->count);
+    return rec;
+}
+
+//------------------------------------------------------------------------------
+// One row per item (tid = id). run -> done spans are complete events,
+// other transitions instant events. return 1 = written
+//------------------------------------------------------------------------------
+int trace_export_json (trace_t *t, const char *path)
+{
+    struct trace_rec *rec;
+    long long *run_ts, now = time_us ();
+    int cnt = 0, i, ids = 0, first = 1;
+    char name[32];
+    FILE *fp;
+
+    if ((rec = trace_snapshot (t, &cnt)) == NULL)
+        return 0;
+    for (i = 0; i < cnt; i++)
+        if (rec[i].id >= ids)
+            ids = rec[i].id + 1;
+
+    if (((run_ts = (long long *)calloc (ids + 1, sizeof(long long))) == NULL) ||
+        ((fp = fopen (path, "w")) == NULL)) {
+        free (run_ts);  free (rec);
+        return 0;
+    }
+
+    fprintf (fp, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    for (i = 0; i < ids; i++) {
+        fprintf (fp, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                     "\"args\":{\"name\":\"%s\"}}", first ? "" : ",", i,
+                     trace_name (t, i, name, sizeof(name)));
+        first = 0;
+        run_ts[i] = -1;
+    }
+    for (i = 0; i < cnt; i++) {
+        struct trace_rec *r = &rec[i];
+        const char *n = trace_name (t, r->id, name, sizeof(name));
+
+        if (r->to == t->run) {
+            run_ts[r->id] = r->ts_us;
+            continue;
+        }
+        if ((r->to == t->done) && (run_ts[r->id] >= 0)) {
+            fprintf (fp, ",\n{\"name\":\"%s\",\"cat\":\"item\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                         "\"ts\":%lld,\"dur\":%lld,\"args\":{\"result\":%d}}",
+                         n, r->id, run_ts[r->id] - t->start_us,
+                         r->ts_us - run_ts[r->id], r->result);
+            run_ts[r->id] = -1;
+            continue;
+        }
+        fprintf (fp, ",\n{\"name\":\"%s %d>%d\",\"cat\":\"item\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,"
+                     "\"tid\":%d,\"ts\":%lld,\"args\":{\"result\":%d}}",
+                     n, r->from, r->to, r->id, r->ts_us - t->start_us, r->result);
+    }
+    // still running at export
+    for (i = 0; i < ids; i++) {
+        if (run_ts[i] < 0)
+            continue;
+        fprintf (fp, ",\n{\"name\":\"%s\",\"cat\":\"item\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                     "\"ts\":%lld,\"dur\":%lld,\"args\":{\"unfinished\":1}}",
+                     trace_name (t, i, name, sizeof(name)), i,
+                     run_ts[i] - t->start_us, now - run_ts[i]);
+    }
+    fprintf (fp, "\n]}\n");
+    fclose (fp);
+
+    free (run_ts);  free (rec);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// "total_ms,name:start_ms:dur_ms:result,..." (last run -> done span per item)
+// return the string length
+//------------------------------------------------------------------------------
+int trace_export_csv (trace_t *t, char *buf, int size)
+{
+    struct trace_rec *rec;
+    long long last = t->start_us;
+    int cnt = 0, i, j, len;
+    char name[32];
+
+    if ((rec = trace_snapshot (t, &cnt)) == NULL)
+        return 0;
+    for (i = 0; i < cnt; i++)
+        if (rec[i].ts_us > last)
+            last = rec[i].ts_us;
+
+    len = snprintf (buf, size, "%lld", (last - t->start_us) / 1000);
+    for (i = 0; (i < cnt) && (len < size); i++) {
+        if (rec[i].to != t->done)
+            continue;
+        // newer span of the same item follows
+        for (j = i + 1; j < cnt; j++)
+            if ((rec[j].id == rec[i].id) && (rec[j].to == t->done))
+                break;
+        if (j < cnt)
+            continue;
+        // matching start
+        for (j = i - 1; j >= 0; j--)
+            if ((rec[j].id == rec[i].id) && (rec[j].to == t->run))
+                break;
+        if (j < 0)
+            continue;
+        len += snprintf (&buf[len], size - len, ",%s:%lld:%lld:%d",
+                         trace_name (t, rec[i].id, name, sizeof(name)),
+                         (rec[j].ts_us - t->start_us) / 1000,
+                         (rec[i].ts_us - rec[j].ts_us) / 1000, rec[i].result);
+    }
+    free (rec);
+    return (len < size) ? len : size - 1;
+}
+
+//------------------------------------------------------------------------------
+void trace_close (trace_t *t)
+{
+    if (t == NULL)
+        return;
+    free (t->seq);
+    free (t->rec);
+    free (t);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
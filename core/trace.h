@@ -0,0 +1,64 @@
+//------------------------------------------------------------------------------
+/**
+ * @file trace.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+//------------------------------------------------------------------------------
+#include <stdatomic.h>
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// records kept per run (power of 2, the oldest are overwritten)
+#define TRACE_DEPTH_DEF     1024
+
+// record slot being written
+#define TRACE_SEQ_BUSY      0xFFFFFFFFu
+
+// one status transition of an item
+struct trace_rec {
+    // CLOCK_MONOTONIC usec
+    long long       ts_us;
+    int             id;
+    unsigned char   from, to, result, reserved;
+};
+
+typedef struct trace__t {
+    unsigned int        count, mask;
+    atomic_uint         head, dropped;
+    // record sequence (pos + 1 = written)
+    atomic_uint         *seq;
+    struct trace_rec    *rec;
+    long long           start_us;
+    // span status (run -> done), item names
+    int                 run, done, name_cnt;
+    const char * const  *names;
+}   trace_t;
+
+//------------------------------------------------------------------------------
+// function prototype
+//------------------------------------------------------------------------------
+extern trace_t  *trace_init         (unsigned int count, int run, int done);
+extern void     trace_set_names     (trace_t *t, const char * const *names, int cnt);
+extern void     trace_put           (trace_t *t, int id, int from, int to, int result);
+extern int      trace_read          (trace_t *t, struct trace_rec *rec, int max);
+extern int      trace_export_json   (trace_t *t, const char *path);
+extern int      trace_export_csv    (trace_t *t, char *buf, int size);
+extern void     trace_close         (trace_t *t);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#endif  // #define __TRACE_H__
+//------------------------------------------------------------------------------
@@ -0,0 +1,162 @@
+//------------------------------------------------------------------------------
+/**
+ * @file uevent.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+
+//------------------------------------------------------------------------------
+#include "uevent.h"
+
+//------------------------------------------------------------------------------
+//
+// Kernel uevent (NETLINK_KOBJECT_UEVENT) listener.
+// Message : "add@/devices/...\0ACTION=add\0DEVPATH=...\0SUBSYSTEM=block\0..."
+//
+//------------------------------------------------------------------------------
+// kernel multicast group (udev rebroadcast group is 2)
+#define UEVENT_GROUP_KERNEL 1
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+static void uevent_copy (char *dst, int size, const char *src)
+{
+    strncpy (dst, src, size - 1);
+    dst[size - 1] = 0;
+}
+
+//------------------------------------------------------------------------------
+// "KEY=VALUE" property
+//------------------------------------------------------------------------------
+static void uevent_property (const char *prop, struct uevent *ev)
+{
+    if      (!strncmp (prop, "ACTION=",    7))  uevent_copy (ev->action,    sizeof(ev->action),    prop + 7);
+    else if (!strncmp (prop, "DEVPATH=",   8))  uevent_copy (ev->devpath,   sizeof(ev->devpath),   prop + 8);
+    else if (!strncmp (prop, "SUBSYSTEM=", 10)) uevent_copy (ev->subsystem, sizeof(ev->subsystem), prop + 10);
+    else if (!strncmp (prop, "DEVTYPE=",   8))  uevent_copy (ev->devtype,   sizeof(ev->devtype),   prop + 8);
+    else if (!strncmp (prop, "DEVNAME=",   8))  uevent_copy (ev->devname,   sizeof(ev->devname),   prop + 8);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// return socket fd, -1 = error (use the polling fallback)
+//------------------------------------------------------------------------------
+int uevent_open (void)
+{
+    struct sockaddr_nl addr;
+    int fd;
+
+    if ((fd = socket (AF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                      NETLINK_KOBJECT_UEVENT)) < 0)
+        return -1;
+
+    memset (&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+    addr.nl_pid    = 0;
+    addr.nl_groups = UEVENT_GROUP_KERNEL;
+
+    if (bind (fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        printf ("%s : netlink bind error (%s)\n", __func__, strerror (errno));
+        close (fd);
+        return -1;
+    }
+    return fd;
+}
+
+//------------------------------------------------------------------------------
+// NUL separated properties. return 1 = valid event
+//------------------------------------------------------------------------------
+int uevent_parse (const char *buf, int len, struct uevent *ev)
+{
+    int pos = 0, slen;
+
+    memset (ev, 0, sizeof(struct uevent));
+
+    // skip the udev (libudev) messages
+    if ((len > 7) && !strncmp (buf, "libudev", 7))
+        return 0;
+
+    while (pos < len) {
+        slen = strnlen (&buf[pos], len - pos);
+        uevent_property (&buf[pos], ev);
+        pos += slen + 1;
+    }
+    return (ev->action[0] && ev->devpath[0]) ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+// return 1 = event, 0 = none (EAGAIN or not a kernel event)
+//------------------------------------------------------------------------------
+int uevent_recv (int fd, struct uevent *ev)
+{
+    char buf[UEVENT_BUF_SIZE];
+    int len;
+
+    if ((len = recv (fd, buf, sizeof(buf) - 1, 0)) <= 0)
+        return 0;
+
+    buf[len] = 0;
+    return uevent_parse (buf, len, ev);
+}
+
+//------------------------------------------------------------------------------
+// Replay a recorded uevent stream.
+// Records are "KEY=VALUE" lines separated by an empty line, other lines are
+// ignored. ('udevadm monitor --kernel --property' output can be used as is.)
+// return the number of replayed events
+//------------------------------------------------------------------------------
+int uevent_replay (const char *fname, uevent_func_t func, void *arg)
+{
+    struct uevent ev;
+    char line[512];
+    int cnt = 0, prop = 0;
+    FILE *fp;
+
+    if ((fp = fopen (fname, "r")) == NULL)
+        return 0;
+
+    memset (&ev, 0, sizeof(ev));
+    while (1) {
+        if (fgets (line, sizeof(line), fp) != NULL) {
+            line[strcspn (line, "\r\n")] = 0;
+            if (line[0] && strchr (line, '=')) {
+                uevent_property (line, &ev);
+                prop = 1;
+                continue;
+            }
+            // end of record
+            if (line[0] || !prop)
+                continue;
+        } else if (!prop) {
+            break;
+        }
+        if (ev.action[0] && ev.devpath[0]) {
+            func (&ev, arg);
+            cnt++;
+        }
+        memset (&ev, 0, sizeof(ev));
+        prop = 0;
+    }
+    fclose (fp);
+    return cnt;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,50 @@
+//------------------------------------------------------------------------------
+/**
+ * @file uevent.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef __UEVENT_H__
+#define __UEVENT_H__
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#define UEVENT_BUF_SIZE     4096
+
+struct uevent {
+    // add, remove, change, bind ...
+    char action     [16];
+    // /devices/platform/... (without /sys)
+    char devpath    [256];
+    // block, usb, input ...
+    char subsystem  [32];
+    // disk, partition, usb_device ...
+    char devtype    [32];
+    // sda, mmcblk0 ... (without /dev)
+    char devname    [64];
+};
+
+// replay callback
+typedef void (*uevent_func_t) (const struct uevent *ev, void *arg);
+
+//------------------------------------------------------------------------------
+// function prototype
+//------------------------------------------------------------------------------
+extern int  uevent_open     (void);
+extern int  uevent_parse    (const char *buf, int len, struct uevent *ev);
+extern int  uevent_recv     (int fd, struct uevent *ev);
+extern int  uevent_replay   (const char *fname, uevent_func_t func, void *arg);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#endif  // #define __UEVENT_H__
+//------------------------------------------------------------------------------
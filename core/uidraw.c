@@ -0,0 +1,192 @@
+//------------------------------------------------------------------------------
+/**
+ * @file uidraw.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//------------------------------------------------------------------------------
+#include "uidraw.h"
+#include "glyph.h"
+
+//------------------------------------------------------------------------------
+//
+// UI items drawn from the compiled layout (m1.lyt mmap, replaces lib_ui).
+// The item geometry is used in place from the layout, only the colors and
+// the string of each item are kept here. set_ritem/sitem change the state,
+// uidraw_update renders the item (box, outline, string) into the fb,
+// the strings are drawn from the glyph cache.
+//
+//------------------------------------------------------------------------------
+// lib_fb font cell height (scale 1)
+#define FONT_H          16
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+static struct uid_item *uid_item (uidraw_t *ud, int id)
+{
+    if ((id < 0) || (id >= UID_ID_MAX) || (ud->item[id].ly == NULL))
+        return NULL;
+
+    return &ud->item[id];
+}
+
+//------------------------------------------------------------------------------
+static void uid_draw_item (fb_info_t *fb, const uidraw_t *ud, const struct uid_item *it)
+{
+    const struct layout_item *ly = it->ly;
+    int x, y, w, len, scale = ly->scale ? ly->scale : 1;
+    char str[LAYOUT_STR_MAX];
+
+    draw_fill_rect (fb, ly->x, ly->y, ly->w, ly->h, it->rc);
+    if (ly->lw)
+        draw_rect (fb, ly->x, ly->y, ly->w, ly->h, ly->lw, it->lc);
+
+    // the string stays in the box (a partial flush repaints the box only) :
+    // smaller scale for the height, the tail is cut for the width
+    while ((scale > 1) && (FONT_H * scale > ly->h))
+        scale--;
+    if (!it->str[0] || (FONT_H * scale > ly->h))
+        return;
+
+    strncpy (str, it->str, sizeof(str));
+    len = strlen (str);
+    while (len && ((w = glyph_text_width (fb, ud->font, it->fc, it->bc, scale, str)) > ly->w)) {
+        // drop the last UTF-8 character
+        while (len && ((str[--len] & 0xC0) == 0x80))
+            ;
+        str[len] = 0;
+    }
+    if (!len)
+        return;
+
+    switch (ly->align) {
+        case eUID_ALIGN_LEFT:   x = ly->x + ly->lw + scale;             break;
+        case eUID_ALIGN_RIGHT:  x = ly->x + ly->w - ly->lw - scale - w; break;
+        default:                x = ly->x + (ly->w - w) / 2;            break;
+    }
+    y = ly->y + (ly->h - FONT_H * scale) / 2;
+    if (x + w > ly->x + ly->w)  x = ly->x + ly->w - w;
+    if (x < ly->x)  x = ly->x;
+    if (y < ly->y)  y = ly->y;
+
+    glyph_draw_text (fb, ud->font, x, y, it->fc, it->bc, scale, "%s", str);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// Items of the layout with the default colors and strings (m1.cfg 'C', 'B').
+// The layout must stay mapped until uidraw_close.
+//------------------------------------------------------------------------------
+uidraw_t *uidraw_init (const layout_t *ly)
+{
+    const struct layout_item *item;
+    uidraw_t *ud;
+    int i;
+
+    if ((ly == NULL) || ((ud = (uidraw_t *)calloc (1, sizeof(uidraw_t))) == NULL))
+        return NULL;
+
+    ud->ly   = ly;
+    ud->font = ly->hdr->cfg.font;
+    ud->fc   = ly->hdr->cfg.fc;
+    ud->rc   = ly->hdr->cfg.rc;
+    ud->lc   = ly->hdr->cfg.lc;
+    set_font (ud->font);
+
+    for (i = 0; i < ly->cnt; i++) {
+        item = &ly->item[i];
+        if ((item->id < 0) || (item->id >= UID_ID_MAX))
+            continue;
+
+        ud->item[item->id].ly = item;
+        ud->item[item->id].rc = ud->rc;
+        ud->item[item->id].lc = ud->lc;
+        ud->item[item->id].fc = ud->fc;
+        ud->item[item->id].bc = UID_COLOR_NONE;
+        strncpy (ud->item[item->id].str, item->str, LAYOUT_STR_MAX -1);
+    }
+    return ud;
+}
+
+//------------------------------------------------------------------------------
+void uidraw_close (uidraw_t *ud)
+{
+    free (ud);
+}
+
+//------------------------------------------------------------------------------
+// box color, line color (-1 = keep). return 0 = unknown id
+//------------------------------------------------------------------------------
+int uidraw_set_ritem (uidraw_t *ud, int id, int bc, int lc)
+{
+    struct uid_item *it;
+
+    if ((it = uid_item (ud, id)) == NULL)
+        return 0;
+
+    if (bc != -1)   it->rc = (uint32_t)bc;
+    if (lc != -1)   it->lc = (uint32_t)lc;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// string color, background (-1 = keep), string. return 0 = unknown id
+//------------------------------------------------------------------------------
+int uidraw_set_sitem (uidraw_t *ud, int id, int fc, int bc, const char *str)
+{
+    struct uid_item *it;
+
+    if ((it = uid_item (ud, id)) == NULL)
+        return 0;
+
+    if (fc != -1)   it->fc = (uint32_t)fc;
+    if (bc != -1)   it->bc = (uint32_t)bc;
+    if (str) {
+        memset  (it->str, 0, sizeof(it->str));
+        strncpy (it->str, str, sizeof(it->str) -1);
+    }
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// render the item, id = -1 : clear and render every item.
+// return the rendered item count
+//------------------------------------------------------------------------------
+int uidraw_update (fb_info_t *fb, uidraw_t *ud, int id)
+{
+    struct uid_item *it;
+    int i, cnt = 0;
+
+    if (id != -1) {
+        if ((it = uid_item (ud, id)) == NULL)
+            return 0;
+        uid_draw_item (fb, ud, it);
+        return 1;
+    }
+
+    draw_fill_rect (fb, 0, 0, fb->w, fb->h, COLOR_BLACK);
+    // layout order (later items are drawn over the earlier ones)
+    for (i = 0; i < ud->ly->cnt; i++) {
+        if ((it = uid_item (ud, ud->ly->item[i].id)) != NULL) {
+            uid_draw_item (fb, ud, it);
+            cnt++;
+        }
+    }
+    return cnt;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
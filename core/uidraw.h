@@ -0,0 +1,68 @@
+//------------------------------------------------------------------------------
+/**
+ * @file uidraw.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef __UIDRAW_H__
+#define __UIDRAW_H__
+
+//------------------------------------------------------------------------------
+#include <stdint.h>
+#include "../lib_fbui/lib_fb.h"
+#include "layout.h"
+#include "glyph.h"
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// ui item id range (m1.cfg 'B' command id)
+#define UID_ID_MAX      LAYOUT_ITEM_MAX
+
+// string background : no fill (the box color shows through)
+#define UID_COLOR_NONE  GLYPH_COLOR_NONE
+
+// m1.cfg 'B' align
+enum {
+    eUID_ALIGN_CENTER = 0,
+    eUID_ALIGN_LEFT,
+    eUID_ALIGN_RIGHT,
+};
+
+struct uid_item {
+    // geometry, scale, align (NULL = no item of this id)
+    const struct layout_item    *ly;
+    // box, line, string, string background color
+    uint32_t    rc, lc, fc, bc;
+    char        str [LAYOUT_STR_MAX];
+};
+
+typedef struct uidraw__t {
+    const layout_t  *ly;
+    int             font;
+    // default string, box, line color (m1.cfg 'C' command)
+    uint32_t        fc, rc, lc;
+    struct uid_item item [UID_ID_MAX];
+}   uidraw_t;
+
+//------------------------------------------------------------------------------
+// function prototype
+//------------------------------------------------------------------------------
+extern uidraw_t *uidraw_init        (const layout_t *ly);
+extern void     uidraw_close        (uidraw_t *ud);
+extern int      uidraw_set_ritem    (uidraw_t *ud, int id, int bc, int lc);
+extern int      uidraw_set_sitem    (uidraw_t *ud, int id, int fc, int bc, const char *str);
+extern int      uidraw_update       (fb_info_t *fb, uidraw_t *ud, int id);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#endif  // #define __UIDRAW_H__
+//------------------------------------------------------------------------------
@@ -0,0 +1,444 @@
+//------------------------------------------------------------------------------
+/**
+ * @file uiflush.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <time.h>
+#include <sched.h>
+#include <poll.h>
+#include <pthread.h>
+#include <linux/fb.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/eventfd.h>
+
+//------------------------------------------------------------------------------
+#include "uiflush.h"
+#include "fbmem.h"
+#include "msgq.h"
+
+//------------------------------------------------------------------------------
+//
+// Off-screen ui renderer.
+// The back buffer and the ui item state (uidraw) are owned by one render thread.
+// uif_set_ritem/sitem only post an update message (lock-free queue) from any
+// thread, the render thread applies the updates, re-renders the dirty items
+// and presents the frame (damaged rect copy or page flip).
+//
+//------------------------------------------------------------------------------
+enum { eUIF_MSG_RITEM = 0, eUIF_MSG_SITEM, eUIF_MSG_MARK };
+
+struct uif_msg {
+    int     type, id;
+    int     fc, bc, lc;
+    char    str [UIF_STR_MAX];
+};
+
+struct uif_rect {
+    int x, y, w, h;
+};
+
+// display (fb0 or headless), render target
+static fb_info_t *Front = NULL, *Back = NULL;
+
+// render thread only
+static struct uif_rect  Rect  [UIF_ID_MAX];
+static unsigned char    Dirty [UIF_ID_MAX];
+static int              DirtyAll = 0;
+
+static msgq_t           *MsgQ = NULL;
+// render thread wake up (eventfd), 1 = wake up already signaled
+static int              WakeFd = -1, RenderStop = 0, Running = 0;
+static int              WakePending = 0;
+static pthread_t        RenderThread;
+
+// page flip : both pages mmap, visible page index
+static char             *PanBase = NULL;
+static int              PanSize = 0, PanPage = 0;
+static struct fb_var_screeninfo PanVar;
+
+static struct uif_stats Stats;
+static long long        StartUs = 0;
+
+// serialize the flush (back buffer render + present)
+static pthread_mutex_t  FlushLock = PTHREAD_MUTEX_INITIALIZER;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+static long long time_us (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+//------------------------------------------------------------------------------
+// item rects from the layout (pixels), 1 pixel margin for the line width rounding
+//------------------------------------------------------------------------------
+static int uif_load_rect (const layout_t *ly, int fb_w, int fb_h)
+{
+    const struct layout_item *item;
+    int i, id;
+
+    for (i = 0; i < ly->cnt; i++) {
+        item = &ly->item[i];
+        if (((id = item->id) < 0) || (id >= UIF_ID_MAX))
+            continue;
+
+        Rect[id].x = item->x - 1;
+        Rect[id].y = item->y - 1;
+        Rect[id].w = item->w + 2;
+        Rect[id].h = item->h + 2;
+
+        if (Rect[id].x < 0)     Rect[id].x = 0;
+        if (Rect[id].y < 0)     Rect[id].y = 0;
+        if (Rect[id].x + Rect[id].w > fb_w) Rect[id].w = fb_w - Rect[id].x;
+        if (Rect[id].y + Rect[id].h > fb_h) Rect[id].h = fb_h - Rect[id].y;
+    }
+    return ly->cnt;
+}
+
+//------------------------------------------------------------------------------
+// Page flip needs a second page (yres_virtual) and the same line stride.
+//------------------------------------------------------------------------------
+static int uif_pan_setup (void)
+{
+    if ((Front->fd < 0) || (Front->stride != Back->stride))
+        return 0;
+
+    if (ioctl (Front->fd, FBIOGET_VSCREENINFO, &PanVar) < 0)
+        return 0;
+
+    if ((PanVar.yres != (unsigned int)Front->h) || (PanVar.yres_virtual < PanVar.yres * 2))
+        return 0;
+
+    PanSize = Front->stride * Front->h;
+    PanBase = (char *)mmap (NULL, PanSize * 2, PROT_READ | PROT_WRITE, MAP_SHARED, Front->fd, 0);
+    if (PanBase == MAP_FAILED) {
+        PanBase = NULL;
+        return 0;
+    }
+    PanPage = PanVar.yoffset ? 1 : 0;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+static long long uif_copy_rect (const struct uif_rect *r)
+{
+    int bpp = Back->bpp / 8, y, len = r->w * bpp;
+    char *dst = Front->data + r->y * Front->stride + r->x * bpp;
+    char *src = Back->data  + r->y * Back->stride  + r->x * bpp;
+
+    for (y = 0; y < r->h; y++, dst += Front->stride, src += Back->stride)
+        memcpy (dst, src, len);
+
+    return (long long)len * r->h;
+}
+
+//------------------------------------------------------------------------------
+// single memcpy of the frame into the hidden page, then flip
+//------------------------------------------------------------------------------
+static long long uif_pan_present (void)
+{
+    int hidden = !PanPage;
+
+    memcpy (PanBase + hidden * PanSize, Back->data, PanSize);
+
+    PanVar.yoffset = hidden * PanVar.yres;
+    if (ioctl (Front->fd, FBIOPAN_DISPLAY, &PanVar) == 0)
+        PanPage = hidden;
+
+    return PanSize;
+}
+
+//------------------------------------------------------------------------------
+static void uif_mark_id (int id)
+{
+    // unknown geometry, repaint all
+    if ((id < 0) || (id >= UIF_ID_MAX) || !Rect[id].w)
+        DirtyAll = 1;
+    else
+        Dirty[id] = 1;
+}
+
+//------------------------------------------------------------------------------
+static void uif_post (const struct uif_msg *msg)
+{
+    uint64_t v = 1;
+
+    __atomic_fetch_add (&Stats.msg_cnt, 1, __ATOMIC_RELAXED);
+    // queue full : the render thread is behind, let it run
+    while (!msgq_put (MsgQ, msg)) {
+        __atomic_fetch_add (&Stats.msg_full, 1, __ATOMIC_RELAXED);
+        sched_yield ();
+    }
+    // wake up the render thread once per drain (eventfd counter, never blocks)
+    if ((WakeFd >= 0) && !__atomic_exchange_n (&WakePending, 1, __ATOMIC_SEQ_CST))
+        if (write (WakeFd, &v, sizeof(v)) != sizeof(v))
+            printf ("%s : render thread wake up error\n", __func__);
+}
+
+//------------------------------------------------------------------------------
+// apply the posted updates to the back buffer (FlushLock held)
+//------------------------------------------------------------------------------
+static int uif_apply (uidraw_t *ui)
+{
+    struct uif_msg msg;
+    int cnt = 0;
+
+    while (msgq_get (MsgQ, &msg)) {
+        cnt++;
+        switch (msg.type) {
+            case eUIF_MSG_RITEM:
+                uidraw_set_ritem (ui, msg.id, msg.bc, msg.lc);
+                break;
+            case eUIF_MSG_SITEM:
+                uidraw_set_sitem (ui, msg.id, msg.fc, msg.bc, msg.str);
+                break;
+            default :
+                break;
+        }
+        uif_mark_id (msg.id);
+    }
+    return cnt;
+}
+
+//------------------------------------------------------------------------------
+static void *uif_render_thread (void *arg)
+{
+    uidraw_t *ui = (uidraw_t *)arg;
+    struct pollfd pfd;
+    long long next = 0, now;
+    int pending = 0, timeout;
+    uint64_t v;
+
+    pfd.fd = WakeFd;    pfd.events = POLLIN;
+    while (!RenderStop) {
+        // idle : sleep until an update is posted. pending : until the next frame
+        now = time_us ();
+        timeout = pending ? (int)((next - now + 999) / 1000) : -1;
+        if (pending && (timeout < 0))
+            timeout = 0;
+
+        if ((poll (&pfd, 1, timeout) > 0) && (read (WakeFd, &v, sizeof(v)) > 0)) {
+            __atomic_store_n (&WakePending, 0, __ATOMIC_SEQ_CST);
+            // keep the queue drained, updates between frames are presented together
+            pthread_mutex_lock   (&FlushLock);
+            if (Back && uif_apply (ui))
+                pending = 1;
+            pthread_mutex_unlock (&FlushLock);
+        }
+        if (pending && (time_us () >= next)) {
+            uif_flush (ui);
+            next    = time_us () + UIF_FRAME_MS * 1000;
+            pending = 0;
+        }
+    }
+    return arg;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// Return the back buffer (render target of the ui items).
+//------------------------------------------------------------------------------
+fb_info_t *uif_init (fb_info_t *front, const layout_t *ly)
+{
+    if ((front == NULL) || (ly == NULL) || ((Back = fb_mem_clone (front)) == NULL))
+        return NULL;
+
+    if ((MsgQ = msgq_init (UIF_MSG_MAX, sizeof(struct uif_msg))) == NULL) {
+        fb_mem_close (Back);
+        return (Back = NULL);
+    }
+    Front = front;
+    memset (Rect,   0, sizeof(Rect));
+    memset (Dirty,  0, sizeof(Dirty));
+    memset (&Stats, 0, sizeof(Stats));
+    DirtyAll = 1;
+
+    Stats.present = uif_pan_setup () ? eUIF_PRESENT_PAN : eUIF_PRESENT_COPY;
+
+    printf ("%s : %d ui rects (%s), present = %s\n", __func__,
+            uif_load_rect (ly, front->w, front->h), ly->mapped ? "blob" : "text",
+            Stats.present == eUIF_PRESENT_PAN ? "page flip" : "rect copy");
+    return Back;
+}
+
+//------------------------------------------------------------------------------
+// Start the render thread (after uidraw_init), return 1 = success.
+// Without the render thread uif_flush() must be called to present.
+//------------------------------------------------------------------------------
+int uif_start (uidraw_t *ui)
+{
+    if ((Back == NULL) || Running)
+        return 0;
+
+    if ((WakeFd = eventfd (0, EFD_CLOEXEC)) < 0)
+        return 0;
+
+    RenderStop = 0;
+    StartUs    = time_us ();
+    if (pthread_create (&RenderThread, NULL, uif_render_thread, ui)) {
+        close (WakeFd);
+        WakeFd = -1;
+        return 0;
+    }
+    Running = 1;
+    // first frame
+    uif_mark (-1);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// Stop the renderer, return the display fb (direct drawing after close).
+//------------------------------------------------------------------------------
+fb_info_t *uif_close (void)
+{
+    fb_info_t *front = Front;
+    uint64_t v = 1;
+
+    if (Running) {
+        RenderStop = 1;
+        if (write (WakeFd, &v, sizeof(v)) != sizeof(v))
+            pthread_cancel (RenderThread);
+        pthread_join (RenderThread, NULL);
+        close (WakeFd);
+        WakeFd  = -1;
+        Running = 0;
+    }
+    pthread_mutex_lock   (&FlushLock);
+    if (PanBase)
+        munmap (PanBase, PanSize * 2);
+    PanBase = NULL;
+    fb_mem_close (Back);
+    msgq_close   (MsgQ);
+    Back = Front = NULL;
+    MsgQ = NULL;
+    pthread_mutex_unlock (&FlushLock);
+    return front;
+}
+
+//------------------------------------------------------------------------------
+// id = -1 : full repaint
+//------------------------------------------------------------------------------
+void uif_mark (int id)
+{
+    struct uif_msg msg;
+
+    memset (&msg, 0, sizeof(msg));
+    msg.type = eUIF_MSG_MARK;   msg.id = id;
+    uif_post (&msg);
+}
+
+//------------------------------------------------------------------------------
+// fb, ui : kept for the lib_ui call signature, the render thread owns them.
+//------------------------------------------------------------------------------
+int uif_set_ritem (fb_info_t *fb, uidraw_t *ui, int id, int bc, int lc)
+{
+    struct uif_msg msg;
+
+    (void)fb;   (void)ui;
+    memset (&msg, 0, sizeof(msg));
+    msg.type = eUIF_MSG_RITEM;  msg.id = id;
+    msg.bc   = bc;              msg.lc = lc;
+    uif_post (&msg);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+int uif_set_sitem (fb_info_t *fb, uidraw_t *ui, int id, int fc, int bc, char *str)
+{
+    struct uif_msg msg;
+
+    (void)fb;   (void)ui;
+    memset (&msg, 0, sizeof(msg));
+    msg.type = eUIF_MSG_SITEM;  msg.id = id;
+    msg.fc   = fc;              msg.bc = bc;
+    strncpy (msg.str, str, sizeof(msg.str) -1);
+    uif_post (&msg);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// Apply the updates, render the dirty items and present, return the rect count.
+//------------------------------------------------------------------------------
+int uif_flush (uidraw_t *ui)
+{
+    struct uif_rect full;
+    long long t = time_us (), bytes = 0;
+    int id, cnt = 0;
+
+    pthread_mutex_lock (&FlushLock);
+    if (Back == NULL) {
+        pthread_mutex_unlock (&FlushLock);
+        return 0;
+    }
+    uif_apply (ui);
+
+    if (DirtyAll) {
+        uidraw_update (Back, ui, -1);
+        cnt = 1;
+    } else {
+        for (id = 0; id < UIF_ID_MAX; id++) {
+            if (Dirty[id]) {
+                uidraw_update (Back, ui, id);
+                cnt++;
+            }
+        }
+    }
+    if (cnt) {
+        if (PanBase)
+            bytes = uif_pan_present ();
+        else if (DirtyAll) {
+            full.x = 0;         full.y = 0;
+            full.w = Back->w;   full.h = Back->h;
+            bytes = uif_copy_rect (&full);
+        } else {
+            for (id = 0; id < UIF_ID_MAX; id++)
+                if (Dirty[id])
+                    bytes += uif_copy_rect (&Rect[id]);
+        }
+        Stats.flush_cnt++;
+        Stats.rect_cnt += cnt;
+        Stats.bytes    += bytes;
+        Stats.last_us   = (int)(time_us () - t);
+        if (Stats.last_us > Stats.max_us)
+            Stats.max_us = Stats.last_us;
+    }
+    memset (Dirty, 0, sizeof(Dirty));
+    DirtyAll = 0;
+    pthread_mutex_unlock (&FlushLock);
+    return cnt;
+}
+
+//------------------------------------------------------------------------------
+void uif_get_stats (struct uif_stats *st)
+{
+    long long elapsed = time_us () - StartUs;
+
+    pthread_mutex_lock   (&FlushLock);
+    memcpy (st, &Stats, sizeof(struct uif_stats));
+    st->msg_cnt  = __atomic_load_n (&Stats.msg_cnt,  __ATOMIC_RELAXED);
+    st->msg_full = __atomic_load_n (&Stats.msg_full, __ATOMIC_RELAXED);
+    st->fps = (Running && (elapsed > 0)) ? (int)(((long long)Stats.flush_cnt * 1000000) / elapsed) : 0;
+    pthread_mutex_unlock (&FlushLock);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
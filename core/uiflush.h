@@ -0,0 +1,70 @@
+//------------------------------------------------------------------------------
+/**
+ * @file uiflush.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Core library for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#ifndef __UIFLUSH_H__
+#define __UIFLUSH_H__
+
+//------------------------------------------------------------------------------
+#include "../lib_fbui/lib_fb.h"
+#include "layout.h"
+#include "uidraw.h"
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// ui item id range (m1.cfg 'B' command id)
+#define UIF_ID_MAX      UID_ID_MAX
+
+// update message queue size (power of 2), uif_set_sitem string size
+#define UIF_MSG_MAX     256
+#define UIF_STR_MAX     64
+
+// min frame period (ms), updates in this time are presented together
+#define UIF_FRAME_MS    20
+
+enum {
+    // copy the damaged rects into the visible framebuffer
+    eUIF_PRESENT_COPY = 0,
+    // copy the frame into the hidden page and FBIOPAN_DISPLAY (yres_virtual >= 2 x yres)
+    eUIF_PRESENT_PAN,
+};
+
+struct uif_stats {
+    // present mode, flush count, damaged rects / bytes copied to the display
+    int             present;
+    unsigned int    flush_cnt, rect_cnt;
+    long long       bytes;
+    // last / max flush time (usec, render + copy)
+    int             last_us, max_us;
+    // update messages (posted, queue full retry), frames per second since uif_start
+    unsigned int    msg_cnt, msg_full;
+    int             fps;
+};
+
+//------------------------------------------------------------------------------
+// function prototype
+//------------------------------------------------------------------------------
+extern fb_info_t *uif_init      (fb_info_t *front, const layout_t *ly);
+extern int        uif_start     (uidraw_t *ui);
+extern fb_info_t *uif_close     (void);
+extern void       uif_mark      (int id);
+extern int        uif_set_ritem (fb_info_t *fb, uidraw_t *ui, int id, int bc, int lc);
+extern int        uif_set_sitem (fb_info_t *fb, uidraw_t *ui, int id, int fc, int bc, char *str);
+extern int        uif_flush     (uidraw_t *ui);
+extern void       uif_get_stats (struct uif_stats *st);
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#endif  // #define __UIFLUSH_H__
+//------------------------------------------------------------------------------
@@ -21,6 +21,7 @@
 #include <pthread.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <signal.h>
 #include <string.h>
@@ -41,7 +42,6 @@
 #include "lib_mac/lib_mac.h"
 #include "lib_efuse/lib_efuse.h"
 #include "lib_gpio/lib_gpio.h"
-#include "lib_i2cadc/lib_i2cadc.h"
 
 #include "check_device/adc.h"
 #include "check_device/hdmi.h"
@@ -52,6 +52,22 @@
 #include "check_device/led.h"
 #include "check_device/header.h"
 #include "check_device/audio.h"
+#include "check_device/blkpool.h"
+#include "check_device/adcboard.h"
+#include "check_device/netperf.h"
+#include "check_device/discover.h"
+
+#include "core/sched.h"
+#include "core/reactor.h"
+#include "core/hotplug.h"
+#include "core/fbmem.h"
+#include "core/uiflush.h"
+#include "core/layout.h"
+#include "core/uidraw.h"
+#include "core/itemstate.h"
+#include "core/evq.h"
+#include "core/trace.h"
+#include "core/outbox.h"
 
 //------------------------------------------------------------------------------
 //
@@ -60,15 +76,33 @@
 //
 //------------------------------------------------------------------------------
 #define DEVICE_FB   "/dev/fb0"
+// headless ui (no /dev/fb0)
+#define HEADLESS_FB_W   1920
+#define HEADLESS_FB_H   1080
+#define HEADLESS_FB_BPP 32
 #define CONFIG_UI   "m1.cfg"
+// compiled m1.cfg (make layout), CONFIG_UI is parsed when missing or stale
+#define CONFIG_LAYOUT   "m1.lyt"
 
 #define ALIVE_DISPLAY_UI_ID     0
 #define ALIVE_DISPLAY_INTERVAL  1000
 
 #define APP_LOOP_DELAY  500
 
+// storage/usb retry period without a hotplug event (polling fallback)
+#define HOTPLUG_RETRY_MS    2000
+
+// hotplug device bits : usb read id 0 ~ 15, storage read id 16 ~ 31
+#define HOTPLUG_USB(id)         HOTPLUG_DEV(id)
+#define HOTPLUG_STORAGE(id)     HOTPLUG_DEV(16 + (id))
+#define HOTPLUG_USB_ALL         0x0000FFFFu
+#define HOTPLUG_STORAGE_ALL     0xFFFF0000u
+
 #define TIMEOUT_SEC     60
 
+// item status transitions of the run (chrome://tracing, ui.perfetto.dev)
+#define TRACE_EXPORT    "/tmp/m1-trace.json"
+
 #define IP_ADDR_SIZE    20
 
 #define TEST_MODEL_NONE 0
@@ -76,13 +110,15 @@
 #define TEST_MODEL_8GB  8
 
 //------------------------------------------------------------------------------
-static int TimeoutStop = TIMEOUT_SEC;
+// count down (check_status), 0 = stop. read by every test thread.
+static atomic_int TimeoutStop = TIMEOUT_SEC;
 
 //------------------------------------------------------------------------------
 typedef struct client__t {
     // HDMI UI
     fb_info_t   *pfb;
-    ui_grp_t    *pui;
+    uidraw_t    *pui;
+    layout_t    *layout;
 
     int adc_fd;
     int channel;
@@ -90,6 +126,15 @@ typedef struct client__t {
     int board_mem;
     int eth_switch;     // 0 : stop, 1 : running
 
+    // test graph, event loop
+    sched_t     *sched;
+    reactor_t   *reactor;
+    // IR key events (reactor thread -> handler threads, main)
+    evq_t       *evq;
+    int         evq_main;
+    // server messages, held until the server is found
+    outbox_t    *outbox;
+
     char nlp_ip     [IP_ADDR_SIZE];
     char efuse_data [EFUSE_UUID_SIZE +1];
     char mac        [MAC_STR_SIZE +1];
@@ -211,7 +256,8 @@ enum {
 };
 
 struct check_item {
-    int id, ui_id, status, result;
+    // initial status / result (running state : M1State)
+    int id, ui_id, init_status, init_result;
     // item name for error
     const char *name;
 };
@@ -270,6 +316,17 @@ struct check_item m1_item [eITEM_END] = {
     { eITEM_HPDET_OUT,      eUI_HPDET_OUT,      eSTATUS_WAIT, eRESULT_FAIL, "hp-o" },
 };
 
+// m1_item status / result, shared by the test threads (lock-free)
+static itemstate_t *M1State = NULL;
+
+#define item_status(id)             itemstate_status (M1State, (id))
+#define item_result(id)             itemstate_result (M1State, (id))
+#define item_set(id, st, rs)        itemstate_set    (M1State, (id), (st), (rs))
+
+// status transition record (WAIT -> RUN -> STOP), exported at FINISH
+static trace_t *M1Trace = NULL;
+static const char *M1TraceName[eITEM_END];
+
 //------------------------------------------------------------------------------
 #define	RUN_BOX_ON	RGB_TO_UINT(204, 204, 0)
 #define	RUN_BOX_OFF	RGB_TO_UINT(153, 153, 0)
@@ -308,17 +365,17 @@ int errcode_print (client_t *p)
     memset (err_msg, 0, sizeof(err_msg));
 
     for (i = 0, line = 0; i < eITEM_END; i++) {
-        if (!m1_item[i].result) {
+        if (!item_result (i)) {
             if ((pos + strlen(m1_item[i].name) + 1) > PRINT_MAX_CHAR) {
                 pos = 0, line++;
             }
             pos += sprintf (&err_msg[line][pos], "%s,", m1_item[i].name);
-            ui_set_ritem (p->pfb, p->pui, m1_item [i].ui_id, COLOR_RED, -1);
+            uif_set_ritem (p->pfb, p->pui, m1_item [i].ui_id, COLOR_RED, -1);
         }
     }
     if (pos || line) {
         for (i = 0; i < line+1; i++) {
-            nlp_server_write (p->nlp_ip, NLP_SERVER_MSG_TYPE_ERR, &err_msg[i][0], 0);
+            outbox_post (p->outbox, NLP_SERVER_MSG_TYPE_ERR, &err_msg[i][0], 0);
             printf ("%s : msg = %s\n", __func__, &err_msg[i][0]);
         }
         return 1;
@@ -340,93 +397,96 @@ enum {
     eEVENT_END
 };
 
-static int EventIR = eEVENT_NONE;
+// queued IR key events per consumer
+#define EVENT_QUEUE_DEPTH   16
+
+#define DEVICE_IR   "/dev/input/event0"
+#define DEVICE_HP   "/dev/input/event2"
 
-void *check_device_ir (void *arg);
-void *check_device_ir (void *arg)
+//------------------------------------------------------------------------------
+static void ir_key_event (client_t *p, struct input_event *event)
 {
-    client_t *p = (client_t *)arg;
+    int ev = eEVENT_NONE;
+
+    switch (event->type) {
+        case    EV_SYN:
+            break;
+        case    EV_KEY:
+            uif_set_sitem (p->pfb, p->pui, m1_item[eITEM_IR].ui_id, -1, -1, "PASS");
+            uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_IR].ui_id, COLOR_GREEN, -1);
+            item_set (eITEM_IR, eSTATUS_STOP, eRESULT_PASS);
+
+            switch (event->code) {
+                /* emergency stop */
+                case    KEY_HOME:
+                    printf ("%s : EmergencyStop!!\n", __func__);
+                    ev = eEVENT_STOP;
+                    break;
+                case    KEY_VOLUMEDOWN:
+                    ev = eEVENT_ETH_GLED;
+                    break;
+                case    KEY_VOLUMEUP:
+                    ev = eEVENT_ETH_OLED;
+                    break;
+                case    KEY_MENU:
+                    ev = eEVENT_MAC_PRINT;
+                    break;
+                case    KEY_LEFT:
+                    ev = eEVENT_HP_L;
+                    break;
+                case    KEY_RIGHT:
+                    ev = eEVENT_HP_R;
+                    break;
+                case    KEY_ENTER:
+                    ev = eEVENT_ENTER;
+                    break;
+                case    KEY_BACK:
+                    ev = eEVENT_BACK;
+                    break;
+                default :
+                    ev = eEVENT_NONE;
+                    break;
+            }
+            if ((ev != eEVENT_NONE) && !evq_post (p->evq, ev, event->code))
+                printf ("%s : event %d dropped (queue full)\n", __func__, ev);
+            break;
+        default :
+            printf("unknown event\n");
+            break;
+    }
+}
 
+//------------------------------------------------------------------------------
+// reactor handler (IR evdev fd)
+//------------------------------------------------------------------------------
+static int check_device_ir (int fd, unsigned int events, void *arg)
+{
     struct input_event event;
-    struct timeval  timeout;
-    fd_set readFds;
-    static int fd = -1;
+
+    (void)events;
+    if (read (fd, &event, sizeof(struct input_event)) == sizeof(struct input_event))
+        ir_key_event ((client_t *)arg, &event);
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+static int check_device_ir_init (client_t *p, const char *dev)
+{
+    int fd;
 
     // IR Device Name
     // /sys/class/input/event0/device/name -> fdd70030.pwm
-    if ((fd = open("/dev/input/event0", O_RDONLY)) < 0) {
-        printf ("%s : /dev/input/event0 open error!\n", __func__);
-        return arg;
+    if ((fd = open(dev, O_RDONLY | O_NONBLOCK)) < 0) {
+        printf ("%s : %s open error!\n", __func__, dev);
+        return 0;
     }
     printf("%s fd = %d\n", __func__, fd);
 
-    m1_item[eITEM_IR].status = eSTATUS_RUN;
-    ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_IR].ui_id, RUN_BOX_ON, -1);
+    item_set (eITEM_IR, eSTATUS_RUN, ITEM_KEEP);
+    uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_IR].ui_id, RUN_BOX_ON, -1);
 
-    while (1) {
-        // recive time out config
-        // Set 1ms timeout counter
-        timeout.tv_sec  = 0;
-        // timeout.tv_usec = timeout_ms*1000;
-        timeout.tv_usec = 100000;
-
-        FD_ZERO(&readFds);
-        FD_SET(fd, &readFds);
-        select(fd+1, &readFds, NULL, NULL, &timeout);
-
-        if(FD_ISSET(fd, &readFds))
-        {
-            if(fd && read(fd, &event, sizeof(struct input_event))) {
-
-                switch (event.type) {
-                    case    EV_SYN:
-                        break;
-                    case    EV_KEY:
-                        ui_set_sitem (p->pfb, p->pui, m1_item[eITEM_IR].ui_id, -1, -1, "PASS");
-                        ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_IR].ui_id, COLOR_GREEN, -1);
-                        m1_item[eITEM_IR].result = eRESULT_PASS;
-                        m1_item[eITEM_IR].status = eSTATUS_STOP;
-
-                        switch (event.code) {
-                            /* emergency stop */
-                            case    KEY_HOME:
-                                printf ("%s : EmergencyStop!!\n", __func__);
-                                EventIR = eEVENT_STOP;
-                                break;
-                            case    KEY_VOLUMEDOWN:
-                                EventIR = eEVENT_ETH_GLED;
-                                break;
-                            case    KEY_VOLUMEUP:
-                                EventIR = eEVENT_ETH_OLED;
-                                break;
-                            case    KEY_MENU:
-                                EventIR = eEVENT_MAC_PRINT;
-                                break;
-                            case    KEY_LEFT:
-                                EventIR = eEVENT_HP_L;
-                                break;
-                            case    KEY_RIGHT:
-                                EventIR = eEVENT_HP_R;
-                                break;
-                            case    KEY_ENTER:
-                                EventIR = eEVENT_ENTER;
-                                break;
-                            case    KEY_BACK:
-                                EventIR = eEVENT_BACK;
-                                break;
-                            default :
-                                EventIR = eEVENT_NONE;
-                                break;
-                        }
-                        break;
-                    default :
-                        printf("unknown event\n");
-                        break;
-                }
-            }
-        }
-    }
-    return arg;
+    return (reactor_add_fd (p->reactor, fd, check_device_ir, p) < 0) ? 0 : 1;
 }
 
 //------------------------------------------------------------------------------
@@ -438,38 +498,30 @@ void *check_status (void *arg)
     client_t *p = (client_t *)arg;
 
     while (TimeoutStop) {
-        ui_set_ritem (p->pfb, p->pui, ALIVE_DISPLAY_UI_ID,
-                    onoff ? COLOR_GREEN : p->pui->bc.uint, -1);
+        uif_set_ritem (p->pfb, p->pui, ALIVE_DISPLAY_UI_ID,
+                    onoff ? COLOR_GREEN : p->pui->rc, -1);
         onoff = !onoff;
 
-        if (m1_item[eITEM_SERVER_IP].result && TimeoutStop) {
+        if (item_result (eITEM_SERVER_IP) && TimeoutStop) {
             memset (str, 0, sizeof(str));
             if (p->adc_fd != -1) {
-                ui_set_ritem (p->pfb, p->pui, eUI_STATUS, onoff ? RUN_BOX_ON : RUN_BOX_OFF, -1);
+                uif_set_ritem (p->pfb, p->pui, eUI_STATUS, onoff ? RUN_BOX_ON : RUN_BOX_OFF, -1);
                 sprintf (str, "RUNNING %d", TimeoutStop);
             } else {
-                ui_set_ritem (p->pfb, p->pui, eUI_STATUS, onoff ? COLOR_RED : p->pui->bc.uint, -1);
+                uif_set_ritem (p->pfb, p->pui, eUI_STATUS, onoff ? COLOR_RED : p->pui->rc, -1);
                 sprintf (str, "I2CADC %d", TimeoutStop);
             }
-            ui_set_sitem (p->pfb, p->pui, eUI_STATUS, -1, -1, str);
-        }
-        if (onoff) {
-            ui_update (p->pfb, p->pui, -1);
-            if (TimeoutStop && (p->adc_fd != -1))   TimeoutStop--;
+            uif_set_sitem (p->pfb, p->pui, eUI_STATUS, -1, -1, str);
         }
+        // eEVENT_STOP may clear it at the same time
+        if (onoff && (p->adc_fd != -1))
+            itemstate_countdown (&TimeoutStop);
 
         led_set_status (eLED_POWER, onoff);
         led_set_status (eLED_ALIVE, onoff);
-        usleep (APP_LOOP_DELAY * 1000);
-        {
-            int wait_item_cnt = 0, i;
-
-            for (i = 0; i < eITEM_END; i++) {
-                if (m1_item[i].status != eSTATUS_STOP) wait_item_cnt++;
-            }
-            if (!wait_item_cnt) {
-                TimeoutStop = 0;    break;
-            }
+        // wakes up as soon as the last item stops
+        if (itemstate_wait (M1State, APP_LOOP_DELAY)) {
+            TimeoutStop = 0;    break;
         }
     }
 
@@ -477,13 +529,22 @@ void *check_status (void *arg)
         int stop_cnt = 0, i;
 
         for (i = 0; i < eITEM_END; i++) {
-            if (m1_item[i].status == eSTATUS_STOP) stop_cnt++;
+            if (item_status (i) == eSTATUS_STOP) stop_cnt++;
             else
                 printf ("not STOP = %s\n", m1_item[i].name);
         }
         printf ("stop_cnt = %d,%d\n", eITEM_END, stop_cnt);
     }
 
+    if (M1Trace) {
+        char csv[2048];
+
+        if (trace_export_csv (M1Trace, csv, sizeof(csv)))
+            printf ("trace,%s\n", csv);
+        if (!trace_export_json (M1Trace, TRACE_EXPORT))
+            printf ("%s : %s export error\n", __func__, TRACE_EXPORT);
+    }
+
     // display stop
     memset (str, 0, sizeof(str));   sprintf (str, "%s", "FINISH");
 
@@ -495,11 +556,11 @@ void *check_status (void *arg)
     // wait for network stable
     usleep (APP_LOOP_DELAY * 1000);
 
-    if (m1_item [eITEM_MAC_ADDR].result)
-        nlp_server_write (p->nlp_ip, NLP_SERVER_MSG_TYPE_MAC, p->mac, p->channel);
-    ui_set_sitem (p->pfb, p->pui, eUI_STATUS, -1, -1, str);
+    if (item_result (eITEM_MAC_ADDR))
+        outbox_post (p->outbox, NLP_SERVER_MSG_TYPE_MAC, p->mac, p->channel);
+    uif_set_sitem (p->pfb, p->pui, eUI_STATUS, -1, -1, str);
     err = errcode_print (p);
-    ui_set_ritem (p->pfb, p->pui, eUI_STATUS, err ? COLOR_RED : COLOR_GREEN, -1);
+    uif_set_ritem (p->pfb, p->pui, eUI_STATUS, err ? COLOR_RED : COLOR_GREEN, -1);
 
     // ethernet switch enable
     p->eth_switch = 1;  usleep (APP_LOOP_DELAY * 1000);
@@ -512,10 +573,9 @@ void *check_status (void *arg)
         led_set_status (eLED_ALIVE, onoff);
 
         if (onoff)
-            ui_set_ritem (p->pfb, p->pui, eUI_STATUS, err ? COLOR_RED : COLOR_GREEN, -1);
+            uif_set_ritem (p->pfb, p->pui, eUI_STATUS, err ? COLOR_RED : COLOR_GREEN, -1);
         else
-            ui_set_ritem (p->pfb, p->pui, eUI_STATUS, p->pui->bc.uint, -1);
-        ui_update    (p->pfb, p->pui, -1);
+            uif_set_ritem (p->pfb, p->pui, eUI_STATUS, p->pui->rc, -1);
     }
     return arg;
 }
@@ -523,68 +583,64 @@ void *check_status (void *arg)
 //------------------------------------------------------------------------------
 static int JackStatus = 0;
 
-void *check_hp_detect (void *arg);
-void *check_hp_detect (void *arg)
+static void hp_jack_event (client_t *p, struct input_event *event)
+{
+    switch (event->type) {
+        case    EV_SYN:
+            break;
+        case    EV_SW:
+            switch (event->code) {
+                case    SW_HEADPHONE_INSERT:
+                    if (event->value) {
+                        uif_set_sitem (p->pfb, p->pui, m1_item[eITEM_HPDET_IN].ui_id, -1, -1, "PASS");
+                        uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_HPDET_IN].ui_id, COLOR_GREEN, -1);
+                        item_set (eITEM_HPDET_IN, eSTATUS_STOP, eRESULT_PASS);
+                        JackStatus = 1;
+                    } else {
+                        uif_set_sitem (p->pfb, p->pui, m1_item[eITEM_HPDET_OUT].ui_id, -1, -1, "PASS");
+                        uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_HPDET_OUT].ui_id, COLOR_GREEN, -1);
+                        item_set (eITEM_HPDET_OUT, eSTATUS_STOP, eRESULT_PASS);
+                        JackStatus = 0;
+                    }
+                    break;
+                default :
+                    break;
+            }
+            break;
+        default :
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+// reactor handler (headphone jack evdev fd)
+//------------------------------------------------------------------------------
+static int check_hp_detect (int fd, unsigned int events, void *arg)
 {
-    client_t *p = (client_t *)arg;
     struct input_event event;
-    struct timeval  timeout;
-    fd_set readFds;
-    int fd;
 
-    m1_item[eITEM_HPDET_IN].status = m1_item[eITEM_HPDET_OUT].status = eSTATUS_RUN;
-    ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_HPDET_IN].ui_id,  RUN_BOX_ON, -1);
-    ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_HPDET_OUT].ui_id, RUN_BOX_ON, -1);
+    (void)events;
+    if (read (fd, &event, sizeof(struct input_event)) == sizeof(struct input_event))
+        hp_jack_event ((client_t *)arg, &event);
 
-    if ((fd = open("/dev/input/event2", O_RDONLY)) < 0) {
-        printf ("%s : /dev/input/event2 open error!\n", __func__);
-        return arg;
-    }
+    return 0;
+}
 
-    while (1) {
-        // recive time out config
-        // Set 1ms timeout counter
-        timeout.tv_sec  = 0;
-        // timeout.tv_usec = timeout_ms*1000;
-        timeout.tv_usec = 100000;
-
-        FD_ZERO(&readFds);
-        FD_SET(fd, &readFds);
-        select(fd+1, &readFds, NULL, NULL, &timeout);
-
-        if(FD_ISSET(fd, &readFds)) {
-            if(fd && read(fd, &event, sizeof(struct input_event))) {
-                switch (event.type) {
-                    case    EV_SYN:
-                        break;
-                    case    EV_SW:
-                        switch (event.code) {
-                            case    SW_HEADPHONE_INSERT:
-                                if (event.value) {
-                                    ui_set_sitem (p->pfb, p->pui, m1_item[eITEM_HPDET_IN].ui_id, -1, -1, "PASS");
-                                    ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_HPDET_IN].ui_id, COLOR_GREEN, -1);
-                                    m1_item[eITEM_HPDET_IN].status = eSTATUS_STOP;
-                                    m1_item[eITEM_HPDET_IN].result = eRESULT_PASS;
-                                    JackStatus = 1;
-                                } else {
-                                    ui_set_sitem (p->pfb, p->pui, m1_item[eITEM_HPDET_OUT].ui_id, -1, -1, "PASS");
-                                    ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_HPDET_OUT].ui_id, COLOR_GREEN, -1);
-                                    m1_item[eITEM_HPDET_OUT].status = eSTATUS_STOP;
-                                    m1_item[eITEM_HPDET_OUT].result = eRESULT_PASS;
-                                    JackStatus = 0;
-                                }
-                                break;
-                            default :
-                                break;
-                        }
-                        break;
-                    default :
-                        break;
-                }
-            }
-        }
+//------------------------------------------------------------------------------
+static int check_hp_detect_init (client_t *p, const char *dev)
+{
+    int fd;
+
+    item_set (eITEM_HPDET_IN,  eSTATUS_RUN, ITEM_KEEP);
+    item_set (eITEM_HPDET_OUT, eSTATUS_RUN, ITEM_KEEP);
+    uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_HPDET_IN].ui_id,  RUN_BOX_ON, -1);
+    uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_HPDET_OUT].ui_id, RUN_BOX_ON, -1);
+
+    if ((fd = open(dev, O_RDONLY | O_NONBLOCK)) < 0) {
+        printf ("%s : %s open error!\n", __func__, dev);
+        return 0;
     }
-    return arg;
+    return (reactor_add_fd (p->reactor, fd, check_hp_detect, p) < 0) ? 0 : 1;
 }
 
 //------------------------------------------------------------------------------
@@ -621,43 +677,56 @@ int get_efuse_mac (char *mac_str)
     return 0;
 }
 
-void *check_spibt (void *arg);
-void *check_spibt (void *arg)
+static char SpiBtStatus = 0;
+
+// reactor handler (APP_LOOP_DELAY timer)
+static int check_spibt (int fd, unsigned int events, void *arg)
 {
     client_t *p = (client_t *)arg;
-    char mac_str[20], status = get_efuse_mac(mac_str);
-
-    m1_item[eITEM_SPIBT_UP].status = eSTATUS_RUN;
-    m1_item[eITEM_SPIBT_DN].status = eSTATUS_RUN;
-    ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_SPIBT_UP].ui_id, RUN_BOX_ON, -1);
-    ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_SPIBT_DN].ui_id, RUN_BOX_ON, -1);
-    while (1) {
-        if (m1_item[eITEM_SPIBT_UP].result != eRESULT_PASS) {
-            if (status != get_efuse_mac(mac_str)) {
-                status = get_efuse_mac(mac_str);
-                ui_set_sitem (p->pfb, p->pui, m1_item[eITEM_SPIBT_UP].ui_id, -1, -1, "PASS");
-                ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_SPIBT_UP].ui_id, COLOR_GREEN, -1);
-                m1_item[eITEM_SPIBT_UP].result = eRESULT_PASS;
-                m1_item[eITEM_SPIBT_UP].status = eSTATUS_STOP;
-            }
+    char mac_str[20];
+
+    (void)fd;   (void)events;
+    if (item_result (eITEM_SPIBT_UP) != eRESULT_PASS) {
+        if (SpiBtStatus != get_efuse_mac(mac_str)) {
+            SpiBtStatus = get_efuse_mac(mac_str);
+            uif_set_sitem (p->pfb, p->pui, m1_item[eITEM_SPIBT_UP].ui_id, -1, -1, "PASS");
+            uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_SPIBT_UP].ui_id, COLOR_GREEN, -1);
+            item_set (eITEM_SPIBT_UP, eSTATUS_STOP, eRESULT_PASS);
         }
-        if (m1_item[eITEM_SPIBT_DN].result != eRESULT_PASS) {
-            if (status != get_efuse_mac(mac_str)) {
-                status = get_efuse_mac(mac_str);
-                ui_set_sitem (p->pfb, p->pui, m1_item[eITEM_SPIBT_DN].ui_id, -1, -1, "PASS");
-                ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_SPIBT_DN].ui_id, COLOR_GREEN, -1);
-                m1_item[eITEM_SPIBT_DN].result = eRESULT_PASS;
-                m1_item[eITEM_SPIBT_DN].status = eSTATUS_STOP;
-            }
+    }
+    if (item_result (eITEM_SPIBT_DN) != eRESULT_PASS) {
+        if (SpiBtStatus != get_efuse_mac(mac_str)) {
+            SpiBtStatus = get_efuse_mac(mac_str);
+            uif_set_sitem (p->pfb, p->pui, m1_item[eITEM_SPIBT_DN].ui_id, -1, -1, "PASS");
+            uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_SPIBT_DN].ui_id, COLOR_GREEN, -1);
+            item_set (eITEM_SPIBT_DN, eSTATUS_STOP, eRESULT_PASS);
         }
-        usleep (APP_LOOP_DELAY * 1000);
     }
-    return arg;
+    // both done : remove the timer
+    if (item_result (eITEM_SPIBT_UP) && item_result (eITEM_SPIBT_DN))
+        return -1;
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+static int check_spibt_init (client_t *p)
+{
+    char mac_str[20];
+
+    SpiBtStatus = get_efuse_mac(mac_str);
+
+    item_set (eITEM_SPIBT_UP, eSTATUS_RUN, ITEM_KEEP);
+    item_set (eITEM_SPIBT_DN, eSTATUS_RUN, ITEM_KEEP);
+    uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_SPIBT_UP].ui_id, RUN_BOX_ON, -1);
+    uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_SPIBT_DN].ui_id, RUN_BOX_ON, -1);
+
+    return (reactor_add_timer (p->reactor, APP_LOOP_DELAY, check_spibt, p) < 0) ? 0 : 1;
 }
 
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
-int check_device_ethernet (client_t *p)
+static int check_device_ethernet (client_t *p, int event)
 {
     int speed;
 
@@ -666,107 +735,171 @@ int check_device_ethernet (client_t *p)
 
     speed = ethernet_link_check ();
 
-    if ((EventIR == eEVENT_ETH_GLED) && (speed != LINK_SPEED_100M)) {
+    if ((event == eEVENT_ETH_GLED) && (speed != LINK_SPEED_100M)) {
 
-        m1_item[eITEM_ETHERNET_100M].status = eSTATUS_RUN;
+        item_set (eITEM_ETHERNET_100M, eSTATUS_RUN, ITEM_KEEP);
 
-        ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_ETHERNET_100M].ui_id, COLOR_YELLOW, -1);
-        ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_ETHERNET_LED].ui_id, COLOR_YELLOW, -1);
+        uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_ETHERNET_100M].ui_id, COLOR_YELLOW, -1);
+        uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_ETHERNET_LED].ui_id, COLOR_YELLOW, -1);
         if (ethernet_link_setup (LINK_SPEED_100M)) {
-            m1_item[eITEM_ETHERNET_100M].status = eSTATUS_STOP;
-            m1_item[eITEM_ETHERNET_100M].result = eRESULT_PASS;
-            ui_set_sitem (p->pfb, p->pui, m1_item[eITEM_ETHERNET_100M].ui_id, -1, -1, "PASS");
-            ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_ETHERNET_100M].ui_id, COLOR_GREEN, -1);
+            item_set (eITEM_ETHERNET_100M, eSTATUS_STOP, eRESULT_PASS);
+            uif_set_sitem (p->pfb, p->pui, m1_item[eITEM_ETHERNET_100M].ui_id, -1, -1, "PASS");
+            uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_ETHERNET_100M].ui_id, COLOR_GREEN, -1);
 
-            ui_set_sitem (p->pfb, p->pui, m1_item[eITEM_ETHERNET_LED].ui_id, -1, -1, "GREEN");
-            ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_ETHERNET_LED].ui_id, COLOR_DARK_CYAN, -1);
+            uif_set_sitem (p->pfb, p->pui, m1_item[eITEM_ETHERNET_LED].ui_id, -1, -1, "GREEN");
+            uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_ETHERNET_LED].ui_id, COLOR_DARK_CYAN, -1);
             return 1;
         }
     }
 
-    if ((EventIR == eEVENT_ETH_OLED) && (speed != LINK_SPEED_1G)) {
+    if ((event == eEVENT_ETH_OLED) && (speed != LINK_SPEED_1G)) {
 
-        m1_item[eITEM_ETHERNET_1G].status = eSTATUS_RUN;
+        item_set (eITEM_ETHERNET_1G, eSTATUS_RUN, ITEM_KEEP);
 
-        ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_ETHERNET_1G].ui_id, COLOR_YELLOW, -1);
-        ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_ETHERNET_LED].ui_id, COLOR_YELLOW, -1);
+        uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_ETHERNET_1G].ui_id, COLOR_YELLOW, -1);
+        uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_ETHERNET_LED].ui_id, COLOR_YELLOW, -1);
         if (ethernet_link_setup (LINK_SPEED_1G)) {
-            m1_item[eITEM_ETHERNET_1G].status = eSTATUS_STOP;
-            m1_item[eITEM_ETHERNET_1G].result = eRESULT_PASS;
-            ui_set_sitem (p->pfb, p->pui, m1_item[eITEM_ETHERNET_1G].ui_id, -1, -1, "PASS");
-            ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_ETHERNET_1G].ui_id, COLOR_GREEN, -1);
+            item_set (eITEM_ETHERNET_1G, eSTATUS_STOP, eRESULT_PASS);
+            uif_set_sitem (p->pfb, p->pui, m1_item[eITEM_ETHERNET_1G].ui_id, -1, -1, "PASS");
+            uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_ETHERNET_1G].ui_id, COLOR_GREEN, -1);
 
-            ui_set_sitem (p->pfb, p->pui, m1_item[eITEM_ETHERNET_LED].ui_id, -1, -1, "ORANGE");
-            ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_ETHERNET_LED].ui_id, COLOR_DARK_KHAKI, -1);
+            uif_set_sitem (p->pfb, p->pui, m1_item[eITEM_ETHERNET_LED].ui_id, -1, -1, "ORANGE");
+            uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_ETHERNET_LED].ui_id, COLOR_DARK_KHAKI, -1);
             return 1;
         }
     }
     return 0;
 }
 
+//------------------------------------------------------------------------------
+// storage/usb throughput items. All present devices are measured in parallel.
+//------------------------------------------------------------------------------
+struct bench_item {
+    int item_id, dev_id;
+    // hotplug device bit
+    unsigned int hp_mask;
+};
+
+const struct bench_item USB_ITEMS [] = {
+    { eITEM_USB30_UP, eUSB30_UP_R, HOTPLUG_USB(eUSB30_UP_R) },
+    { eITEM_USB30_DN, eUSB30_DN_R, HOTPLUG_USB(eUSB30_DN_R) },
+    { eITEM_USB20_UP, eUSB20_UP_R, HOTPLUG_USB(eUSB20_UP_R) },
+    { eITEM_USB20_DN, eUSB20_DN_R, HOTPLUG_USB(eUSB20_DN_R) },
+};
+
+const struct bench_item STORAGE_ITEMS [] = {
+    { eITEM_eMMC, eSTORAGE_eMMC, HOTPLUG_STORAGE(eSTORAGE_eMMC) },
+    { eITEM_SATA, eSTORAGE_SATA, HOTPLUG_STORAGE(eSTORAGE_SATA) },
+    { eITEM_NVME, eSTORAGE_NVME, HOTPLUG_STORAGE(eSTORAGE_NVME) },
+};
+
+#define ITEM_COUNT(x)   (int)(sizeof(x) / sizeof(x[0]))
+
+//------------------------------------------------------------------------------
+static void bench_item_display (client_t *p, struct bench_job *job)
+{
+    char str[10];
+    int ui_id = m1_item[job->id].ui_id;
+
+    memset (str, 0, sizeof(str));   sprintf(str, "%d MB/s", job->value);
+    uif_set_sitem (p->pfb, p->pui, ui_id, -1, -1, str);
+    uif_set_ritem (p->pfb, p->pui, ui_id, job->value ? COLOR_GREEN : COLOR_RED, -1);
+    item_set (job->id, ITEM_KEEP, job->value ? eRESULT_PASS : eRESULT_FAIL);
+
+    printf ("%s : %s %d MB/s, %d iops, lat p50/p99 %d/%d us\n", __func__,
+        m1_item[job->id].name, job->r.mbps, job->r.iops, job->r.lat_p50, job->r.lat_p99);
+}
+
+//------------------------------------------------------------------------------
+// start the items of the hotplug device bits (hp_mask) whose device is present
+// and not measured yet (one thread each)
+//------------------------------------------------------------------------------
+static int bench_item_start (client_t *p, const struct bench_item *items, int cnt,
+                             struct bench_job *jobs, unsigned int hp_mask,
+                             int (*check)(int), int (*run)(int, struct bench_result *),
+                             bench_done_t done)
+{
+    int i, start_cnt = 0;
+
+    for (i = 0; i < cnt; i++) {
+        if (!(items[i].hp_mask & hp_mask))
+            continue;
+        if (item_result (items[i].item_id) || atomic_load (&jobs[i].busy))
+            continue;
+        if (!check (items[i].dev_id))
+            continue;
+
+        item_set (items[i].item_id, eSTATUS_RUN, ITEM_KEEP);
+        uif_set_ritem (p->pfb, p->pui, m1_item[items[i].item_id].ui_id, COLOR_YELLOW, -1);
+
+        jobs[i].id     = items[i].item_id;
+        jobs[i].dev_id = items[i].dev_id;
+        jobs[i].run    = run;
+        jobs[i].value  = 0;
+        memset (&jobs[i].r, 0, sizeof(struct bench_result));
+        if (bench_pool_start (&jobs[i], done, p))
+            start_cnt++;
+    }
+    return start_cnt;
+}
+
+//------------------------------------------------------------------------------
+static void usb_job_done (struct bench_job *job, void *arg)
+{
+    bench_item_display ((client_t *)arg, job);
+    item_set (job->id, eSTATUS_STOP, ITEM_KEEP);
+}
+
+//------------------------------------------------------------------------------
+// uevent filter : wake up the storage/usb thread only for the test device
+// of the event (usb port first, a usb disk is also /dev/sdX).
+//------------------------------------------------------------------------------
+static unsigned int hotplug_filter (const struct uevent *ev)
+{
+    int id;
+
+    if (strcmp (ev->subsystem, "block") || strcmp (ev->devtype, "disk"))
+        return 0;
+
+    if ((id = usb_uevent_id (ev->devpath)) >= 0) {
+        printf ("%s : usb %d %s %s\n", __func__, id, ev->action, ev->devname);
+        usb_index_refresh ();
+        return HOTPLUG_USB(id);
+    }
+    if ((id = storage_uevent_id (ev->devname)) >= 0) {
+        printf ("%s : storage %d %s %s\n", __func__, id, ev->action, ev->devname);
+        return HOTPLUG_STORAGE(id);
+    }
+    return 0;
+}
+
 //------------------------------------------------------------------------------
 void *check_device_usb (void *arg);
 void *check_device_usb (void *arg)
 {
-    int value = 0;
-    char str[10];
+    static struct bench_job jobs[ITEM_COUNT(USB_ITEMS)];
     client_t *p = (client_t *)arg;
+    unsigned int hp_mask = HOTPLUG_USB_ALL;
+    int i, pass;
 
-    ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_USB30_UP].ui_id, RUN_BOX_ON, -1);
-    ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_USB30_DN].ui_id, RUN_BOX_ON, -1);
-    ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_USB20_UP].ui_id, RUN_BOX_ON, -1);
-    ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_USB20_DN].ui_id, RUN_BOX_ON, -1);
+    for (i = 0; i < ITEM_COUNT(USB_ITEMS); i++)
+        uif_set_ritem (p->pfb, p->pui, m1_item[USB_ITEMS[i].item_id].ui_id, RUN_BOX_ON, -1);
 
     while (1) {
-        // USB30
-        if (!m1_item[eITEM_USB30_UP].result && usb_check (eUSB30_UP_R)) {
-            m1_item[eITEM_USB30_UP].status = eSTATUS_RUN;
-            ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_USB30_UP].ui_id, COLOR_YELLOW, -1);
-            value = usb_rw (eUSB30_UP_R);
-            memset (str, 0, sizeof(str));   sprintf(str, "%d MB/s", value);
-            ui_set_sitem (p->pfb, p->pui, m1_item[eITEM_USB30_UP].ui_id, -1, -1, str);
-            ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_USB30_UP].ui_id, value ? COLOR_GREEN : COLOR_RED, -1);
-            m1_item[eITEM_USB30_UP].result = value ? eRESULT_PASS : eRESULT_FAIL;
-            m1_item[eITEM_USB30_UP].status = eSTATUS_STOP;
-        }
-        if (!m1_item[eITEM_USB30_DN].result && usb_check (eUSB30_DN_R)) {
-            m1_item[eITEM_USB30_DN].status = eSTATUS_RUN;
-            ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_USB30_DN].ui_id, COLOR_YELLOW, -1);
-            value = usb_rw (eUSB30_DN_R);
-            memset (str, 0, sizeof(str));   sprintf(str, "%d MB/s", value);
-            ui_set_sitem (p->pfb, p->pui, m1_item[eITEM_USB30_DN].ui_id, -1, -1, str);
-            ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_USB30_DN].ui_id, value ? COLOR_GREEN : COLOR_RED, -1);
-            m1_item[eITEM_USB30_DN].result = value ? eRESULT_PASS : eRESULT_FAIL;
-            m1_item[eITEM_USB30_DN].status = eSTATUS_STOP;
-        }
-
-        // USB20
-        if (!m1_item[eITEM_USB20_UP].result && usb_check (eUSB20_UP_R)) {
-            m1_item[eITEM_USB20_UP].status = eSTATUS_RUN;
-            ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_USB20_UP].ui_id, COLOR_YELLOW, -1);
-            value = usb_rw (eUSB20_UP_R);
-            memset (str, 0, sizeof(str));   sprintf(str, "%d MB/s", value);
-            ui_set_sitem (p->pfb, p->pui, m1_item[eITEM_USB20_UP].ui_id, -1, -1, str);
-            ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_USB20_UP].ui_id, value ? COLOR_GREEN : COLOR_RED, -1);
-            m1_item[eITEM_USB20_UP].result = value ? eRESULT_PASS : eRESULT_FAIL;
-            m1_item[eITEM_USB20_UP].status = eSTATUS_STOP;
-        }
-        if (!m1_item[eITEM_USB20_DN].result && usb_check (eUSB20_DN_R)) {
-            m1_item[eITEM_USB20_DN].status = eSTATUS_RUN;
-            ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_USB20_DN].ui_id, COLOR_YELLOW, -1);
-            value = usb_rw (eUSB20_DN_R);
-            memset (str, 0, sizeof(str));   sprintf(str, "%d MB/s", value);
-            ui_set_sitem (p->pfb, p->pui, m1_item[eITEM_USB20_DN].ui_id, -1, -1, str);
-            ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_USB20_DN].ui_id, value ? COLOR_GREEN : COLOR_RED, -1);
-            m1_item[eITEM_USB20_DN].result = value ? eRESULT_PASS : eRESULT_FAIL;
-            m1_item[eITEM_USB20_DN].status = eSTATUS_STOP;
-        }
+        bench_item_start (p, USB_ITEMS, ITEM_COUNT(USB_ITEMS), jobs, hp_mask,
+                          usb_check, usb_bench, usb_job_done);
 
-        if (m1_item[eITEM_USB30_UP].result && m1_item[eITEM_USB30_DN].result &&
-            m1_item[eITEM_USB20_UP].result && m1_item[eITEM_USB20_DN].result)
+        for (i = 0, pass = 0; i < ITEM_COUNT(USB_ITEMS); i++)
+            if (item_result (USB_ITEMS[i].item_id))   pass++;
+        if (pass == ITEM_COUNT(USB_ITEMS))
             break;
 
-        usleep (APP_LOOP_DELAY * 1000);
+        // wait for a usb device (fallback retry period : every port)
+        if ((hp_mask = hotplug_wait (HOTPLUG_USB_ALL, HOTPLUG_RETRY_MS)) == 0)
+            hp_mask = HOTPLUG_USB_ALL;
+        // the uevent filter refreshes the usb index, inotify/poll have no port info
+        if (hotplug_mode () != eHOTPLUG_UEVENT)
+            usb_index_refresh ();
     }
 
     return arg;
@@ -776,89 +909,73 @@ void *check_device_usb (void *arg)
 static int check_header (client_t *p)
 {
     static int init = 0;
+    // failed pattern mask of the last diagnosis
+    static unsigned int diag_fail = 0;
     int ui_id = m1_item[eITEM_HEADER_PT1].ui_id, i;
-    int pattern40[40 +1], cnt;
+    int pattern40[40 +1];
+    unsigned int fail = 0;
 
     if (!init)  {   header_init (); init = 1; }
 
     for (i = 0; i < eHEADER_END; i++) {
-        if (!m1_item[eITEM_HEADER_PT1 + i].result) {
-            m1_item[eITEM_HEADER_PT1 + i].status = eSTATUS_RUN;
-            ui_set_ritem (p->pfb, p->pui, ui_id + i, COLOR_YELLOW, -1);
-
-            header_pattern_set (i); usleep (100 * 1000);
+        if (!item_result (eITEM_HEADER_PT1 + i)) {
+            item_set (eITEM_HEADER_PT1 + i, eSTATUS_RUN, ITEM_KEEP);
+            uif_set_ritem (p->pfb, p->pui, ui_id + i, COLOR_YELLOW, -1);
 
-            memset (pattern40, 0, sizeof(pattern40));
-            adc_board_read (p->adc_fd,  "CON1", &pattern40[1],  &cnt);
+            // a pattern that never settles is judged on the last read
+            header_pattern_settle (i, p->adc_fd, pattern40);
             if (header_pattern_check (i, pattern40)) {
-                m1_item[eITEM_HEADER_PT1 + i].result = eRESULT_PASS;
-                ui_set_sitem (p->pfb, p->pui, ui_id + i, -1, -1, "PASS");
-                ui_set_ritem (p->pfb, p->pui, ui_id + i, COLOR_GREEN, -1);
+                item_set (eITEM_HEADER_PT1 + i, ITEM_KEEP, eRESULT_PASS);
+                uif_set_sitem (p->pfb, p->pui, ui_id + i, -1, -1, "PASS");
+                uif_set_ritem (p->pfb, p->pui, ui_id + i, COLOR_GREEN, -1);
             } else {
-                m1_item[eITEM_HEADER_PT1 + i].result = eRESULT_FAIL;
-                ui_set_sitem (p->pfb, p->pui, ui_id + i, -1, -1, "FAIL");
-                ui_set_ritem (p->pfb, p->pui, ui_id + i, COLOR_RED, -1);
+                item_set (eITEM_HEADER_PT1 + i, ITEM_KEEP, eRESULT_FAIL);
+                uif_set_sitem (p->pfb, p->pui, ui_id + i, -1, -1, "FAIL");
+                uif_set_ritem (p->pfb, p->pui, ui_id + i, COLOR_RED, -1);
             }
-            m1_item[eITEM_HEADER_PT1 + i].status = eSTATUS_STOP;
+            item_set (eITEM_HEADER_PT1 + i, eSTATUS_STOP, ITEM_KEEP);
+            if (item_result (eITEM_HEADER_PT1 + i) == eRESULT_FAIL)
+                fail |= (1u << i);
         }
     }
+    // locate the shorted / open pins for the rework bench, once per set of
+    // failed patterns (not on every retry, the ADC task waits for the bus)
+    if (fail && (fail != diag_fail)) {
+        struct h40_diag diag;
+        header_diag (eHEADER_DIAG_ADDR, p->adc_fd, &diag);
+    }
+    diag_fail = fail;
     return 1;
 }
 
+//------------------------------------------------------------------------------
+static void storage_job_done (struct bench_job *job, void *arg)
+{
+    bench_item_display ((client_t *)arg, job);
+    if (item_result (job->id)) item_set (job->id, eSTATUS_STOP, ITEM_KEEP);
+}
+
 //------------------------------------------------------------------------------
 void *check_device_storage (void *arg);
 void *check_device_storage (void *arg)
 {
-    int value = 0;
-    char str[10];
+    static struct bench_job jobs[ITEM_COUNT(STORAGE_ITEMS)];
     client_t *p = (client_t *)arg;
+    unsigned int hp_mask = HOTPLUG_STORAGE_ALL;
+    int i, pass;
 
     while (1) {
-        // eMMC
-        if (!m1_item [eITEM_eMMC].result && storage_check (eSTORAGE_eMMC)) {
-            m1_item[eITEM_eMMC].status = eSTATUS_RUN;
+        bench_item_start (p, STORAGE_ITEMS, ITEM_COUNT(STORAGE_ITEMS), jobs, hp_mask,
+                          storage_check, storage_bench, storage_job_done);
 
-            ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_eMMC].ui_id, COLOR_YELLOW, -1);
-            value = storage_rw (eSTORAGE_eMMC);
-            memset (str, 0, sizeof(str));   sprintf(str, "%d MB/s", value);
-
-            ui_set_sitem (p->pfb, p->pui, m1_item[eITEM_eMMC].ui_id, -1, -1, str);
-            ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_eMMC].ui_id, value ? COLOR_GREEN : COLOR_RED, -1);
-            m1_item[eITEM_eMMC].result = value ? eRESULT_PASS : eRESULT_FAIL;
-
-            if (m1_item[eITEM_eMMC].result) m1_item[eITEM_eMMC].status = eSTATUS_STOP;
-        }
-
-        // SATA
-        if (!m1_item [eITEM_SATA].result && storage_check (eSTORAGE_SATA)) {
-            m1_item[eITEM_SATA].status = eSTATUS_RUN;
-            ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_SATA].ui_id, COLOR_YELLOW, -1);
-            value = storage_rw (eSTORAGE_SATA);
-            memset (str, 0, sizeof(str));   sprintf(str, "%d MB/s", value);
-
-            ui_set_sitem (p->pfb, p->pui, m1_item[eITEM_SATA].ui_id, -1, -1, str);
-            ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_SATA].ui_id, value ? COLOR_GREEN : COLOR_RED, -1);
-            m1_item[eITEM_SATA].result = value ? eRESULT_PASS : eRESULT_FAIL;
-
-            if (m1_item[eITEM_SATA].result)  m1_item[eITEM_SATA].status = eSTATUS_STOP;
-        }
-
-        // NVME
-        if (!m1_item [eITEM_NVME].result && storage_check (eSTORAGE_NVME)) {
-            m1_item[eITEM_NVME].status = eSTATUS_RUN;
-            ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_NVME].ui_id, COLOR_YELLOW, -1);
-            value = storage_rw (eSTORAGE_NVME);
-            memset (str, 0, sizeof(str));   sprintf(str, "%d MB/s", value);
-
-            ui_set_sitem (p->pfb, p->pui, m1_item[eITEM_NVME].ui_id, -1, -1, str);
-            ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_NVME].ui_id, value ? COLOR_GREEN : COLOR_RED, -1);
-            m1_item[eITEM_NVME].result = value ? eRESULT_PASS : eRESULT_FAIL;
-
-            if (m1_item[eITEM_NVME].result) m1_item[eITEM_NVME].status = eSTATUS_STOP;
-        }
-        if (m1_item [eITEM_eMMC].result && m1_item [eITEM_SATA].result && m1_item [eITEM_NVME].result)
+        for (i = 0, pass = 0; i < ITEM_COUNT(STORAGE_ITEMS); i++)
+            if (item_result (STORAGE_ITEMS[i].item_id))   pass++;
+        if (pass == ITEM_COUNT(STORAGE_ITEMS))
             break;
-        usleep (APP_LOOP_DELAY * 1000);
+
+        // wait for a storage device (fallback retry period : every device)
+        if ((hp_mask = hotplug_wait (HOTPLUG_STORAGE_ALL, HOTPLUG_RETRY_MS)) == 0)
+            hp_mask = HOTPLUG_STORAGE_ALL;
     }
     return arg;
 }
@@ -871,40 +988,39 @@ static int check_device_system (client_t *p)
 
     // MEM
     if (TimeoutStop) {
-        m1_item[eITEM_MEM].status = eSTATUS_RUN;
-        ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_MEM].ui_id, COLOR_YELLOW, -1);
+        item_set (eITEM_MEM, eSTATUS_RUN, ITEM_KEEP);
+        uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_MEM].ui_id, COLOR_YELLOW, -1);
         value = system_check (eSYSTEM_MEM);
         p->board_mem = value;
         memset (str, 0, sizeof(str));
         if (p->test_model) {
             sprintf (str, "%d / T-%d GB", p->board_mem, p->test_model);
-            ui_set_sitem (p->pfb, p->pui, m1_item[eITEM_MEM].ui_id, -1, -1, str);
-            ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_MEM].ui_id,
+            uif_set_sitem (p->pfb, p->pui, m1_item[eITEM_MEM].ui_id, -1, -1, str);
+            uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_MEM].ui_id,
                             (p->test_model == p->board_mem) ? COLOR_GREEN : COLOR_RED, -1);
         } else {
             sprintf(str, "%d GB", value);
-            ui_set_sitem (p->pfb, p->pui, m1_item[eITEM_MEM].ui_id, -1, -1, str);
-            ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_MEM].ui_id, value ? COLOR_GREEN : COLOR_RED, -1);
-            m1_item[eITEM_MEM].result = value ? eRESULT_PASS : eRESULT_FAIL;
+            uif_set_sitem (p->pfb, p->pui, m1_item[eITEM_MEM].ui_id, -1, -1, str);
+            uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_MEM].ui_id, value ? COLOR_GREEN : COLOR_RED, -1);
+            item_set (eITEM_MEM, ITEM_KEEP, value ? eRESULT_PASS : eRESULT_FAIL);
         }
-        m1_item[eITEM_MEM].status = eSTATUS_STOP;
+        item_set (eITEM_MEM, eSTATUS_STOP, ITEM_KEEP);
     }
 
     // FB
-    if (!m1_item[eITEM_FB].result) {
-        m1_item[eITEM_FB].status = eSTATUS_RUN;
-        ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_FB].ui_id, COLOR_YELLOW, -1);
+    if (!item_result (eITEM_FB)) {
+        item_set (eITEM_FB, eSTATUS_RUN, ITEM_KEEP);
+        uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_FB].ui_id, COLOR_YELLOW, -1);
         value = system_check (eSYSTEM_FB_Y);
         memset (str, 0, sizeof(str));   sprintf(str, "%dP", value);
 
-        ui_set_sitem (p->pfb, p->pui, m1_item[eITEM_FB].ui_id, -1, -1, str);
-        ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_FB].ui_id, (value == 1080) ? COLOR_GREEN : COLOR_RED, -1);
-        m1_item[eITEM_FB].result = (value == 1080) ? eRESULT_PASS : eRESULT_FAIL;
-        m1_item[eITEM_FB].status = eSTATUS_STOP;
+        uif_set_sitem (p->pfb, p->pui, m1_item[eITEM_FB].ui_id, -1, -1, str);
+        uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_FB].ui_id, (value == 1080) ? COLOR_GREEN : COLOR_RED, -1);
+        item_set (eITEM_FB, eSTATUS_STOP, (value == 1080) ? eRESULT_PASS : eRESULT_FAIL);
     }
 
     if (p->test_model && (p->test_model != p->board_mem))
-        m1_item[eITEM_MEM].result = eRESULT_FAIL;
+        item_set (eITEM_MEM, ITEM_KEEP, eRESULT_FAIL);
 
     return 1;
 }
@@ -915,25 +1031,23 @@ static int check_device_hdmi (client_t *p)
     int value = 0;
 
     // EDID
-    if (!m1_item[eITEM_EDID].result) {
-        m1_item[eITEM_EDID].status = eSTATUS_RUN;
-        ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_EDID].ui_id, COLOR_YELLOW, -1);
+    if (!item_result (eITEM_EDID)) {
+        item_set (eITEM_EDID, eSTATUS_RUN, ITEM_KEEP);
+        uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_EDID].ui_id, COLOR_YELLOW, -1);
         value = hdmi_check (eHDMI_EDID);
-        ui_set_sitem (p->pfb, p->pui, m1_item[eITEM_EDID].ui_id, -1, -1, value ? "PASS":"FAIL");
-        ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_EDID].ui_id, value ? COLOR_GREEN : COLOR_RED, -1);
-        m1_item[eITEM_EDID].result = value ? eRESULT_PASS : eRESULT_FAIL;
-        m1_item[eITEM_EDID].status = eSTATUS_STOP;
+        uif_set_sitem (p->pfb, p->pui, m1_item[eITEM_EDID].ui_id, -1, -1, value ? "PASS":"FAIL");
+        uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_EDID].ui_id, value ? COLOR_GREEN : COLOR_RED, -1);
+        item_set (eITEM_EDID, eSTATUS_STOP, value ? eRESULT_PASS : eRESULT_FAIL);
     }
 
     // HPD
-    if (!m1_item[eITEM_HPD].result) {
-        m1_item[eITEM_HPD].status = eSTATUS_RUN;
-        ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_HPD].ui_id, COLOR_YELLOW, -1);
+    if (!item_result (eITEM_HPD)) {
+        item_set (eITEM_HPD, eSTATUS_RUN, ITEM_KEEP);
+        uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_HPD].ui_id, COLOR_YELLOW, -1);
         value = hdmi_check (eHDMI_HPD);
-        ui_set_sitem (p->pfb, p->pui, m1_item[eITEM_HPD].ui_id, -1, -1, value ? "PASS":"FAIL");
-        ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_HPD].ui_id, value ? COLOR_GREEN : COLOR_RED, -1);
-        m1_item[eITEM_HPD].result = value ? eRESULT_PASS : eRESULT_FAIL;
-        m1_item[eITEM_HPD].status = eSTATUS_STOP;
+        uif_set_sitem (p->pfb, p->pui, m1_item[eITEM_HPD].ui_id, -1, -1, value ? "PASS":"FAIL");
+        uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_HPD].ui_id, value ? COLOR_GREEN : COLOR_RED, -1);
+        item_set (eITEM_HPD, eSTATUS_STOP, value ? eRESULT_PASS : eRESULT_FAIL);
     }
 
     return 1;
@@ -946,27 +1060,25 @@ static int check_device_adc (client_t *p)
     char str[10];
 
     // ADC37
-    if (!m1_item[eITEM_ADC37].result) {
-        m1_item[eITEM_ADC37].status = eSTATUS_RUN;
-        ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_ADC37].ui_id, COLOR_YELLOW, -1);
+    if (!item_result (eITEM_ADC37)) {
+        item_set (eITEM_ADC37, eSTATUS_RUN, ITEM_KEEP);
+        uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_ADC37].ui_id, COLOR_YELLOW, -1);
         adc_value = adc_check (eADC_H37);
         memset  (str, 0, sizeof(str));  sprintf (str, "%d", adc_value);
-        ui_set_sitem (p->pfb, p->pui, m1_item[eITEM_ADC37].ui_id, -1, -1, str);
-        ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_ADC37].ui_id, adc_value ? COLOR_GREEN : COLOR_RED, -1);
-        m1_item[eITEM_ADC37].result = adc_value ? eRESULT_PASS : eRESULT_FAIL;
-        m1_item[eITEM_ADC37].status = eSTATUS_STOP;
+        uif_set_sitem (p->pfb, p->pui, m1_item[eITEM_ADC37].ui_id, -1, -1, str);
+        uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_ADC37].ui_id, adc_value ? COLOR_GREEN : COLOR_RED, -1);
+        item_set (eITEM_ADC37, eSTATUS_STOP, adc_value ? eRESULT_PASS : eRESULT_FAIL);
     }
 
     // ADC40
-    if (!m1_item[eITEM_ADC40].result) {
-        m1_item[eITEM_ADC40].status = eSTATUS_RUN;
-        ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_ADC40].ui_id, COLOR_YELLOW, -1);
+    if (!item_result (eITEM_ADC40)) {
+        item_set (eITEM_ADC40, eSTATUS_RUN, ITEM_KEEP);
+        uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_ADC40].ui_id, COLOR_YELLOW, -1);
         adc_value = adc_check (eADC_H40);
         memset  (str, 0, sizeof(str));  sprintf (str, "%d", adc_value);
-        ui_set_sitem (p->pfb, p->pui, m1_item[eITEM_ADC40].ui_id, -1, -1, str);
-        ui_set_ritem (p->pfb, p->pui, m1_item[eITEM_ADC40].ui_id, adc_value ? COLOR_GREEN : COLOR_RED, -1);
-        m1_item[eITEM_ADC40].result = adc_value ? eRESULT_PASS : eRESULT_FAIL;
-        m1_item[eITEM_ADC40].status = eSTATUS_STOP;
+        uif_set_sitem (p->pfb, p->pui, m1_item[eITEM_ADC40].ui_id, -1, -1, str);
+        uif_set_ritem (p->pfb, p->pui, m1_item[eITEM_ADC40].ui_id, adc_value ? COLOR_GREEN : COLOR_RED, -1);
+        item_set (eITEM_ADC40, eSTATUS_STOP, adc_value ? eRESULT_PASS : eRESULT_FAIL);
     }
     return 1;
 }
@@ -978,8 +1090,8 @@ static int check_mac_addr (client_t *p)
 
     efuse_set_board (eBOARD_ID_M1);
 
-    m1_item[eITEM_MAC_ADDR].status = eSTATUS_RUN;
-    ui_set_ritem (p->pfb, p->pui, m1_item [eITEM_MAC_ADDR].ui_id, COLOR_YELLOW, -1);
+    item_set (eITEM_MAC_ADDR, eSTATUS_RUN, ITEM_KEEP);
+    uif_set_ritem (p->pfb, p->pui, m1_item [eITEM_MAC_ADDR].ui_id, COLOR_YELLOW, -1);
 
     if (efuse_control (p->efuse_data, EFUSE_READ)) {
         efuse_get_mac (p->efuse_data, p->mac);
@@ -989,11 +1101,11 @@ static int check_mac_addr (client_t *p)
                 if (efuse_control (p->efuse_data, EFUSE_WRITE)) {
                     efuse_get_mac (p->efuse_data, p->mac);
                    if (efuse_valid_check (p->efuse_data))
-                        m1_item [eITEM_MAC_ADDR].result = eRESULT_PASS;
+                        item_set (eITEM_MAC_ADDR, ITEM_KEEP, eRESULT_PASS);
                 }
             }
         } else {
-            m1_item [eITEM_MAC_ADDR].result = eRESULT_PASS;
+            item_set (eITEM_MAC_ADDR, ITEM_KEEP, eRESULT_PASS);
         }
     }
 
@@ -1004,76 +1116,111 @@ static int check_mac_addr (client_t *p)
             p->mac[6],  p->mac[7], p->mac[8],
             p->mac[9], p->mac[10], p->mac[11]);
 
-    ui_set_sitem (p->pfb, p->pui, m1_item [eITEM_MAC_ADDR].ui_id, -1, -1, str);
-    m1_item[eITEM_MAC_ADDR].status = eSTATUS_STOP;
+    uif_set_sitem (p->pfb, p->pui, m1_item [eITEM_MAC_ADDR].ui_id, -1, -1, str);
+    item_set (eITEM_MAC_ADDR, eSTATUS_STOP, ITEM_KEEP);
 
-    if (m1_item [eITEM_MAC_ADDR].result) {
-        ui_set_ritem (p->pfb, p->pui, m1_item [eITEM_MAC_ADDR].ui_id, COLOR_GREEN, -1);
+    if (item_result (eITEM_MAC_ADDR)) {
+        uif_set_ritem (p->pfb, p->pui, m1_item [eITEM_MAC_ADDR].ui_id, COLOR_GREEN, -1);
         tolowerstr (p->mac);
 //        nlp_server_write (p->nlp_ip, NLP_SERVER_MSG_TYPE_MAC, p->mac, p->channel);
         return 1;
     }
-    ui_set_ritem (p->pfb, p->pui, m1_item [eITEM_MAC_ADDR].ui_id, COLOR_RED, -1);
+    uif_set_ritem (p->pfb, p->pui, m1_item [eITEM_MAC_ADDR].ui_id, COLOR_RED, -1);
     return 0;
 }
 
 //------------------------------------------------------------------------------
 #define IPERF_SPEED_MIN 800
 
+//------------------------------------------------------------------------------
+// In-process udp throughput against the netperf server of the nlp host
+// (tools/netperf -s). return Mbit/s, -1 = no netperf server (use iperf3)
+//------------------------------------------------------------------------------
+static int netperf_speed_check (client_t *p)
+{
+    struct netperf_cfg cfg;
+    struct netperf_result r;
+
+    netperf_default (&cfg, p->nlp_ip, eNETPERF_UDP);
+    netperf_run (&cfg, &r);
+
+    if ((r.err == ECONNREFUSED) || (r.err == ETIMEDOUT) || (r.err == EHOSTUNREACH))
+        return -1;
+
+    printf ("%s : %d Mbits/sec, lost %lld/%lld, jitter %d usec, err %d\n", __func__,
+            r.mbps, r.lost, r.sent, r.jitter_us, r.err);
+    return r.mbps;
+}
+
+//------------------------------------------------------------------------------
+// task_iperf and the ENTER retry : storage/usb benchmarks are held while the
+// throughput test runs (bus/CPU load)
+//------------------------------------------------------------------------------
 static int check_iperf_speed (client_t *p)
 {
     int value = 0, retry = 3;
     char str[32];
 
+    bench_pool_quiet_enter ();
 retry_iperf:
-    m1_item [eITEM_IPERF].status = eSTATUS_RUN;
-    ui_set_ritem (p->pfb, p->pui, m1_item [eITEM_IPERF].ui_id, COLOR_YELLOW, -1);
-    nlp_server_write (p->nlp_ip, NLP_SERVER_MSG_TYPE_UDP, "start", 0);  usleep (APP_LOOP_DELAY * 1000);
-    value = iperf3_speed_check(p->nlp_ip, NLP_SERVER_MSG_TYPE_UDP);
-    nlp_server_write (p->nlp_ip, NLP_SERVER_MSG_TYPE_UDP, "stop", 0);   usleep (APP_LOOP_DELAY * 1000);
+    item_set (eITEM_IPERF, eSTATUS_RUN, ITEM_KEEP);
+    uif_set_ritem (p->pfb, p->pui, m1_item [eITEM_IPERF].ui_id, COLOR_YELLOW, -1);
+    if ((value = netperf_speed_check (p)) < 0) {
+        nlp_server_write (p->nlp_ip, NLP_SERVER_MSG_TYPE_UDP, "start", 0);  usleep (APP_LOOP_DELAY * 1000);
+        value = iperf3_speed_check(p->nlp_ip, NLP_SERVER_MSG_TYPE_UDP);
+        nlp_server_write (p->nlp_ip, NLP_SERVER_MSG_TYPE_UDP, "stop", 0);   usleep (APP_LOOP_DELAY * 1000);
+    }
 
     memset  (str, 0, sizeof(str));
     sprintf (str, "%d Mbits/sec", value);
 
-    ui_set_sitem (p->pfb, p->pui, m1_item [eITEM_IPERF].ui_id, -1, -1, str);
-    ui_set_ritem (p->pfb, p->pui, m1_item [eITEM_IPERF].ui_id, value > IPERF_SPEED_MIN ? COLOR_GREEN : COLOR_RED, -1);
-    m1_item [eITEM_IPERF].result = value > IPERF_SPEED_MIN ? eRESULT_PASS : eRESULT_FAIL;
-    m1_item [eITEM_IPERF].status = eSTATUS_STOP;
+    uif_set_sitem (p->pfb, p->pui, m1_item [eITEM_IPERF].ui_id, -1, -1, str);
+    uif_set_ritem (p->pfb, p->pui, m1_item [eITEM_IPERF].ui_id, value > IPERF_SPEED_MIN ? COLOR_GREEN : COLOR_RED, -1);
+    item_set (eITEM_IPERF, eSTATUS_STOP, value > IPERF_SPEED_MIN ? eRESULT_PASS : eRESULT_FAIL);
 
-    if (!m1_item [eITEM_IPERF].result) {
-        usleep (APP_LOOP_DELAY * 1000);
+    if (!item_result (eITEM_IPERF)) {
         if (retry) {    retry--;    goto retry_iperf;   }
     }
+    bench_pool_quiet_leave ();
     return 1;
 }
 
 //------------------------------------------------------------------------------
 #define I2C_ADC_DEV "gpio,scl,109,sda,110"
 
+enum { eBOARD_DC_JACK = 0, eBOARD_CHANNEL, eBOARD_MODEL_4GB, eBOARD_MODEL_8GB, eBOARD_END };
+
+static const char * const BoardAdcChan [eBOARD_END] = { "P13.2", "P3.2", "P3.8", "P3.9" };
+
 static int check_i2cadc (client_t *p)
 {
     // ADC Board Check
-    int value = 0, cnt = 1;
+    adc_batch_t batch;
+    int value [eBOARD_END][ADC_CHAN_VALUE_MAX], *pv [eBOARD_END], cnt [eBOARD_END], i;
 
-    p->adc_fd = adc_board_init (I2C_ADC_DEV);
+    p->adc_fd = adcboard_init (I2C_ADC_DEV);
 
     if (p->adc_fd == 0 || p->adc_fd == -1)  return 0;
 
+    // board type channels, one bus sweep (no header pattern read in between)
+    memset (value, 0, sizeof(value));
+    for (i = 0; i < eBOARD_END; i++)
+        pv[i] = value[i];
+    adcboard_batch_init (&batch, BoardAdcChan, eBOARD_END);
+    adcboard_batch_read (p->adc_fd, &batch, pv, cnt);
+
     // DC Jack 12V ~ 19V Check (2.4V ~ 3.8V)
-    adc_board_read (p->adc_fd, "P13.2", &value, &cnt);
-    if (value > 2000) {
-        adc_board_read (p->adc_fd, "P3.2", &value, &cnt);
-        p->channel = (value > 4000) ? NLP_SERVER_CHANNEL_RIGHT : NLP_SERVER_CHANNEL_LEFT;
+    if (value[eBOARD_DC_JACK][0] > 2000) {
+        p->channel = (value[eBOARD_CHANNEL][0] > 4000) ?
+                        NLP_SERVER_CHANNEL_RIGHT : NLP_SERVER_CHANNEL_LEFT;
 
         p->test_model = TEST_MODEL_NONE;
         // Test Model 8GB
-        adc_board_read (p->adc_fd, "P3.8", &value, &cnt);
-        if (value > 4000)
+        if (value[eBOARD_MODEL_4GB][0] > 4000)
             p->test_model = TEST_MODEL_4GB;
 
         // Test Model 16GB
-        adc_board_read (p->adc_fd, "P3.9", &value, &cnt);
-        if (value > 4000)
+        if (value[eBOARD_MODEL_8GB][0] > 4000)
             p->test_model = TEST_MODEL_8GB;
 
         return 1;
@@ -1082,60 +1229,91 @@ static int check_i2cadc (client_t *p)
 }
 
 //------------------------------------------------------------------------------
-static int check_server (client_t *p)
+// last confirmed server (boot partition), the port is the nlp_server_ctrl one
+#define NLP_SERVER_CACHE    "/boot/nlp_server.cache"
+
+//------------------------------------------------------------------------------
+// open port found : nlp_server_ctrl has no query message, the only messages
+// the server takes are the iperf control pair. "start" must be accepted and
+// "stop" is sent right after so the server is left as it was.
+//------------------------------------------------------------------------------
+static int confirm_server (const char *ip, int port)
 {
     char ip_addr [IP_ADDR_SIZE];
 
+    if (port != NLP_SERVER_PORT)
+        return 0;
+    snprintf (ip_addr, sizeof(ip_addr), "%s", ip);
+    if (!nlp_server_write (ip_addr, NLP_SERVER_MSG_TYPE_UDP, "start", 0))
+        return 0;
+    return nlp_server_write (ip_addr, NLP_SERVER_MSG_TYPE_UDP, "stop", 0) ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+static int check_server (client_t *p)
+{
+    char ip_addr [IP_ADDR_SIZE], my_ip [IP_ADDR_SIZE];
+    int found;
+
     memset (ip_addr, 0, sizeof(ip_addr));
 
-    m1_item [eITEM_BOARD_IP].status = m1_item [eITEM_SERVER_IP].status = eSTATUS_RUN;
-    ui_set_ritem (p->pfb, p->pui, m1_item [eITEM_BOARD_IP].ui_id, COLOR_YELLOW, -1);
+    item_set (eITEM_BOARD_IP,  eSTATUS_RUN, ITEM_KEEP);
+    item_set (eITEM_SERVER_IP, eSTATUS_RUN, ITEM_KEEP);
+    uif_set_ritem (p->pfb, p->pui, m1_item [eITEM_BOARD_IP].ui_id, COLOR_YELLOW, -1);
     if (get_my_ip (ip_addr)) {
-        ui_set_sitem (p->pfb, p->pui, m1_item [eITEM_BOARD_IP].ui_id, -1, -1, ip_addr);
-        ui_set_ritem (p->pfb, p->pui, m1_item [eITEM_BOARD_IP].ui_id, p->pui->bc.uint, -1);
-        m1_item [eITEM_BOARD_IP].result = eRESULT_PASS;
-        m1_item [eITEM_BOARD_IP].status = eSTATUS_STOP;
+        uif_set_sitem (p->pfb, p->pui, m1_item [eITEM_BOARD_IP].ui_id, -1, -1, ip_addr);
+        uif_set_ritem (p->pfb, p->pui, m1_item [eITEM_BOARD_IP].ui_id, p->pui->rc, -1);
+        item_set (eITEM_BOARD_IP, eSTATUS_STOP, eRESULT_PASS);
 
+        memcpy (my_ip, ip_addr, IP_ADDR_SIZE);
         memset (ip_addr, 0, sizeof(ip_addr));
 
-        ui_set_ritem (p->pfb, p->pui, m1_item [eITEM_SERVER_IP].ui_id, COLOR_YELLOW, -1);
-        if (nlp_server_find(ip_addr)) {
+        uif_set_ritem (p->pfb, p->pui, m1_item [eITEM_SERVER_IP].ui_id, COLOR_YELLOW, -1);
+        // cached server / parallel sweep first (cache updated there),
+        // nmap scan (nlp_server_find) fallback
+        found = discover_server (NLP_SERVER_CACHE, my_ip, NLP_SERVER_PORT, confirm_server, ip_addr);
+        if (!found && nlp_server_find(ip_addr) && confirm_server (ip_addr, NLP_SERVER_PORT)) {
+            discover_cache_write (NLP_SERVER_CACHE, ip_addr);
+            found = 1;
+        }
+        if (found) {
             memcpy (p->nlp_ip, ip_addr, IP_ADDR_SIZE);
-            ui_set_sitem (p->pfb, p->pui, m1_item [eITEM_SERVER_IP].ui_id, -1, -1, ip_addr);
-            ui_set_ritem (p->pfb, p->pui, m1_item [eITEM_SERVER_IP].ui_id, p->pui->bc.uint, -1);
-            m1_item [eITEM_SERVER_IP].result = eRESULT_PASS;
-            m1_item [eITEM_SERVER_IP].status = eSTATUS_STOP;
+            // results posted before the server was found
+            outbox_set_dst (p->outbox, p->nlp_ip);
+            uif_set_sitem (p->pfb, p->pui, m1_item [eITEM_SERVER_IP].ui_id, -1, -1, ip_addr);
+            uif_set_ritem (p->pfb, p->pui, m1_item [eITEM_SERVER_IP].ui_id, p->pui->rc, -1);
+            item_set (eITEM_SERVER_IP, eSTATUS_STOP, eRESULT_PASS);
             return 1;
         } else {
-            ui_set_ritem (p->pfb, p->pui, m1_item [eITEM_SERVER_IP].ui_id, COLOR_RED, -1);
+            uif_set_ritem (p->pfb, p->pui, m1_item [eITEM_SERVER_IP].ui_id, COLOR_RED, -1);
         }
     } else {
-        ui_set_ritem (p->pfb, p->pui, m1_item [eITEM_BOARD_IP].ui_id, COLOR_RED, -1);
+        uif_set_ritem (p->pfb, p->pui, m1_item [eITEM_BOARD_IP].ui_id, COLOR_RED, -1);
     }
 
     return 0;
 }
 
 //------------------------------------------------------------------------------
-static int check_device_audio (client_t *p)
+static int check_device_audio (client_t *p, int event)
 {
     if (!JackStatus)    return 0;
 
-    if (EventIR == eEVENT_HP_L) {
+    if (event == eEVENT_HP_L) {
         if (audio_check (eAUDIO_LEFT)) {
-            m1_item [eITEM_AUDIO_LEFT].result = eRESULT_PASS;
-            ui_set_sitem (p->pfb, p->pui, m1_item [eITEM_AUDIO_LEFT].ui_id, -1, -1, "PASS");
-            ui_set_ritem (p->pfb, p->pui, m1_item [eITEM_AUDIO_LEFT].ui_id, COLOR_GREEN, -1);
-            m1_item [eITEM_AUDIO_LEFT].status = eSTATUS_STOP;
+            item_set (eITEM_AUDIO_LEFT, ITEM_KEEP, eRESULT_PASS);
+            uif_set_sitem (p->pfb, p->pui, m1_item [eITEM_AUDIO_LEFT].ui_id, -1, -1, "PASS");
+            uif_set_ritem (p->pfb, p->pui, m1_item [eITEM_AUDIO_LEFT].ui_id, COLOR_GREEN, -1);
+            item_set (eITEM_AUDIO_LEFT, eSTATUS_STOP, ITEM_KEEP);
         }
         else return 0;
     }
-    if (EventIR == eEVENT_HP_R) {
+    if (event == eEVENT_HP_R) {
         if (audio_check (eAUDIO_RIGHT)) {
-            m1_item [eITEM_AUDIO_RIGHT].result = eRESULT_PASS;
-            ui_set_sitem (p->pfb, p->pui, m1_item [eITEM_AUDIO_RIGHT].ui_id, -1, -1, "PASS");
-            ui_set_ritem (p->pfb, p->pui, m1_item [eITEM_AUDIO_RIGHT].ui_id, COLOR_GREEN, -1);
-            m1_item [eITEM_AUDIO_RIGHT].status = eSTATUS_STOP;
+            item_set (eITEM_AUDIO_RIGHT, ITEM_KEEP, eRESULT_PASS);
+            uif_set_sitem (p->pfb, p->pui, m1_item [eITEM_AUDIO_RIGHT].ui_id, -1, -1, "PASS");
+            uif_set_ritem (p->pfb, p->pui, m1_item [eITEM_AUDIO_RIGHT].ui_id, COLOR_GREEN, -1);
+            item_set (eITEM_AUDIO_RIGHT, eSTATUS_STOP, ITEM_KEEP);
         }
         else return 0;
     }
@@ -1143,39 +1321,267 @@ static int check_device_audio (client_t *p)
 }
 
 //------------------------------------------------------------------------------
-static int client_setup (client_t *p)
+//
+// Test graph (core/sched). Every task declares its prerequisites and the worker
+// pool runs all the tasks that are ready.
+//
+//------------------------------------------------------------------------------
+#define SCHED_WORKER_CNT    4
+
+enum {
+    eTASK_HDMI,
+    eTASK_SYSTEM,
+    eTASK_SERVER,
+    eTASK_ETH_LINK,
+    eTASK_MAC,
+    eTASK_IPERF,
+    eTASK_DEVICE,
+    eTASK_ETH_SWITCH,
+    eTASK_I2CADC,
+    eTASK_SYSTEM_MODEL,
+    eTASK_SPIBT,
+    eTASK_ADC,
+    eTASK_HEADER,
+    eTASK_END
+};
+
+//------------------------------------------------------------------------------
+// retry tasks are done when all items pass or when the test time is over.
+//------------------------------------------------------------------------------
+static int task_hdmi (void *arg)
 {
-    pthread_t thread_hp_detect, thread_check_status;
-    pthread_t thread_usb, thread_storage, thread_ir;
+    check_device_hdmi ((client_t *)arg);
+    return (item_result (eITEM_EDID) && item_result (eITEM_HPD)) || !TimeoutStop;
+}
 
-    if ((p->pfb = fb_init (DEVICE_FB)) == NULL)         exit(1);
-    if ((p->pui = ui_init (p->pfb, CONFIG_UI)) == NULL) exit(1);
+//------------------------------------------------------------------------------
+static int task_system (void *arg)
+{
+    check_device_system ((client_t *)arg);
+    return 1;
+}
 
-    pthread_create (&thread_check_status, NULL, check_status, p);
+//------------------------------------------------------------------------------
+static int task_system_model (void *arg)
+{
+    check_device_system ((client_t *)arg);
+    return !TimeoutStop;
+}
 
-    check_device_hdmi(p);   check_device_system (p);
+//------------------------------------------------------------------------------
+static int task_server (void *arg)
+{
+    return check_server ((client_t *)arg);
+}
 
-    while (!check_server (p))   usleep (APP_LOOP_DELAY * 1000);
+//------------------------------------------------------------------------------
+static int task_eth_link (void *arg)
+{
+    client_t *p = (client_t *)arg;
 
     ethernet_link_setup (LINK_SPEED_1G);
 
-    ui_set_ritem (p->pfb, p->pui, m1_item [eITEM_ETHERNET_1G].ui_id,   RUN_BOX_ON, -1);
-    ui_set_ritem (p->pfb, p->pui, m1_item [eITEM_ETHERNET_100M].ui_id, RUN_BOX_ON, -1);
-    ui_set_sitem (p->pfb, p->pui, m1_item [eITEM_ETHERNET_LED].ui_id, -1, -1, "Orange");
+    uif_set_ritem (p->pfb, p->pui, m1_item [eITEM_ETHERNET_1G].ui_id,   RUN_BOX_ON, -1);
+    uif_set_ritem (p->pfb, p->pui, m1_item [eITEM_ETHERNET_100M].ui_id, RUN_BOX_ON, -1);
+    uif_set_sitem (p->pfb, p->pui, m1_item [eITEM_ETHERNET_LED].ui_id, -1, -1, "Orange");
 
-    ui_set_ritem (p->pfb, p->pui, m1_item [eITEM_AUDIO_LEFT].ui_id,  RUN_BOX_ON, -1);
-    ui_set_ritem (p->pfb, p->pui, m1_item [eITEM_AUDIO_RIGHT].ui_id, RUN_BOX_ON, -1);
+    uif_set_ritem (p->pfb, p->pui, m1_item [eITEM_AUDIO_LEFT].ui_id,  RUN_BOX_ON, -1);
+    uif_set_ritem (p->pfb, p->pui, m1_item [eITEM_AUDIO_RIGHT].ui_id, RUN_BOX_ON, -1);
+    return 1;
+}
 
-    check_mac_addr (p);
-    check_iperf_speed (p);
+//------------------------------------------------------------------------------
+static int task_mac (void *arg)
+{
+    check_mac_addr ((client_t *)arg);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+static int task_iperf (void *arg)
+{
+    check_iperf_speed ((client_t *)arg);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+static int task_device (void *arg)
+{
+    client_t *p = (client_t *)arg;
+    pthread_t thread_usb, thread_storage;
 
     pthread_create (&thread_storage,    NULL, check_device_storage, p);
-    pthread_create (&thread_hp_detect,  NULL, check_hp_detect, p);
-    pthread_create (&thread_ir,         NULL, check_device_ir, p);
     pthread_create (&thread_usb,        NULL, check_device_usb, p);
 
+    check_hp_detect_init (p, DEVICE_HP);
+    check_device_ir_init (p, DEVICE_IR);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// ethernet speed toggle (IR keys) only after the throughput test
+//------------------------------------------------------------------------------
+static int task_eth_switch (void *arg)
+{
+    client_t *p = (client_t *)arg;
+
     // ethernet switch enable
     p->eth_switch = 1;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+static int task_i2cadc (void *arg)
+{
+    return check_i2cadc ((client_t *)arg);
+}
+
+//------------------------------------------------------------------------------
+static int task_spibt (void *arg)
+{
+    check_spibt_init ((client_t *)arg);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+static int task_adc (void *arg)
+{
+    check_device_adc ((client_t *)arg);
+    return (item_result (eITEM_ADC37) && item_result (eITEM_ADC40)) || !TimeoutStop;
+}
+
+//------------------------------------------------------------------------------
+static int task_header (void *arg)
+{
+    int i, pass = 0;
+
+    check_header ((client_t *)arg);
+    for (i = 0; i < eHEADER_END; i++)
+        if (item_result (eITEM_HEADER_PT1 + i))   pass++;
+
+    return (pass == eHEADER_END) || !TimeoutStop;
+}
+
+//------------------------------------------------------------------------------
+// IR event handlers (evq consumer threads)
+//------------------------------------------------------------------------------
+// link speed changes and the iperf retry share one consumer : a link change
+// must never run in the middle of the throughput test.
+//------------------------------------------------------------------------------
+static void event_network (const struct evq_msg *m, void *arg)
+{
+    client_t *p = (client_t *)arg;
+
+    switch (m->event) {
+        case eEVENT_ETH_GLED:   case eEVENT_ETH_OLED:
+            check_device_ethernet (p, m->event);
+            break;
+        case eEVENT_ENTER:
+            if (p->sched && sched_is_done (p->sched, eTASK_IPERF) && !item_result (eITEM_IPERF))
+                check_iperf_speed (p);
+            break;
+        default:
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+static void event_audio (const struct evq_msg *m, void *arg)
+{
+    check_device_audio ((client_t *)arg, m->event);
+}
+
+
+//------------------------------------------------------------------------------
+static int client_setup (client_t *p)
+{
+    pthread_t thread_check_status;
+    fb_info_t *fb;
+    sched_t *s;
+    int i;
+
+    // item state before any test thread
+    if ((M1State = itemstate_init (eITEM_END, eSTATUS_WAIT, eRESULT_FAIL, eSTATUS_STOP)) == NULL)
+        exit(1);
+    for (i = 0; i < eITEM_END; i++)
+        item_set (i, m1_item[i].init_status, m1_item[i].init_result);
+
+    // no trace : tests run without it
+    if ((M1Trace = trace_init (TRACE_DEPTH_DEF, eSTATUS_RUN, eSTATUS_STOP)) != NULL) {
+        for (i = 0; i < eITEM_END; i++)
+            M1TraceName[i] = m1_item[i].name;
+        trace_set_names (M1Trace, M1TraceName, eITEM_END);
+        itemstate_trace (M1State, M1Trace);
+    }
+
+    if ((fb = fb_init (DEVICE_FB)) == NULL) {
+        printf ("%s : %s not found, headless ui\n", __func__, DEVICE_FB);
+        if ((fb = fb_mem_init (HEADLESS_FB_W, HEADLESS_FB_H, HEADLESS_FB_BPP)) == NULL)
+            exit(1);
+    }
+    if ((p->layout = layout_load (CONFIG_LAYOUT, CONFIG_UI, fb->w, fb->h)) == NULL)
+        exit(1);
+    fb->is_bgr = p->layout->hdr->cfg.is_bgr;
+    // ui items from the layout, rendered into the back buffer (render thread),
+    // dirty items are presented to fb
+    if ((p->pfb = uif_init (fb, p->layout)) == NULL)    exit(1);
+    if ((p->pui = uidraw_init (p->layout)) == NULL)     exit(1);
+    if (!uif_start (p->pui))                            exit(1);
+
+    // server messages posted before the server is found, sent by the
+    // outbox thread (callers do not wait for the network).
+    // No batch writer : nlp_server_ctrl has only the per message
+    // nlp_server_write, a batch is sent one message at a time. A persistent
+    // pipelined writer (outbox_set_batch) needs a connection api there.
+    if ((p->outbox = outbox_init (nlp_server_write)) == NULL)   exit(1);
+    if (!outbox_start (p->outbox))                      exit(1);
+
+    pthread_create (&thread_check_status, NULL, check_status, p);
+
+    // IR key events : slow handlers on their own thread, the rest on main
+    if ((p->evq = evq_init ()) == NULL)                 exit(1);
+    evq_add (p->evq, EVQ_EVENT(eEVENT_ETH_GLED) | EVQ_EVENT(eEVENT_ETH_OLED) |
+             EVQ_EVENT(eEVENT_ENTER), EVENT_QUEUE_DEPTH, event_network, p);
+    evq_add (p->evq, EVQ_EVENT(eEVENT_HP_L) | EVQ_EVENT(eEVENT_HP_R),
+             EVENT_QUEUE_DEPTH, event_audio, p);
+    p->evq_main = evq_add (p->evq, EVQ_EVENT(eEVENT_MAC_PRINT) | EVQ_EVENT(eEVENT_STOP) |
+                           EVQ_EVENT(eEVENT_BACK), EVENT_QUEUE_DEPTH, NULL, NULL);
+    if ((p->evq_main < 0) || !evq_start (p->evq))       exit(1);
+
+    // event loop (input devices, timers, device node hotplug)
+    if ((p->reactor = reactor_init ()) == NULL)         exit(1);
+    hotplug_set_filter (hotplug_filter);
+    reactor_add_fd (p->reactor, hotplug_init ("/dev"), hotplug_event, NULL);
+    reactor_start  (p->reactor);
+
+    if ((s = sched_init (SCHED_WORKER_CNT, p)) == NULL)  exit(1);
+
+    // id, name, func, prerequisites, retry period(ms)
+    sched_add (s, eTASK_HDMI,     "hdmi",     task_hdmi,     0, APP_LOOP_DELAY);
+    sched_add (s, eTASK_SYSTEM,   "system",   task_system,   0, 0);
+    sched_add (s, eTASK_SERVER,   "server",   task_server,   0, APP_LOOP_DELAY);
+
+    // local tests do not wait for the server, its messages go to the outbox
+    sched_add (s, eTASK_DEVICE,   "device",   task_device,   0, 0);
+    sched_add (s, eTASK_ETH_LINK, "eth-link", task_eth_link, 0, 0);
+    sched_add (s, eTASK_MAC,      "mac",      task_mac,      SCHED_DEP(eTASK_ETH_LINK), 0);
+    sched_add (s, eTASK_IPERF,    "iperf",    task_iperf,
+                                  SCHED_DEP(eTASK_MAC) | SCHED_DEP(eTASK_SERVER), 0);
+    sched_add (s, eTASK_ETH_SWITCH, "eth-switch", task_eth_switch, SCHED_DEP(eTASK_IPERF), 0);
+
+    // board memory must be read once before the test model is known (i2cadc).
+    sched_add (s, eTASK_I2CADC,   "i2cadc",   task_i2cadc,   SCHED_DEP(eTASK_SYSTEM), 1000);
+    sched_add (s, eTASK_SYSTEM_MODEL, "system-model", task_system_model,
+                                              SCHED_DEP(eTASK_I2CADC), APP_LOOP_DELAY);
+    sched_add (s, eTASK_SPIBT,    "spibt",    task_spibt,    SCHED_DEP(eTASK_I2CADC), 0);
+    sched_add (s, eTASK_ADC,      "adc",      task_adc,      SCHED_DEP(eTASK_I2CADC), APP_LOOP_DELAY);
+    sched_add (s, eTASK_HEADER,   "header",   task_header,   SCHED_DEP(eTASK_I2CADC), APP_LOOP_DELAY);
+    // ADC37/40 are header pins 37/40, the header pattern must not drive them
+    // while the SoC ADC samples. Both keep retrying, never at the same time.
+    sched_exclude (s, eTASK_ADC, eTASK_HEADER);
+
+    p->sched = s;
+    sched_start (s);
 
     return 1;
 }
@@ -1184,57 +1590,40 @@ static int client_setup (client_t *p)
 int main (void)
 {
     client_t client;
-    pthread_t thread_spibt;
+    struct evq_msg m;
 
     memset (&client, 0, sizeof(client));
 
-    // UI
+    // UI, test graph
     client_setup (&client);
 
-    while (!check_i2cadc(&client))  sleep (1);
-    check_device_system (&client);
-
-    pthread_create (&thread_spibt, NULL, check_spibt, &client);
-
     while (1)   {
-        // retry
-        check_device_hdmi   (&client);
-        check_device_system (&client);
-        check_device_adc    (&client);
-        check_header        (&client);
-        usleep (APP_LOOP_DELAY * 1000);
-
-        if (EventIR != eEVENT_NONE) {
-            switch (EventIR) {
-                case eEVENT_ETH_GLED:
-                case eEVENT_ETH_OLED:
-                    check_device_ethernet (&client);
-                    break;
-                case eEVENT_HP_L:
-                case eEVENT_HP_R:
-                    check_device_audio (&client);
-                    break;
-                case eEVENT_MAC_PRINT:
-                    if (m1_item [eITEM_MAC_ADDR].result)
-                        nlp_server_write (client.nlp_ip, NLP_SERVER_MSG_TYPE_MAC, client.mac, client.channel);
-                    break;
-                case eEVENT_STOP:
-                    TimeoutStop = 0;
-                    break;
-                case eEVENT_ENTER:
-                    if (!m1_item [eITEM_IPERF].result)
-                        check_iperf_speed (&client);
-                    break;
-                case eEVENT_BACK:
-                    printf ("Program restart!!\n"); fflush(stdout);
-
+        if (!evq_get (client.evq, client.evq_main, &m, -1))
+            continue;
+
+        switch (m.event) {
+            case eEVENT_MAC_PRINT:
+                if (item_result (eITEM_MAC_ADDR))
+                    outbox_post (client.outbox, NLP_SERVER_MSG_TYPE_MAC, client.mac, client.channel);
+                break;
+            case eEVENT_STOP:
+                TimeoutStop = 0;
+                break;
+            case eEVENT_BACK:
+                printf ("Program restart!!\n"); fflush(stdout);
+
+                // messages still queued for the server
+                if (!outbox_wait (client.outbox, APP_LOOP_DELAY))
+                    printf ("%d server messages not sent\n", outbox_pending (client.outbox));
+
+                // stop the ui renderer, draw on the display directly
+                if ((client.pfb = uif_close ()) != NULL) {
                     fb_clear  (client.pfb);
                     draw_text (client.pfb, 1920/4, 1080/2, COLOR_RED, COLOR_BLACK, 5, "- APPLICATION RESTART -");
-                    return 0;
-                default :
-                    break;
-            }
-            EventIR = eEVENT_NONE;
+                }
+                return 0;
+            default :
+                break;
         }
     }
 
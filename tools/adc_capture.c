@@ -0,0 +1,286 @@
+//------------------------------------------------------------------------------
+/**
+ * @file adc_capture.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Header ADC buffered capture test for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * usage : adc_capture [-r root] [-n samples]
+ *          a fake iio device (scan_elements, buffer, in_voltageN_raw) is made
+ *          under the sysattr root (default : temp dir) and a recorded sample
+ *          feed is written to <root>/dev/iio:device0.
+ *          the temp dir is removed at exit (a -r root is kept).
+ *          adc_capture must return the mean/min/max/stddev of the feed,
+ *          fall back to sysfs single-shot without a scan type, put the scan
+ *          element enables back as they were, and adc_check must pass/fail
+ *          on the selected statistic.
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+//------------------------------------------------------------------------------
+#include "../check_device/adc.h"
+#include "../check_device/sysattr.h"
+
+//------------------------------------------------------------------------------
+#define IIO_DIR     "/sys/bus/iio/devices/iio:device0"
+#define IIO_NODE    "/dev/iio:device0"
+
+// scan elements of the fake device and the enables before the test
+static const char *ScanEn [][2] = {
+    { "in_voltage0_en", "1\n" },
+    { "in_voltage1_en", "0\n" },
+    { "in_voltage6_en", "0\n" },
+    { "in_voltage7_en", "0\n" },
+    { "in_timestamp_en", "1\n" },
+};
+#define SCAN_EN_CNT     (int)(sizeof(ScanEn) / sizeof(ScanEn[0]))
+
+static char Root [PATH_MAX];
+
+//------------------------------------------------------------------------------
+static int file_write (const char *rel, const void *data, int len)
+{
+    char path[PATH_MAX], *p;
+    int fd, ret;
+
+    snprintf (path, sizeof(path), "%s%s", Root, rel);
+    for (p = strchr (path + strlen (Root) + 1, '/'); p; p = strchr (p + 1, '/')) {
+        *p = 0;
+        mkdir (path, 0755);
+        *p = '/';
+    }
+    // truncate in place, the open sysattr handles see the new data
+    if ((fd = open (path, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0)
+        return 0;
+    ret = (write (fd, data, len) == len);
+    close (fd);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+static int file_read (const char *rel, char *buf, int size)
+{
+    char path[PATH_MAX];
+    int fd, ret;
+
+    snprintf (path, sizeof(path), "%s%s", Root, rel);
+    memset (buf, 0, size);
+    if ((fd = open (path, O_RDONLY)) < 0)
+        return 0;
+    ret = read (fd, buf, size -1);
+    close (fd);
+    return ret > 0;
+}
+
+//------------------------------------------------------------------------------
+// files first, then the directories (depth first). return 1 = removed
+//------------------------------------------------------------------------------
+static int tree_remove (const char *path)
+{
+    char sub[PATH_MAX];
+    struct dirent *e;
+    struct stat st;
+    DIR *d;
+
+    if (lstat (path, &st) < 0)
+        return 0;
+    if (S_ISDIR (st.st_mode)) {
+        if ((d = opendir (path)) == NULL)
+            return 0;
+        while ((e = readdir (d)) != NULL) {
+            if (!strcmp (e->d_name, ".") || !strcmp (e->d_name, ".."))
+                continue;
+            snprintf (sub, sizeof(sub), "%s/%s", path, e->d_name);
+            tree_remove (sub);
+        }
+        closedir (d);
+    }
+    return remove (path) ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+static void fake_device (void)
+{
+    char rel[PATH_MAX];
+    int i;
+
+    for (i = 0; i < SCAN_EN_CNT; i++) {
+        snprintf (rel, sizeof(rel), "%s/scan_elements/%s", IIO_DIR, ScanEn[i][0]);
+        file_write (rel, ScanEn[i][1], strlen (ScanEn[i][1]));
+    }
+    file_write (IIO_DIR "/scan_elements/in_voltage7_type", "le:u10/16>>0\n", 13);
+    file_write (IIO_DIR "/scan_elements/in_voltage6_type", "be:u10/16>>2\n", 13);
+    file_write (IIO_DIR "/buffer/enable", "0\n", 2);
+    file_write (IIO_DIR "/buffer/length", "2\n", 2);
+    // single-shot value (sysfs fallback) : 775 = 1362 mV, 255 = 448 mV
+    file_write (IIO_DIR "/in_voltage7_raw", "775\n", 4);
+    file_write (IIO_DIR "/in_voltage6_raw", "255\n", 4);
+}
+
+//------------------------------------------------------------------------------
+// recorded feed : raw = base + noise pattern, encoded like the scan type.
+// the expected stats are calculated from the same mV values.
+//------------------------------------------------------------------------------
+static void feed_write (int raw_base, int noise, int be, int shift, int cnt,
+                        struct adc_stats *ref)
+{
+    unsigned char buf[ADC_SAMPLES_MAX * 2];
+    long long sum = 0, sq = 0;
+    int i, raw, mv, v;
+
+    memset (ref, 0, sizeof(struct adc_stats));
+    ref->min = INT_MAX;     ref->max = INT_MIN;
+    for (i = 0; i < cnt; i++) {
+        raw = raw_base + ((i * 13) % (2 * noise + 1)) - noise;
+        v   = raw << shift;
+        buf[i * 2 + (be ? 0 : 1)] = (v >> 8) & 0xFF;
+        buf[i * 2 + (be ? 1 : 0)] = v & 0xFF;
+
+        mv   = (raw * 1800) / 1024;
+        sum += mv;
+        if (mv < ref->min)  ref->min = mv;
+        if (mv > ref->max)  ref->max = mv;
+    }
+    ref->cnt  = cnt;
+    ref->mean = (int)(sum / cnt);
+    for (i = 0; i < cnt; i++) {
+        raw = raw_base + ((i * 13) % (2 * noise + 1)) - noise;
+        mv  = (raw * 1800) / 1024;
+        sq += (long long)(mv - ref->mean) * (mv - ref->mean);
+    }
+    // floor (sqrt (variance))
+    for (sq /= cnt; (long long)(ref->stddev + 1) * (ref->stddev + 1) <= sq; ref->stddev++)
+        ;
+    file_write (IIO_NODE, buf, cnt * 2);
+}
+
+//------------------------------------------------------------------------------
+// scan element enables and buffer enable as before the capture
+//------------------------------------------------------------------------------
+static int check_restore (const char *name)
+{
+    char rel[PATH_MAX], buf[16];
+    int i, err = 0;
+
+    for (i = 0; i < SCAN_EN_CNT; i++) {
+        snprintf (rel, sizeof(rel), "%s/scan_elements/%s", IIO_DIR, ScanEn[i][0]);
+        if (!file_read (rel, buf, sizeof(buf)) || (atoi (buf) != atoi (ScanEn[i][1]))) {
+            printf ("%-10s : %s = %s, expected %s", name, ScanEn[i][0], buf, ScanEn[i][1]);
+            err++;
+        }
+    }
+    if (!file_read (IIO_DIR "/buffer/enable", buf, sizeof(buf)) || atoi (buf)) {
+        printf ("%-10s : buffer/enable not off\n", name);
+        err++;
+    }
+    return err;
+}
+
+//------------------------------------------------------------------------------
+static int check_capture (const char *name, int id, int samples, int buffered,
+                          const struct adc_stats *ref)
+{
+    struct adc_stats st;
+    int err = 0;
+
+    adc_capture (id, samples, &st);
+    printf ("%-10s : %s %d samples, mean %d, min %d, max %d, stddev %d mV\n",
+            name, st.buffered ? "buffer" : "sysfs", st.cnt, st.mean, st.min, st.max, st.stddev);
+
+    if ((st.buffered != buffered) || (st.cnt != ref->cnt) || (st.mean != ref->mean) ||
+        (st.min != ref->min) || (st.max != ref->max) || (abs (st.stddev - ref->stddev) > 1)) {
+        printf ("%-10s : expected %d samples, mean %d, min %d, max %d, stddev %d mV\n",
+                name, ref->cnt, ref->mean, ref->min, ref->max, ref->stddev);
+        err++;
+    }
+    return err + check_restore (name);
+}
+
+//------------------------------------------------------------------------------
+static int check_result (const char *name, int ret, int expect_pass)
+{
+    printf ("%-10s : adc_check %d, %s\n", name, ret, (!!ret == expect_pass) ? "ok" : "FAIL");
+    return (!!ret == expect_pass) ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+int main (int argc, char **argv)
+{
+    struct adc_stats ref;
+    int opt, samples = ADC_SAMPLES_DEF, tmp = 1, err = 0;
+
+    while ((opt = getopt (argc, argv, "r:n:")) != -1) {
+        switch (opt) {
+            case 'r':   strncpy (Root, optarg, sizeof(Root) -1);  tmp = 0;  break;
+            case 'n':   samples = atoi (optarg);                            break;
+            default:
+                printf ("usage : %s [-r root] [-n samples]\n", argv[0]);
+                return 1;
+        }
+    }
+    if ((samples < 2) || (samples > ADC_SAMPLES_MAX))
+        return 1;
+    if (tmp) {
+        strcpy (Root, "/tmp/adc_capture.XXXXXX");
+        if (mkdtemp (Root) == NULL)
+            return 1;
+    }
+    fake_device ();
+    sysattr_set_root (Root);
+
+    // H37 le:u10/16>>0, 1362 mV +- 5 raw
+    feed_write (775, 5, 0, 0, samples, &ref);
+    err += check_capture ("H37", eADC_H37, samples, 1, &ref);
+
+    // H40 be:u10/16>>2, 448 mV +- 3 raw
+    feed_write (255, 3, 1, 2, samples, &ref);
+    err += check_capture ("H40", eADC_H40, samples, 1, &ref);
+
+    // short feed : the samples that are there
+    feed_write (775, 2, 0, 0, samples / 2, &ref);
+    err += check_capture ("short", eADC_H37, samples, 1, &ref);
+
+    // pass/fail statistic : mean inside, one sample outside the range
+    feed_write (775, 20, 0, 0, samples, &ref);
+    adc_set_stat (eADC_STAT_MEAN, samples, 0);
+    err += check_result ("mean", adc_check (eADC_H37), 1);
+    adc_set_stat (eADC_STAT_ALL, samples, 0);
+    err += check_result ("all", adc_check (eADC_H37), 0);
+    adc_set_stat (eADC_STAT_MEAN, samples, ref.stddev - 1);
+    err += check_result ("stddev", adc_check (eADC_H37), 0);
+    adc_set_stat (eADC_STAT_MEAN, samples, 0);
+
+    // no scan type (no buffer support) : sysfs single-shot
+    file_write (IIO_DIR "/scan_elements/in_voltage7_type", "", 0);
+    memset (&ref, 0, sizeof(ref));
+    ref.cnt = samples;
+    ref.mean = ref.min = ref.max = (775 * 1800) / 1024;
+    err += check_capture ("sysfs", eADC_H37, samples, 0, &ref);
+
+    sysattr_close_all ();
+    if (tmp && !tree_remove (Root)) {
+        printf ("root : %s not removed\n", Root);
+        err++;
+    }
+    printf ("%s\n", err ? "FAIL" : "PASS");
+    return err ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
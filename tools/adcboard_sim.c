@@ -0,0 +1,210 @@
+//------------------------------------------------------------------------------
+/**
+ * @file adcboard_sim.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief I2C ADC board batch read test (simulated backend) for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * usage : adcboard_sim [-t threads] [-n reads]
+ *          the simulated backend is loaded from a generated M1 value table
+ *          ("NAME value ..." per line, temp file).
+ *          batch init must resolve the known names only, batch/single reads
+ *          must return the table values, and concurrent sweeps must never
+ *          see a channel half updated by adcboard_sim_set.
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+//------------------------------------------------------------------------------
+#include "../check_device/adcboard.h"
+
+//------------------------------------------------------------------------------
+// board type channels of check_i2cadc (main.c) and the header connector
+static const char * const BoardChan [] = { "P13.2", "P3.2", "P3.8", "P3.9" };
+static const int          BoardMv   [] = { 2400, 4100, 100, 4200 };
+#define BOARD_CHAN_CNT  4
+
+#define CON1_PIN_CNT    40
+
+static int          Reads = 10000;
+static atomic_int   Stop;
+
+//------------------------------------------------------------------------------
+static int sim_file (char *fname)
+{
+    FILE *fp;
+    int fd, i;
+
+    strcpy (fname, "/tmp/adcboard_sim.XXXXXX");
+    if (((fd = mkstemp (fname)) < 0) || ((fp = fdopen (fd, "w")) == NULL))
+        return 0;
+
+    fprintf (fp, "# M1 adc board (check_i2cadc, check_header)\n");
+    for (i = 0; i < BOARD_CHAN_CNT; i++)
+        fprintf (fp, "%s %d\n", BoardChan[i], BoardMv[i]);
+    fprintf (fp, "CON1");
+    for (i = 0; i < CON1_PIN_CNT; i++)
+        fprintf (fp, " %d", (i & 1) ? 3300 : 0);
+    fprintf (fp, "\n");
+    fclose (fp);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+static int test_batch (int fd)
+{
+    static const char * const names [] = { "P13.2", "P3.2", "P3.8", "P3.9", "NONE" };
+    int value [5][ADC_CHAN_VALUE_MAX], *pv [5], cnt [5], i, err = 0;
+    adc_batch_t b;
+
+    for (i = 0; i < 5; i++)
+        pv[i] = value[i];
+
+    // unknown names are not resolved, the others are read in the sweep
+    if (adcboard_batch_init (&b, names, 5) != 4)
+        err++;
+    if (adcboard_batch_read (fd, &b, pv, cnt) != 4)
+        err++;
+    if (cnt[4] != 0)
+        err++;
+    for (i = 0; i < BOARD_CHAN_CNT; i++) {
+        if ((cnt[i] != 1) || (value[i][0] != BoardMv[i])) {
+            printf ("batch : %s = %d, expected %d\n", BoardChan[i], value[i][0], BoardMv[i]);
+            err++;
+        }
+    }
+    // batch size limit
+    if (adcboard_batch_init (&b, names, ADC_BATCH_MAX + 1) || adcboard_batch_init (&b, names, 0))
+        err++;
+
+    printf ("batch read    : %s\n", err ? "FAIL" : "PASS");
+    return err;
+}
+
+//------------------------------------------------------------------------------
+static int test_single (int fd)
+{
+    int value [ADC_CHAN_VALUE_MAX], cnt = 0, i, err = 0;
+
+    if (!adcboard_read (fd, "CON1", value, &cnt) || (cnt != CON1_PIN_CNT))
+        err++;
+    for (i = 0; i < cnt; i++)
+        if (value[i] != ((i & 1) ? 3300 : 0))
+            err++;
+    if (adcboard_read (fd, "NONE", value, &cnt) || cnt)
+        err++;
+
+    printf ("single read   : %d values, %s\n", cnt, err ? "FAIL" : "PASS");
+    return err;
+}
+
+//------------------------------------------------------------------------------
+// CON1 rewritten with one generation number in every value
+//------------------------------------------------------------------------------
+static void *writer_thread (void *arg)
+{
+    int value [CON1_PIN_CNT], gen, i;
+
+    for (gen = 1; !atomic_load (&Stop); gen++) {
+        for (i = 0; i < CON1_PIN_CNT; i++)
+            value[i] = gen;
+        adcboard_sim_set ("CON1", value, CON1_PIN_CNT);
+    }
+    return arg;
+}
+
+//------------------------------------------------------------------------------
+static void *reader_thread (void *arg)
+{
+    static const char * const names [] = { "CON1", "P13.2" };
+    int value [2][ADC_CHAN_VALUE_MAX], *pv [2] = { value[0], value[1] }, cnt [2];
+    int fd = *(int *)arg, r, i;
+    adc_batch_t b;
+    long err = 0;
+
+    adcboard_batch_init (&b, names, 2);
+    for (r = 0; r < Reads; r++) {
+        adcboard_batch_read (fd, &b, pv, cnt);
+        for (i = 1; i < cnt[0]; i++)
+            if (value[0][i] != value[0][0])
+                err++;
+        if ((cnt[1] != 1) || (value[1][0] != BoardMv[0]))
+            err++;
+    }
+    return (void *)err;
+}
+
+//------------------------------------------------------------------------------
+static int test_concurrent (int fd, int threads)
+{
+    pthread_t w, th [16];
+    void *ret;
+    long err = 0;
+    int i;
+
+    atomic_store (&Stop, 0);
+    pthread_create (&w, NULL, writer_thread, NULL);
+    for (i = 0; i < threads; i++)
+        pthread_create (&th[i], NULL, reader_thread, &fd);
+    for (i = 0; i < threads; i++) {
+        pthread_join (th[i], &ret);
+        err += (long)ret;
+    }
+    atomic_store (&Stop, 1);
+    pthread_join (w, NULL);
+
+    printf ("concurrent    : %d threads x %d sweeps, %ld torn, %s\n",
+            threads, Reads, err, err ? "FAIL" : "PASS");
+    return err ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+int main (int argc, char **argv)
+{
+    char fname [64];
+    int opt, threads = 4, fd, cnt, err = 0;
+
+    while ((opt = getopt (argc, argv, "t:n:")) != -1) {
+        switch (opt) {
+            case 't':   threads = atoi (optarg);    break;
+            case 'n':   Reads   = atoi (optarg);    break;
+            default:
+                printf ("usage : %s [-t threads] [-n reads]\n", argv[0]);
+                return 1;
+        }
+    }
+    if ((threads <= 0) || (threads > 16) || (Reads <= 0))
+        return 1;
+    if (!sim_file (fname))
+        return 1;
+
+    cnt = adcboard_sim_init (fname);
+    fd  = adcboard_init ("gpio,scl,109,sda,110");
+    printf ("sim table     : %s, %d channels, fd %d\n", fname, cnt, fd);
+    if ((cnt != BOARD_CHAN_CNT + 1) || (fd == 0) || (fd == -1))
+        err++;
+
+    err += test_batch  (fd);
+    err += test_single (fd);
+    err += test_concurrent (fd, threads);
+
+    unlink (fname);
+    printf ("%s\n", err ? "FAIL" : "PASS");
+    return err ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,130 @@
+//------------------------------------------------------------------------------
+/**
+ * @file blk_bench.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Storage benchmark engine test on a file or loop image for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * usage : blk_bench [-b bs_kb] [-q qd] [-s size_mb] [-r] [path]
+ *          path : regular file or loop image (default /var/tmp/blk_bench.img,
+ *                 created and removed). The write pass fills the target,
+ *                 the read pass reads it back (-r : read only, existing target),
+ *                 then the same target runs through storage_bench().
+ *
+ *          truncate -s 64M /tmp/disk.img && losetup -f --show /tmp/disk.img
+ *          blk_bench -q 8 /dev/loop0
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <errno.h>
+
+//------------------------------------------------------------------------------
+#include "../check_device/blkbench.h"
+#include "../check_device/storage.h"
+
+//------------------------------------------------------------------------------
+#define DEFAULT_PATH    "/var/tmp/blk_bench.img"
+
+//------------------------------------------------------------------------------
+static int report (const char *name, const struct bench_cfg *cfg, int value,
+                   const struct bench_result *r)
+{
+    int err = 0;
+
+    printf ("%-8s : %5d MB/s, %6d iops, lat min/p50/p95/p99/max %d/%d/%d/%d/%d us, %s\n",
+            name, r->mbps, r->iops, r->lat_min, r->lat_p50, r->lat_p95, r->lat_p99,
+            r->lat_max, r->direct ? "O_DIRECT" : "buffered");
+
+    // every block transferred, stats consistent
+    if (r->err) {
+        printf ("%-8s : error %s\n", name, strerror (r->err));
+        err++;
+    }
+    if (r->bytes != cfg->size) {
+        printf ("%-8s : %lld of %lld bytes\n", name, r->bytes, cfg->size);
+        err++;
+    }
+    if ((r->lat_min > r->lat_p50) || (r->lat_p50 > r->lat_p95) ||
+        (r->lat_p95 > r->lat_p99) || (r->lat_p99 > r->lat_max)) {
+        printf ("%-8s : latency percentiles out of order\n", name);
+        err++;
+    }
+    if (!value || (value != r->mbps)) {
+        printf ("%-8s : return %d, mbps %d\n", name, value, r->mbps);
+        err++;
+    }
+    printf ("%-8s : %s\n", name, err ? "FAIL" : "PASS");
+    return err;
+}
+
+//------------------------------------------------------------------------------
+int main (int argc, char **argv)
+{
+    struct bench_cfg cfg;
+    struct bench_result r;
+    const char *path = DEFAULT_PATH;
+    int opt, bs = BENCH_DEFAULT_BS, qd = BENCH_DEFAULT_QD, read_only = 0, err = 0, value;
+    long long size = BENCH_DEFAULT_SIZE;
+
+    while ((opt = getopt (argc, argv, "b:q:s:r")) != -1) {
+        switch (opt) {
+            case 'b':   bs   = atoi (optarg) * 1024;                break;
+            case 'q':   qd   = atoi (optarg);                       break;
+            case 's':   size = atoll (optarg) * 1024 * 1024;        break;
+            case 'r':   read_only = 1;                              break;
+            default :
+                printf ("usage : %s [-b bs_kb] [-q qd] [-s size_mb] [-r] [path]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (optind < argc)
+        path = argv[optind];
+
+    printf ("%s : bs %d KB, qd %d, %lld MB\n", path, bs / 1024, qd, size / (1024 * 1024));
+
+    if (!read_only) {
+        blkbench_default (&cfg, path, eBENCH_WRITE);
+        cfg.bs = bs;    cfg.qd = qd;    cfg.size = size;
+        value = blkbench_run (&cfg, &r);
+        err += report ("write", &cfg, value, &r);
+    }
+
+    // read back (cache dropped by O_DIRECT or fadvise)
+    blkbench_default (&cfg, path, eBENCH_READ);
+    cfg.bs = bs;    cfg.qd = qd;    cfg.size = size;
+    value = blkbench_run (&cfg, &r);
+    err += report ("read", &cfg, value, &r);
+
+    // jig path : storage id pointed at the target (default 16 MB transfer)
+    if (size >= BENCH_DEFAULT_SIZE) {
+        if (!storage_set_path (eSTORAGE_eMMC, path)) {
+            printf ("storage : %s set path error\n", path);
+            err++;
+        } else {
+            value = storage_bench (eSTORAGE_eMMC, &r);
+            printf ("storage : eMMC -> %s, %d MB/s (%s the eMMC limit), %s\n", path, r.mbps,
+                    value ? "above" : "below", (!r.err && r.bytes) ? "PASS" : "FAIL");
+            if (r.err || !r.bytes)
+                err++;
+        }
+    }
+
+    if (!read_only && (optind >= argc))
+        unlink (path);
+
+    return err ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,132 @@
+//------------------------------------------------------------------------------
+/**
+ * @file blkpool_quiet.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Benchmark pool quiet gate test (iperf exclusion) for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * usage : blkpool_quiet [-j jobs] [-m run_ms]
+ *          stand-in measures (sleep run_ms) run on the bench pool.
+ *          bench_pool_quiet_enter must return only after the running
+ *          measures are done, measures started inside the quiet section
+ *          (iperf) must not run before bench_pool_quiet_leave, and then
+ *          every one of them must run.
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <stdatomic.h>
+
+//------------------------------------------------------------------------------
+#include "../check_device/blkpool.h"
+
+//------------------------------------------------------------------------------
+static int          RunMs = 200;
+static atomic_int   InQuiet, Started, Overlap;
+
+//------------------------------------------------------------------------------
+static int fake_run (int dev_id, struct bench_result *r)
+{
+    atomic_fetch_add (&Started, 1);
+    if (atomic_load (&InQuiet))
+        atomic_fetch_add (&Overlap, 1);
+    usleep (RunMs * 1000);
+    if (atomic_load (&InQuiet))
+        atomic_fetch_add (&Overlap, 1);
+    memset (r, 0, sizeof(struct bench_result));
+    return dev_id + 1;
+}
+
+//------------------------------------------------------------------------------
+static int jobs_start (struct bench_job *jobs, int cnt)
+{
+    int i, ret = 0;
+
+    for (i = 0; i < cnt; i++) {
+        jobs[i].id  = jobs[i].dev_id = i;
+        jobs[i].run = fake_run;
+        jobs[i].value = 0;
+        ret += bench_pool_start (&jobs[i], NULL, NULL);
+    }
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+static void jobs_wait (struct bench_job *jobs, int cnt)
+{
+    int i;
+
+    for (i = 0; i < cnt; i++)
+        while (atomic_load (&jobs[i].busy))
+            usleep (1000);
+}
+
+//------------------------------------------------------------------------------
+int main (int argc, char **argv)
+{
+    static struct bench_job before [BENCH_POOL_MAX], inside [BENCH_POOL_MAX];
+    int opt, cnt = 4, i, err = 0;
+
+    while ((opt = getopt (argc, argv, "j:m:")) != -1) {
+        switch (opt) {
+            case 'j':   cnt   = atoi (optarg);  break;
+            case 'm':   RunMs = atoi (optarg);  break;
+            default:
+                printf ("usage : %s [-j jobs] [-m run_ms]\n", argv[0]);
+                return 1;
+        }
+    }
+    if ((cnt <= 0) || (cnt > BENCH_POOL_MAX) || (RunMs <= 0))
+        return 1;
+
+    // measures already running : enter waits for them
+    if (jobs_start (before, cnt) != cnt)
+        err++;
+    while (atomic_load (&Started) != cnt)
+        usleep (1000);
+    bench_pool_quiet_enter ();
+    atomic_store (&InQuiet, 1);
+    for (i = 0; i < cnt; i++)
+        if (!before[i].value)
+            err++;
+    printf ("enter  : %d running measures done, running %d, %s\n",
+            cnt, bench_pool_running (), err ? "FAIL" : "PASS");
+
+    // measures started inside the quiet section are held
+    if (jobs_start (inside, cnt) != cnt)
+        err++;
+    usleep (RunMs * 2 * 1000);
+    printf ("quiet  : %d started, %d ran, %s\n", cnt, atomic_load (&Started) - cnt,
+            (atomic_load (&Started) != cnt) ? "FAIL" : "PASS");
+    if (atomic_load (&Started) != cnt)
+        err++;
+    atomic_store (&InQuiet, 0);
+    bench_pool_quiet_leave ();
+
+    // held measures run after leave
+    jobs_wait (inside, cnt);
+    for (i = 0; i < cnt; i++)
+        if (inside[i].value != i + 1)
+            err++;
+    printf ("leave  : %d ran, %d overlaps, %s\n", atomic_load (&Started) - cnt,
+            atomic_load (&Overlap),
+            ((atomic_load (&Started) != cnt * 2) || atomic_load (&Overlap)) ? "FAIL" : "PASS");
+    if ((atomic_load (&Started) != cnt * 2) || atomic_load (&Overlap))
+        err++;
+
+    printf ("%s\n", err ? "FAIL" : "PASS");
+    return err ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,68 @@
+//------------------------------------------------------------------------------
+/**
+ * @file eth_link.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Ethernet link control test for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * usage : eth_link [-i ifname] [-s speed] [-w] [-t timeout_ms]
+ *          -s : set the link speed (100 / 1000), wait for the link up
+ *          -w : wait for the link up only (-s = expected speed, 0 = any)
+ *
+ *          veth pair in a network namespace (no board needed) :
+ *            ip netns add jig
+ *            ip link add vjig0 type veth peer name vjig1 netns jig
+ *            ip link set vjig0 up
+ *            eth_link -i vjig0 -w -t 5000 &
+ *            sleep 1; ip netns exec jig ip link set vjig1 up
+ *          the wait ends on the RTM_NEWLINK of the carrier on (about 1 sec).
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <getopt.h>
+
+//------------------------------------------------------------------------------
+#include "../check_device/ethernet.h"
+
+//------------------------------------------------------------------------------
+int main (int argc, char **argv)
+{
+    const char *ifname = ETHERNET_IFNAME_DEF;
+    int opt, speed = 0, wait = 0, timeout = ETHERNET_LINK_TIMEOUT, ret;
+
+    while ((opt = getopt (argc, argv, "i:s:wt:")) != -1) {
+        switch (opt) {
+            case 'i':   ifname  = optarg;           break;
+            case 's':   speed   = atoi (optarg);    break;
+            case 'w':   wait    = 1;                break;
+            case 't':   timeout = atoi (optarg);    break;
+            default:
+                printf ("usage : %s [-i ifname] [-s speed] [-w] [-t timeout_ms]\n", argv[0]);
+                return 1;
+        }
+    }
+    ethernet_init (ifname);
+    printf ("%s : link %d Mbps\n", ifname, ethernet_link_check ());
+
+    if (wait)
+        ret = ethernet_link_wait (speed, timeout);
+    else if (speed)
+        ret = ethernet_link_setup (speed);
+    else
+        return 0;
+
+    printf ("%s : %s, %d Mbps, %d ms\n", ifname, ret ? "link up" : "FAIL",
+            ethernet_link_check (), ethernet_link_time ());
+    return ret ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
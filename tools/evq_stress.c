@@ -0,0 +1,204 @@
+//------------------------------------------------------------------------------
+/**
+ * @file evq_stress.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Event queue burst test for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * usage : evq_stress [-p producers] [-b burst] [-n bursts]
+ *          producers post bursts of events to two handler consumers and one
+ *          polled consumer. Every event must arrive once, in post order per
+ *          producer; a slow consumer with a short queue must count its drops.
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <pthread.h>
+
+//------------------------------------------------------------------------------
+#include "../core/evq.h"
+
+//------------------------------------------------------------------------------
+#define PRODUCER_MAX    16
+#define EVENT_TYPES     4
+
+// data : producer << 24 | sequence
+#define DATA(p, seq)    (((p) << 24) | (seq))
+#define DATA_P(d)       ((d) >> 24)
+#define DATA_SEQ(d)     ((d) & 0xFFFFFF)
+
+struct consumer {
+    unsigned int    mask;
+    int             id, delay_us;
+    // last sequence per producer, received, out of order
+    int             last [PRODUCER_MAX];
+    atomic_long     rx;
+    long            order_err;
+};
+
+struct producer {
+    pthread_t       th;
+    evq_t           *e;
+    int             id, burst, bursts;
+    unsigned int    seed;
+    long            posted [EVENT_TYPES];
+};
+
+static int          Producers = 4;
+static atomic_int   Finished;
+
+//------------------------------------------------------------------------------
+static void consume (struct consumer *c, const struct evq_msg *m)
+{
+    int p = DATA_P(m->data);
+
+    if ((p < Producers) && (DATA_SEQ(m->data) <= c->last[p]))
+        c->order_err++;
+    if (p < Producers)
+        c->last[p] = DATA_SEQ(m->data);
+    atomic_fetch_add (&c->rx, 1);
+    if (c->delay_us)
+        usleep (c->delay_us);
+}
+
+//------------------------------------------------------------------------------
+static void handler (const struct evq_msg *m, void *arg)
+{
+    consume ((struct consumer *)arg, m);
+}
+
+//------------------------------------------------------------------------------
+static void *producer (void *arg)
+{
+    struct producer *p = (struct producer *)arg;
+    int b, i, ev, seq = 0;
+
+    for (b = 0; b < p->bursts; b++) {
+        for (i = 0; i < p->burst; i++) {
+            ev = rand_r (&p->seed) % EVENT_TYPES;
+            evq_post (p->e, ev, DATA(p->id, seq++));
+            p->posted[ev]++;
+        }
+        // key repeat gap
+        usleep (1000);
+    }
+    atomic_fetch_add (&Finished, 1);
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+static long expected (struct producer *p, unsigned int mask)
+{
+    long n = 0;
+    int i, ev;
+
+    for (i = 0; i < Producers; i++)
+        for (ev = 0; ev < EVENT_TYPES; ev++)
+            if (mask & EVQ_EVENT(ev))
+                n += p[i].posted[ev];
+    return n;
+}
+
+//------------------------------------------------------------------------------
+// depth : consumer queues, slow_us : handler time of consumer 0
+// lossless : no drop allowed (queues deep enough for the bursts)
+//------------------------------------------------------------------------------
+static int run (const char *name, int burst, int bursts, unsigned int depth,
+                int slow_us, int lossless)
+{
+    struct producer p [PRODUCER_MAX];
+    struct consumer c [3];
+    struct evq_msg m;
+    long exp [3], drop [3];
+    evq_t *e;
+    int i, err = 0;
+
+    memset (p, 0, sizeof(p));
+    memset (c, 0, sizeof(c));
+    c[0].mask = EVQ_EVENT(0) | EVQ_EVENT(1);                    c[0].delay_us = slow_us;
+    c[1].mask = EVQ_EVENT(1) | EVQ_EVENT(2) | EVQ_EVENT(3);
+    c[2].mask = EVQ_EVENT(3);
+    for (i = 0; i < 3; i++)
+        memset (c[i].last, -1, sizeof(c[i].last));
+
+    if ((e = evq_init ()) == NULL)
+        return 1;
+    c[0].id = evq_add (e, c[0].mask, depth, handler, &c[0]);
+    c[1].id = evq_add (e, c[1].mask, depth, handler, &c[1]);
+    c[2].id = evq_add (e, c[2].mask, depth, NULL, NULL);
+    evq_start (e);
+
+    atomic_store (&Finished, 0);
+    for (i = 0; i < Producers; i++) {
+        p[i].e = e;     p[i].id = i;    p[i].seed = i + 1;
+        p[i].burst = burst;     p[i].bursts = bursts;
+        pthread_create (&p[i].th, NULL, producer, &p[i]);
+    }
+
+    // polled consumer (main loop) until the producers are done
+    while (atomic_load (&Finished) < Producers) {
+        while (evq_get (e, c[2].id, &m, 10))
+            consume (&c[2], &m);
+    }
+    for (i = 0; i < Producers; i++)
+        pthread_join (p[i].th, NULL);
+    while (evq_get (e, c[2].id, &m, 0))
+        consume (&c[2], &m);
+
+    // handler threads : everything received or dropped
+    for (i = 0; i < 3; i++)
+        exp[i] = expected (p, c[i].mask);
+    while ((atomic_load (&c[0].rx) + (long)atomic_load (&e->c[0].dropped) < exp[0]) ||
+           (atomic_load (&c[1].rx) + (long)atomic_load (&e->c[1].dropped) < exp[1]))
+        usleep (1000);
+
+    for (i = 0; i < 3; i++) {
+        drop[i] = atomic_load (&e->c[i].dropped);
+        printf ("%-8s consumer %d : posted %6ld, received %6ld, dropped %5ld, order err %ld\n",
+                name, i, exp[i], (long)c[i].rx, drop[i], c[i].order_err);
+        if (c[i].order_err || (c[i].rx + drop[i] != exp[i]) || (lossless && drop[i]))
+            err++;
+    }
+    evq_close (e);
+    return err;
+}
+
+//------------------------------------------------------------------------------
+int main (int argc, char **argv)
+{
+    int opt, burst = 64, bursts = 200, err;
+
+    while ((opt = getopt (argc, argv, "p:b:n:")) != -1) {
+        switch (opt) {
+            case 'p':   Producers = atoi (optarg);  break;
+            case 'b':   burst     = atoi (optarg);  break;
+            case 'n':   bursts    = atoi (optarg);  break;
+            default:
+                printf ("usage : %s [-p producers] [-b burst] [-n bursts]\n", argv[0]);
+                return 1;
+        }
+    }
+    if ((Producers <= 0) || (Producers > PRODUCER_MAX) || (burst <= 0) || (bursts <= 0))
+        return 1;
+
+    // queues hold every burst : nothing lost
+    err  = run ("burst", burst, bursts, 4096, 0, 1);
+    // slow handler behind a short queue : drops counted, the rest in order
+    err += run ("slow", burst, bursts / 10 + 1, 16, 200, 0);
+
+    printf ("%s\n", err ? "FAIL" : "PASS");
+    return err ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,186 @@
+//------------------------------------------------------------------------------
+/**
+ * @file glyph_bench.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Text render benchmark (draw_text vs glyph cache) on a memory fb.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * usage : glyph_bench [loops] [scale]
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+//------------------------------------------------------------------------------
+#include "../core/fbmem.h"
+#include "../core/glyph.h"
+
+//------------------------------------------------------------------------------
+// ui_set_sitem strings of the test items
+//------------------------------------------------------------------------------
+static const char *BenchStr [] = {
+    "RUNNING 42",
+    "123 MB/s",
+    "192.168.100.123",
+    "00:1e:06:12:34:56",
+    "PASS",
+    "FAIL",
+};
+
+#define BENCH_STR_CNT   (int)(sizeof(BenchStr) / sizeof(BenchStr[0]))
+
+#define BENCH_FC        0xFFFFFF
+#define BENCH_BC        0x2E86C1
+
+//------------------------------------------------------------------------------
+static long long time_us (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+//------------------------------------------------------------------------------
+static long long bench_draw (fb_info_t *fb, int loops, int scale, int cached)
+{
+    long long t = time_us ();
+    int i, s;
+
+    for (i = 0; i < loops; i++) {
+        for (s = 0; s < BENCH_STR_CNT; s++) {
+            if (cached)
+                glyph_draw_text (fb, 0, 0, s * 40 * scale, BENCH_FC, BENCH_BC, scale, "%s", BenchStr[s]);
+            else
+                draw_text (fb, 0, s * 40 * scale, BENCH_FC, BENCH_BC, scale, "%s", BenchStr[s]);
+        }
+    }
+    return time_us () - t;
+}
+
+//------------------------------------------------------------------------------
+// the cached text has to match draw_text pixel for pixel
+//------------------------------------------------------------------------------
+static int frame_check (const char *name, fb_info_t *fb_a, fb_info_t *fb_b)
+{
+    int same = !memcmp (fb_a->data, fb_b->data, fb_a->size);
+
+    printf ("frame compare %-12s : %s\n", name, same ? "SAME" : "DIFF");
+    return same;
+}
+
+//------------------------------------------------------------------------------
+// string background off (ui default), the box color shows through
+//------------------------------------------------------------------------------
+static int check_transparent (fb_info_t *fb_a, fb_info_t *fb_b, int scale)
+{
+    int s;
+
+    draw_fill_rect (fb_a, 0, 0, fb_a->w, fb_a->h, BENCH_BC);
+    draw_fill_rect (fb_b, 0, 0, fb_b->w, fb_b->h, BENCH_BC);
+    for (s = 0; s < BENCH_STR_CNT; s++) {
+        draw_text (fb_a, 0, s * 40 * scale, BENCH_FC, GLYPH_COLOR_NONE, scale, "%s", BenchStr[s]);
+        glyph_draw_text (fb_b, 0, 0, s * 40 * scale, BENCH_FC, GLYPH_COLOR_NONE, scale,
+                         "%s", BenchStr[s]);
+    }
+    return frame_check ("transparent", fb_a, fb_b);
+}
+
+//------------------------------------------------------------------------------
+// the font argument selects the font, not only the cache key
+//------------------------------------------------------------------------------
+static int check_font (fb_info_t *fb_a, fb_info_t *fb_b, int scale)
+{
+    int s, ret;
+
+    fb_clear (fb_a);    fb_clear (fb_b);
+    set_font (1);
+    for (s = 0; s < BENCH_STR_CNT; s++) {
+        draw_text (fb_a, 0, s * 40 * scale, BENCH_FC, BENCH_BC, scale, "%s", BenchStr[s]);
+        glyph_draw_text (fb_b, 1, 0, s * 40 * scale, BENCH_FC, BENCH_BC, scale, "%s", BenchStr[s]);
+    }
+    ret = frame_check ("font", fb_a, fb_b);
+    set_font (0);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+// more characters than GLYPH_CACHE_MAX in one set, none may be dropped
+//------------------------------------------------------------------------------
+static int check_spill (fb_info_t *fb_a, fb_info_t *fb_b)
+{
+    struct glyph_stats st;
+    unsigned int code = 0xAC00;
+    char line[128], *p;
+    int l, c, ret;
+
+    fb_clear (fb_a);    fb_clear (fb_b);
+    for (l = 0; l < (GLYPH_CACHE_MAX * 3 / 2) / 32; l++) {
+        // 32 Hangul syllables (UTF-8, 3 bytes) per line
+        for (p = line, c = 0; c < 32; c++, code++) {
+            *p++ = 0xE0 | (code >> 12);
+            *p++ = 0x80 | ((code >> 6) & 0x3F);
+            *p++ = 0x80 | (code & 0x3F);
+        }
+        *p = 0;
+        draw_text (fb_a, 0, l * 20, BENCH_FC, BENCH_BC, 1, "%s", line);
+        glyph_draw_text (fb_b, 0, 0, l * 20, BENCH_FC, BENCH_BC, 1, "%s", line);
+    }
+    glyph_get_stats (&st);
+    ret = frame_check ("full table", fb_a, fb_b);
+    printf ("glyph spill %u\n", st.spill);
+    return ret && st.spill;
+}
+
+//------------------------------------------------------------------------------
+int main (int argc, char **argv)
+{
+    fb_info_t *fb_a, *fb_b;
+    struct glyph_stats st;
+    long long t_draw, t_cache;
+    int loops = (argc > 1) ? atoi (argv[1]) : 1000;
+    int scale = (argc > 2) ? atoi (argv[2]) : 3;
+    int ret;
+
+    if ((loops <= 0) || (scale <= 0))
+        return 1;
+
+    fb_a = fb_mem_init (1920, 1080, 32);
+    fb_b = fb_mem_init (1920, 1080, 32);
+    if ((fb_a == NULL) || (fb_b == NULL))
+        return 1;
+
+    t_draw  = bench_draw (fb_a, loops, scale, 0);
+    t_cache = bench_draw (fb_b, loops, scale, 1);
+    glyph_get_stats (&st);
+
+    printf ("strings : %d x %d, scale %d\n", BENCH_STR_CNT, loops, scale);
+    printf ("draw_text       : %8lld us (%lld ns/string)\n",
+            t_draw,  (t_draw  * 1000) / ((long long)loops * BENCH_STR_CNT));
+    printf ("glyph_draw_text : %8lld us (%lld ns/string), x%.1f\n",
+            t_cache, (t_cache * 1000) / ((long long)loops * BENCH_STR_CNT),
+            t_cache ? (double)t_draw / t_cache : 0.0);
+    printf ("glyph lookup %u, miss %u, evict %u\n", st.lookup, st.miss, st.evict);
+
+    ret = frame_check ("opaque", fb_a, fb_b);
+    ret = check_transparent (fb_a, fb_b, scale) && ret;
+    ret = check_font        (fb_a, fb_b, scale) && ret;
+    ret = check_spill       (fb_a, fb_b)        && ret;
+    printf ("%s\n", ret ? "PASS" : "FAIL");
+
+    fb_mem_close (fb_a);
+    fb_mem_close (fb_b);
+    return ret ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
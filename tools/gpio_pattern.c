@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+/**
+ * @file gpio_pattern.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief GPIO cdev pattern test (gpio-sim / gpio-mockup) for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * usage : gpio_pattern [-n lines] [-l loops] chip
+ *          chip : /dev/gpiochipN, lines 0 ~ n-1 are driven with the header
+ *                 patterns (high, low, cross 0, cross 1) and read back.
+ *
+ * test chip on a stock kernel (gpio-sim, 5.17+) :
+ *   modprobe gpio-sim
+ *   mkdir -p /sys/kernel/config/gpio-sim/jig/gpio-bank0
+ *   echo 32 > /sys/kernel/config/gpio-sim/jig/gpio-bank0/num_lines
+ *   echo 1  > /sys/kernel/config/gpio-sim/jig/live
+ *   cat /sys/kernel/config/gpio-sim/jig/gpio-bank0/chip_name
+ * or gpio-mockup : modprobe gpio-mockup gpio_mockup_ranges=-1,32
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <time.h>
+
+//------------------------------------------------------------------------------
+#include "../check_device/gpiocdev.h"
+
+//------------------------------------------------------------------------------
+static long long time_us (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+//------------------------------------------------------------------------------
+// header pattern 0 ~ 3 : high, low, cross 0, cross 1
+//------------------------------------------------------------------------------
+static void pattern_make (int pattern, int *value, int cnt)
+{
+    int i;
+
+    for (i = 0; i < cnt; i++) {
+        switch (pattern) {
+            case 0: value[i] = 1;           break;
+            case 1: value[i] = 0;           break;
+            case 2: value[i] = i & 1;       break;
+            case 3: value[i] = !(i & 1);    break;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+int main (int argc, char **argv)
+{
+    struct gpio_req req;
+    int gpio [GPIOCDEV_LINE_MAX], value [GPIOCDEV_LINE_MAX], rd [GPIOCDEV_LINE_MAX];
+    int opt, lines = 28, loops = 1000, i, p, err = 0;
+    long long t;
+
+    while ((opt = getopt (argc, argv, "n:l:")) != -1) {
+        switch (opt) {
+            case 'n':   lines = atoi (optarg);  break;
+            case 'l':   loops = atoi (optarg);  break;
+            default:
+                printf ("usage : %s [-n lines] [-l loops] /dev/gpiochipN\n", argv[0]);
+                return 1;
+        }
+    }
+    if ((optind >= argc) || (lines <= 0) || (lines > GPIOCDEV_LINE_MAX) || (loops <= 0)) {
+        printf ("usage : %s [-n lines] [-l loops] /dev/gpiochipN\n", argv[0]);
+        return 1;
+    }
+
+    // test chip numbered from 0
+    if (!gpiocdev_add_chip (argv[optind], 0)) {
+        printf ("%s : not a gpio chip\n", argv[optind]);
+        return 1;
+    }
+    for (i = 0; i < lines; i++)
+        gpio[i] = i;
+
+    if (!gpiocdev_request (&req, gpio, lines, "gpio-pattern")) {
+        printf ("%s : line request failed\n", argv[optind]);
+        return 1;
+    }
+    printf ("%s : %d lines, %s uapi\n", argv[optind], lines, req.chip[0].v2 ? "v2" : "v1");
+
+    // read back check
+    for (p = 0; p < 4; p++) {
+        pattern_make (p, value, lines);
+        gpiocdev_set (&req, value);
+        gpiocdev_get (&req, rd);
+        for (i = 0; i < lines; i++) {
+            if (rd[i] != value[i]) {
+                printf ("PT%d line %d : set %d, read %d\n", p, i, value[i], rd[i]);
+                err++;
+            }
+        }
+    }
+
+    t = time_us ();
+    for (i = 0; i < loops; i++) {
+        pattern_make (i & 3, value, lines);
+        gpiocdev_set (&req, value);
+    }
+    t = time_us () - t;
+
+    printf ("pattern set : %lld ns/pattern (%d loops), read back %s\n",
+            t * 1000 / loops, loops, err ? "FAIL" : "PASS");
+
+    gpiocdev_release (&req);
+    return err ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
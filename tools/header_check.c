@@ -0,0 +1,411 @@
+//------------------------------------------------------------------------------
+/**
+ * @file header_check.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Header pattern check test / benchmark for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * usage : header_check [-l loops]
+ *          pattern masks vs the previous per-pin tables and the HEADER40 gpios,
+ *          mask check vs per-pin reference (random / threshold edge readings),
+ *          then ns per pattern check of both (half of the readings failing).
+ *          generated diagnosis patterns on a modeled board (random shorts,
+ *          stuck pins) must report exactly the injected faults.
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <time.h>
+
+//------------------------------------------------------------------------------
+#include "../check_device/header.h"
+
+//------------------------------------------------------------------------------
+// threshold edges and typical levels
+static const int EdgeMv[] = { 0, 120, 300, 301, 1650, 2999, 3000, 3300 };
+
+#define EDGE_CNT    (int)(sizeof(EdgeMv)/sizeof(EdgeMv[0]))
+
+// header pin -> gpio number, 0 = no gpio (check_device/header.c)
+extern const int HEADER40 [H40_PIN_CNT];
+
+#define NC  0
+
+// previous per-pin pattern tables (1 = high, 0 = low, NC = no gpio)
+static const int RefPattern [eHEADER_END][H40_PIN_CNT] = {
+    // Pattern 0 : ALL High
+    {
+        // Header J2 GPIOs
+         NC,        // Not used (pin 0)
+         NC,  NC,   // | 01 : 3.3V     || 02 : 5.0V     |
+         NC,  NC,   // | 03 : GPIO3_B6 || 04 : 5.0V     |
+         NC,  NC,   // | 05 : GPIO3_B5 || 06 : GND      |
+          1,   1,   // | 07 : GPIO0_B6 || 08 : GPIO3_D6 |
+         NC,   1,   // | 09 : GND      || 10 : GPIO3_D7 |
+          1,   1,   // | 11 : GPIO0_C0 || 12 : GPIO3_D0 |
+          1,  NC,   // | 13 : GPIO0_C1 || 14 : GND      |
+          1,   1,   // | 15 : GPIO3_B2 || 16 : GPIO3_C6 |
+         NC,   1,   // | 17 : 3.3V     || 18 : GPIO3_C7 |
+          1,  NC,   // | 19 : GPIO2_D1 || 20 : GND      |
+          1,   1,   // | 21 : GPIO2_D0 || 22 : GPIO3_D1 |
+          1,   1,   // | 23 : GPIO2_D3 || 24 : GPIO2_D2 |
+         NC,   1,   // | 25 : GND      || 26 : GPIO3_D2 |
+          1,   1,   // | 27 : GPIO0_B4 || 28 : GPIO0_B3 |
+          1,  NC,   // | 29 : GPIO4_C1 || 30 : GND      |
+          1,   1,   // | 31 : GPIO4_B6 || 32 : GPIO3_D3 |
+          1,  NC,   // | 33 : GPIO0_B5 || 34 : GND      |
+          1,   1,   // | 35 : GPIO3_D5 || 36 : GPIO3_D4 |
+         NC,  NC,   // | 37 : ADC.AIN4 || 38 : 1.8V     |
+         NC,  NC,   // | 39 : GND      || 40 : ADC.AIN5 |
+    },
+    // Pattern 1 : ALL Low
+    {
+        // Header J2 GPIOs
+         NC,        // Not used (pin 0)
+         NC,  NC,   // | 01 : 3.3V     || 02 : 5.0V     |
+         NC,  NC,   // | 03 : GPIO3_B6 || 04 : 5.0V     |
+         NC,  NC,   // | 05 : GPIO3_B5 || 06 : GND      |
+          0,   0,   // | 07 : GPIO0_B6 || 08 : GPIO3_D6 |
+         NC,   0,   // | 09 : GND      || 10 : GPIO3_D7 |
+          0,   0,   // | 11 : GPIO0_C0 || 12 : GPIO3_D0 |
+          0,  NC,   // | 13 : GPIO0_C1 || 14 : GND      |
+          0,   0,   // | 15 : GPIO3_B2 || 16 : GPIO3_C6 |
+         NC,   0,   // | 17 : 3.3V     || 18 : GPIO3_C7 |
+          0,  NC,   // | 19 : GPIO2_D1 || 20 : GND      |
+          0,   0,   // | 21 : GPIO2_D0 || 22 : GPIO3_D1 |
+          0,   0,   // | 23 : GPIO2_D3 || 24 : GPIO2_D2 |
+         NC,   0,   // | 25 : GND      || 26 : GPIO3_D2 |
+          0,   0,   // | 27 : GPIO0_B4 || 28 : GPIO0_B3 |
+          0,  NC,   // | 29 : GPIO4_C1 || 30 : GND      |
+          0,   0,   // | 31 : GPIO4_B6 || 32 : GPIO3_D3 |
+          0,  NC,   // | 33 : GPIO0_B5 || 34 : GND      |
+          0,   0,   // | 35 : GPIO3_D5 || 36 : GPIO3_D4 |
+         NC,  NC,   // | 37 : ADC.AIN4 || 38 : 1.8V     |
+         NC,  NC,   // | 39 : GND      || 40 : ADC.AIN5 |
+    },
+    // Pattern 2 : Cross 0
+    {
+        // Header J2 GPIOs
+         NC,        // Not used (pin 0)
+         NC,  NC,   // | 01 : 3.3V     || 02 : 5.0V     |
+         NC,  NC,   // | 03 : GPIO3_B6 || 04 : 5.0V     |
+         NC,  NC,   // | 05 : GPIO3_B5 || 06 : GND      |
+          0,   1,   // | 07 : GPIO0_B6 || 08 : GPIO3_D6 |
+         NC,   0,   // | 09 : GND      || 10 : GPIO3_D7 |
+          1,   0,   // | 11 : GPIO0_C0 || 12 : GPIO3_D0 |
+          0,  NC,   // | 13 : GPIO0_C1 || 14 : GND      |
+          1,   0,   // | 15 : GPIO3_B2 || 16 : GPIO3_C6 |
+         NC,   1,   // | 17 : 3.3V     || 18 : GPIO3_C7 |
+          0,  NC,   // | 19 : GPIO2_D1 || 20 : GND      |
+          1,   0,   // | 21 : GPIO2_D0 || 22 : GPIO3_D1 |
+          0,   1,   // | 23 : GPIO2_D3 || 24 : GPIO2_D2 |
+         NC,   0,   // | 25 : GND      || 26 : GPIO3_D2 |
+          0,   1,   // | 27 : GPIO0_B4 || 28 : GPIO0_B3 |
+          1,  NC,   // | 29 : GPIO4_C1 || 30 : GND      |
+          0,   1,   // | 31 : GPIO4_B6 || 32 : GPIO3_D3 |
+          1,  NC,   // | 33 : GPIO0_B5 || 34 : GND      |
+          0,   1,   // | 35 : GPIO3_D5 || 36 : GPIO3_D4 |
+         NC,  NC,   // | 37 : ADC.AIN4 || 38 : 1.8V     |
+         NC,  NC,   // | 39 : GND      || 40 : ADC.AIN5 |
+    },
+    // Pattern 3 : Cross 1
+    {
+        // Header J2 GPIOs
+         NC,        // Not used (pin 0)
+         NC,  NC,   // | 01 : 3.3V     || 02 : 5.0V     |
+         NC,  NC,   // | 03 : GPIO3_B6 || 04 : 5.0V     |
+         NC,  NC,   // | 05 : GPIO3_B5 || 06 : GND      |
+          1,   0,   // | 07 : GPIO0_B6 || 08 : GPIO3_D6 |
+         NC,   1,   // | 09 : GND      || 10 : GPIO3_D7 |
+          0,   1,   // | 11 : GPIO0_C0 || 12 : GPIO3_D0 |
+          1,  NC,   // | 13 : GPIO0_C1 || 14 : GND      |
+          0,   1,   // | 15 : GPIO3_B2 || 16 : GPIO3_C6 |
+         NC,   0,   // | 17 : 3.3V     || 18 : GPIO3_C7 |
+          1,  NC,   // | 19 : GPIO2_D1 || 20 : GND      |
+          0,   1,   // | 21 : GPIO2_D0 || 22 : GPIO3_D1 |
+          1,   0,   // | 23 : GPIO2_D3 || 24 : GPIO2_D2 |
+         NC,   1,   // | 25 : GND      || 26 : GPIO3_D2 |
+          1,   0,   // | 27 : GPIO0_B4 || 28 : GPIO0_B3 |
+          0,  NC,   // | 29 : GPIO4_C1 || 30 : GND      |
+          1,   0,   // | 31 : GPIO4_B6 || 32 : GPIO3_D3 |
+          0,  NC,   // | 33 : GPIO0_B5 || 34 : GND      |
+          1,   0,   // | 35 : GPIO3_D5 || 36 : GPIO3_D4 |
+         NC,  NC,   // | 37 : ADC.AIN4 || 38 : 1.8V     |
+         NC,  NC,   // | 39 : GND      || 40 : ADC.AIN5 |
+    },
+};
+
+//------------------------------------------------------------------------------
+static long long time_us (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+//------------------------------------------------------------------------------
+// per-pin check (previous header_pattern_check without the printf)
+//------------------------------------------------------------------------------
+static uint64_t ref_fail (int id, const int *pattern40)
+{
+    uint64_t fail = 0;
+    int i;
+
+    for (i = 0; i < H40_PIN_CNT; i++) {
+        if (!HEADER40[i])
+            continue;
+        if (RefPattern[id][i]) {
+            if (pattern40[i] < 3000)
+                fail |= 1ULL << i;
+        } else {
+            if (pattern40[i] > 300)
+                fail |= 1ULL << i;
+        }
+    }
+    return fail;
+}
+
+//------------------------------------------------------------------------------
+// masks vs the per-pin tables : drive/care = pins with a gpio, high = 1 pins
+//------------------------------------------------------------------------------
+static int test_table (void)
+{
+    struct h40_mask m;
+    uint64_t gpio = 0, high;
+    int id, i, err = 0;
+
+    for (i = 0; i < H40_PIN_CNT; i++)
+        if (HEADER40[i])
+            gpio |= 1ULL << i;
+
+    for (id = 0; id < eHEADER_END; id++) {
+        for (i = 0, high = 0; i < H40_PIN_CNT; i++)
+            if (HEADER40[i] && RefPattern[id][i])
+                high |= 1ULL << i;
+
+        if (!header_pattern_mask (id, &m) ||
+            (m.drive != gpio) || (m.care != gpio) || (m.high != high)) {
+            printf ("PT%d : drive %016llx care %016llx high %016llx, expected %016llx / %016llx\n",
+                    id, (unsigned long long)m.drive, (unsigned long long)m.care,
+                    (unsigned long long)m.high, (unsigned long long)gpio, (unsigned long long)high);
+            err++;
+        }
+    }
+    if (header_pattern_mask (eHEADER_END, &m))
+        err++;
+
+    printf ("pattern table : %s\n", err ? "FAIL" : "PASS");
+    return err;
+}
+
+//------------------------------------------------------------------------------
+static int test_check (int vectors)
+{
+    int pattern40[H40_PIN_CNT], id, i, v, err = 0;
+    uint64_t fail;
+
+    for (v = 0; v < vectors; v++) {
+        for (id = 0; id < eHEADER_END; id++) {
+            // ideal levels, then random pins moved to a threshold edge
+            for (i = 0; i < H40_PIN_CNT; i++)
+                pattern40[i] = RefPattern[id][i] ? 3300 : 0;
+            if (v) {
+                for (i = rand () % 8; i >= 0; i--)
+                    pattern40[rand () % H40_PIN_CNT] = EdgeMv[rand () % EDGE_CNT];
+            }
+            fail = header_pattern_fail (id, pattern40);
+            if ((fail != ref_fail (id, pattern40)) || (!v && fail)) {
+                printf ("PT%d vector %d : mask %016llx, ref %016llx\n", id, v,
+                        (unsigned long long)fail,
+                        (unsigned long long)ref_fail (id, pattern40));
+                err++;
+            }
+        }
+    }
+    printf ("pattern check : %d vectors, %s\n", vectors, err ? "FAIL" : "PASS");
+    return err;
+}
+
+//------------------------------------------------------------------------------
+// Modeled board : shorted pins are one node (mid level when the drivers
+// fight), stuck pins read one level. gpio[] : header pins with a gpio.
+//------------------------------------------------------------------------------
+struct board {
+    int         short_cnt, shorts [4][2];
+    uint64_t    stuck_hi, stuck_lo;
+};
+
+static void board_read (const struct board *b, uint64_t high, int *pattern40)
+{
+    int i, a, c;
+
+    for (i = 0; i < H40_PIN_CNT; i++)
+        pattern40[i] = ((high >> i) & 1) ? 3300 : 0;
+
+    for (i = 0; i < b->short_cnt; i++) {
+        a = b->shorts[i][0];    c = b->shorts[i][1];
+        if (pattern40[a] != pattern40[c])
+            pattern40[a] = pattern40[c] = 1650;
+    }
+    for (i = 0; i < H40_PIN_CNT; i++) {
+        if (b->stuck_hi & (1ULL << i))  pattern40[i] = 3300;
+        if (b->stuck_lo & (1ULL << i))  pattern40[i] = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+static int diag_run (int mode, const struct board *b, struct h40_diag *d)
+{
+    uint64_t high [H40_DIAG_PATTERN_MAX], hi [H40_DIAG_PATTERN_MAX], lo [H40_DIAG_PATTERN_MAX];
+    int pattern40 [H40_PIN_CNT], cnt, p;
+
+    cnt = header_diag_pattern (mode, high, H40_DIAG_PATTERN_MAX);
+    for (p = 0; p < cnt; p++) {
+        board_read (b, high[p], pattern40);
+        header_pattern_pack (pattern40, &hi[p], &lo[p]);
+    }
+    header_diag_analyze (high, hi, lo, cnt, d);
+    return cnt;
+}
+
+//------------------------------------------------------------------------------
+static int diag_match (const struct board *b, const struct h40_diag *d)
+{
+    int i, j, found;
+
+    if ((d->short_cnt != b->short_cnt) ||
+        (d->stuck_hi != b->stuck_hi) || (d->stuck_lo != b->stuck_lo))
+        return 0;
+    for (i = 0; i < b->short_cnt; i++) {
+        for (j = 0, found = 0; j < d->short_cnt; j++)
+            if ((d->shorts[j].a == b->shorts[i][0]) && (d->shorts[j].b == b->shorts[i][1]))
+                found = 1;
+        if (!found)
+            return 0;
+    }
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// ADDR : one short (+ a stuck pin), WALK : up to 4 disjoint shorts
+//------------------------------------------------------------------------------
+static int test_diag (int trials)
+{
+    static const char *name[eHEADER_DIAG_END] = { "addr", "walk1", "walk0" };
+    struct h40_diag d;
+    struct board b;
+    int gpio [H40_PIN_CNT], n = 0, mode, t, i, k, a, c, cnt = 0, err = 0;
+    uint64_t used;
+
+    for (i = 0; i < H40_PIN_CNT; i++)
+        if (HEADER40[i])
+            gpio[n++] = i;
+
+    for (mode = 0; mode < eHEADER_DIAG_END; mode++) {
+        for (t = 0; t < trials; t++) {
+            memset (&b, 0, sizeof(b));
+            used = 0;
+            // first trial : fault free board
+            k = t ? ((mode == eHEADER_DIAG_ADDR) ? 1 : 1 + rand () % 4) : 0;
+            for (i = 0; i < k; i++) {
+                do {
+                    a = gpio[rand () % n];  c = gpio[rand () % n];
+                } while ((a == c) || ((used >> a) & 1) || ((used >> c) & 1));
+                used |= (1ULL << a) | (1ULL << c);
+                b.shorts[i][0] = (a < c) ? a : c;
+                b.shorts[i][1] = (a < c) ? c : a;
+            }
+            b.short_cnt = k;
+            if (t && (rand () & 1)) {
+                do { i = gpio[rand () % n]; } while ((used >> i) & 1);
+                if (rand () & 1)    b.stuck_hi = 1ULL << i;
+                else                b.stuck_lo = 1ULL << i;
+            }
+
+            cnt = diag_run (mode, &b, &d);
+            if (!diag_match (&b, &d)) {
+                printf ("diag %s trial %d : %d shorts (%d-%d), found %d (%d-%d)\n",
+                        name[mode], t, b.short_cnt, b.shorts[0][0], b.shorts[0][1],
+                        d.short_cnt, d.shorts[0].a, d.shorts[0].b);
+                err++;
+            }
+        }
+        printf ("diag %-5s : %2d patterns, %d boards, %s\n",
+                name[mode], cnt, trials, err ? "FAIL" : "PASS");
+    }
+    return err;
+}
+
+//------------------------------------------------------------------------------
+// readings : ideal levels, pins at random threshold edges on every 2nd set
+//------------------------------------------------------------------------------
+#define BENCH_SET   256
+
+static void bench (int loops)
+{
+    static int pattern40[BENCH_SET][H40_PIN_CNT];
+    volatile uint64_t sink = 0;
+    long long t_ref, t_mask;
+    int i, n;
+
+    for (n = 0; n < BENCH_SET; n++) {
+        for (i = 0; i < H40_PIN_CNT; i++)
+            pattern40[n][i] = RefPattern[n & 3][i] ? 3300 : 0;
+        if (n & 4) {
+            for (i = 0; i < 8; i++)
+                pattern40[n][rand () % H40_PIN_CNT] = EdgeMv[rand () % EDGE_CNT];
+        }
+    }
+
+    t_ref = time_us ();
+    for (i = 0; i < loops; i++)
+        sink += ref_fail (i & 3, pattern40[i % BENCH_SET]);
+    t_ref = time_us () - t_ref;
+
+    t_mask = time_us ();
+    for (i = 0; i < loops; i++)
+        sink += header_pattern_fail (i & 3, pattern40[i % BENCH_SET]);
+    t_mask = time_us () - t_mask;
+
+    printf ("per-pin check : %6lld ns/check\n", t_ref * 1000 / loops);
+    printf ("mask check    : %6lld ns/check, x%.1f\n", t_mask * 1000 / loops,
+            t_mask ? (double)t_ref / t_mask : 0.0);
+}
+
+//------------------------------------------------------------------------------
+int main (int argc, char **argv)
+{
+    int opt, loops = 1000000, err;
+
+    while ((opt = getopt (argc, argv, "l:")) != -1) {
+        switch (opt) {
+            case 'l':   loops = atoi (optarg);  break;
+            default:
+                printf ("usage : %s [-l loops]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (loops <= 0)
+        loops = 1;
+
+    srand (1);
+    err  = test_table ();
+    err += test_check (10000);
+    err += test_diag  (1000);
+    bench (loops);
+
+    return err ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
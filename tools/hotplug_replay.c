@@ -0,0 +1,223 @@
+//------------------------------------------------------------------------------
+/**
+ * @file hotplug_replay.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Hotplug uevent replay test for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * usage : hotplug_replay [-r file]
+ *          default : a recorded M1 uevent stream (usb disks on every port,
+ *          eMMC/uSD/SATA/NVMe, partitions and other subsystems) is replayed.
+ *          every event must map to its test device, the usb waiter must get
+ *          only the usb devices and the storage waiter only the storage ones.
+ *          -r file : replay a recording and print the mapping of every event
+ *                    (udevadm monitor --kernel --property > file).
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <pthread.h>
+
+//------------------------------------------------------------------------------
+#include "../core/hotplug.h"
+#include "../check_device/usb.h"
+#include "../check_device/storage.h"
+
+//------------------------------------------------------------------------------
+// same device bits as main.c
+#define HOTPLUG_USB(id)         HOTPLUG_DEV(id)
+#define HOTPLUG_STORAGE(id)     HOTPLUG_DEV(16 + (id))
+#define HOTPLUG_USB_ALL         0x0000FFFFu
+#define HOTPLUG_STORAGE_ALL     0xFFFF0000u
+
+#define USB_HOST    "/devices/platform/usbhost3_0/fcc00000.usb/xhci-hcd.3.auto"
+#define BLOCK(n)    "/host0/target0:0:0/0:0:0:0/block/" n
+
+struct record {
+    const char      *text;
+    unsigned int    mask;
+};
+
+// udevadm monitor --kernel --property (KERNEL[...] lines dropped)
+static const struct record Record [] = {
+    { "ACTION=add\nDEVPATH=" USB_HOST "/usb8/8-1/8-1:1.0" BLOCK("sda") "\n"
+      "SUBSYSTEM=block\nDEVTYPE=disk\nDEVNAME=sda\n",       HOTPLUG_USB(eUSB30_UP_R) },
+    { "ACTION=add\nDEVPATH=" USB_HOST "/usb8/8-1/8-1:1.0" BLOCK("sda/sda1") "\n"
+      "SUBSYSTEM=block\nDEVTYPE=partition\nDEVNAME=sda1\n", 0 },
+    { "ACTION=add\nDEVPATH=" USB_HOST "/usb6/6-1/6-1:1.0" BLOCK("sdb") "\n"
+      "SUBSYSTEM=block\nDEVTYPE=disk\nDEVNAME=sdb\n",       HOTPLUG_USB(eUSB30_DN_R) },
+    { "ACTION=add\nDEVPATH=/devices/platform/fd800000.usb/usb1/1-1/1-1:1.0" BLOCK("sdc") "\n"
+      "SUBSYSTEM=block\nDEVTYPE=disk\nDEVNAME=sdc\n",       HOTPLUG_USB(eUSB20_UP_R) },
+    { "ACTION=add\nDEVPATH=/devices/platform/fd840000.usb/usb2/2-1/2-1:1.0" BLOCK("sdd") "\n"
+      "SUBSYSTEM=block\nDEVTYPE=disk\nDEVNAME=sdd\n",       HOTPLUG_USB(eUSB20_DN_R) },
+    { "ACTION=add\nDEVPATH=/devices/platform/fe310000.mmc/mmc_host/mmc0/mmc0:0001/block/mmcblk0\n"
+      "SUBSYSTEM=block\nDEVTYPE=disk\nDEVNAME=mmcblk0\n",   HOTPLUG_STORAGE(eSTORAGE_eMMC) },
+    { "ACTION=change\nDEVPATH=/devices/platform/fe2b0000.mmc/mmc_host/mmc1/mmc1:aaaa/block/mmcblk1\n"
+      "SUBSYSTEM=block\nDEVTYPE=disk\nDEVNAME=mmcblk1\n",   HOTPLUG_STORAGE(eSTORAGE_uSD) },
+    { "ACTION=add\nDEVPATH=/devices/platform/fc800000.sata/ata1" BLOCK("sda") "\n"
+      "SUBSYSTEM=block\nDEVTYPE=disk\nDEVNAME=sda\n",       HOTPLUG_STORAGE(eSTORAGE_SATA) },
+    { "ACTION=add\nDEVPATH=/devices/platform/3c0800000.pcie/pci0002:20/0002:20:00.0/"
+      "0002:21:00.0/nvme/nvme0/nvme0n1\n"
+      "SUBSYSTEM=block\nDEVTYPE=disk\nDEVNAME=nvme0n1\n",   HOTPLUG_STORAGE(eSTORAGE_NVME) },
+    { "ACTION=add\nDEVPATH=/devices/virtual/input/input5/event5\n"
+      "SUBSYSTEM=input\nDEVNAME=input/event5\n",            0 },
+    { "ACTION=add\nDEVPATH=/devices/virtual/block/loop0\n"
+      "SUBSYSTEM=block\nDEVTYPE=disk\nDEVNAME=loop0\n",     0 },
+    { "ACTION=remove\nDEVPATH=" USB_HOST "/usb8/8-1/8-1:1.0" BLOCK("sda") "\n"
+      "SUBSYSTEM=block\nDEVTYPE=disk\nDEVNAME=sda\n",       HOTPLUG_USB(eUSB30_UP_R) },
+};
+
+#define RECORD_CNT  (int)(sizeof(Record) / sizeof(Record[0]))
+
+struct waiter {
+    pthread_t       th;
+    unsigned int    watch, expect, got;
+    int             wakeup;
+};
+
+static int Mapped, MapErr;
+
+//------------------------------------------------------------------------------
+// same mapping as main.c hotplug_filter (usb port first, a usb disk is sdX)
+//------------------------------------------------------------------------------
+static unsigned int filter (const struct uevent *ev)
+{
+    int id;
+
+    if (strcmp (ev->subsystem, "block") || strcmp (ev->devtype, "disk"))
+        return 0;
+    if ((id = usb_uevent_id (ev->devpath)) >= 0)
+        return HOTPLUG_USB(id);
+    if ((id = storage_uevent_id (ev->devname)) >= 0)
+        return HOTPLUG_STORAGE(id);
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// replay callback : record order = Record order (arg = NULL : print only)
+//------------------------------------------------------------------------------
+static void map_check (const struct uevent *ev, void *arg)
+{
+    unsigned int mask = filter (ev);
+
+    printf ("%-7s %-10s %-10s %-10s -> %08x", ev->action, ev->subsystem, ev->devtype,
+            ev->devname, mask);
+    if (arg && (Mapped < RECORD_CNT) && (mask != Record[Mapped].mask)) {
+        printf (", expected %08x", Record[Mapped].mask);
+        MapErr++;
+    }
+    printf ("\n");
+    Mapped++;
+}
+
+//------------------------------------------------------------------------------
+// takes its device bits until all expected bits arrived or a timeout
+//------------------------------------------------------------------------------
+static void *waiter (void *arg)
+{
+    struct waiter *w = (struct waiter *)arg;
+    unsigned int mask;
+
+    while ((w->got & w->expect) != w->expect) {
+        if ((mask = hotplug_wait (w->watch, 500)) == 0)
+            break;
+        w->got |= mask;
+        w->wakeup++;
+    }
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+static int write_records (char *fname)
+{
+    FILE *fp;
+    int i, fd;
+
+    if ((fd = mkstemp (fname)) < 0)
+        return 0;
+    if ((fp = fdopen (fd, "w")) == NULL)
+        return 0;
+    for (i = 0; i < RECORD_CNT; i++)
+        fprintf (fp, "KERNEL[%d.000000] event\n%s\n", i, Record[i].text);
+    fclose (fp);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+int main (int argc, char **argv)
+{
+    struct waiter w [3];
+    char fname[] = "/tmp/hotplug_replay.XXXXXX";
+    unsigned int usb = 0, storage = 0;
+    int opt, i, cnt, err = 0;
+
+    while ((opt = getopt (argc, argv, "r:")) != -1) {
+        switch (opt) {
+            case 'r':
+                printf ("%s : %d events\n", optarg, uevent_replay (optarg, map_check, NULL));
+                return 0;
+            default:
+                printf ("usage : %s [-r file]\n", argv[0]);
+                return 1;
+        }
+    }
+
+    if (!write_records (fname)) {
+        printf ("%s : write error\n", fname);
+        return 1;
+    }
+
+    // mapping of every recorded event
+    if ((cnt = uevent_replay (fname, map_check, fname)) != RECORD_CNT) {
+        printf ("replay   : %d of %d events\n", cnt, RECORD_CNT);
+        err++;
+    }
+    if (MapErr)
+        err++;
+    printf ("map      : %d events, %d errors, %s\n", cnt, MapErr, MapErr ? "FAIL" : "PASS");
+
+    // delivery : each waiter gets only its own devices
+    for (i = 0; i < RECORD_CNT; i++) {
+        usb     |= Record[i].mask & HOTPLUG_USB_ALL;
+        storage |= Record[i].mask & HOTPLUG_STORAGE_ALL;
+    }
+    memset (w, 0, sizeof(w));
+    // a device bit is taken by one waiter : eUSB20_DN has its own waiter,
+    // replayed once and never woken by the other ports
+    w[0].watch = HOTPLUG_USB_ALL & ~HOTPLUG_USB(eUSB20_DN_R);
+    w[0].expect = usb & w[0].watch;
+    w[1].watch = HOTPLUG_STORAGE_ALL;   w[1].expect = storage;
+    w[2].watch = HOTPLUG_USB(eUSB20_DN_R);  w[2].expect = HOTPLUG_USB(eUSB20_DN_R);
+
+    hotplug_set_filter (filter);
+    for (i = 0; i < 3; i++)
+        pthread_create (&w[i].th, NULL, waiter, &w[i]);
+    usleep (10000);
+    hotplug_replay (fname);
+    for (i = 0; i < 3; i++) {
+        pthread_join (w[i].th, NULL);
+        printf ("waiter %d : watch %08x, got %08x (expected %08x), %d wakeups\n",
+                i, w[i].watch, w[i].got, w[i].expect, w[i].wakeup);
+        if ((w[i].got != w[i].expect) || (w[i].got & ~w[i].watch))
+            err++;
+    }
+    if (w[2].wakeup != 1)
+        err++;
+    unlink (fname);
+
+    printf ("%s\n", err ? "FAIL" : "PASS");
+    return err ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,234 @@
+//------------------------------------------------------------------------------
+/**
+ * @file itemstate_stress.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Item state stress test for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * usage : itemstate_stress [-t threads] [-n items] [-l loops]
+ *          threads restart / finish random items, a waiter blocks on the
+ *          completion eventfd. the timeout countdown is decremented by all
+ *          threads while one clears it (eEVENT_STOP), it must never go below 0.
+ *          make tools CFLAGS="-g -fsanitize=thread" \
+ *          LDFLAGS="-fsanitize=thread -lpthread" for a ThreadSanitizer run.
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <pthread.h>
+
+//------------------------------------------------------------------------------
+#include "../core/itemstate.h"
+
+//------------------------------------------------------------------------------
+enum { eST_WAIT = 0, eST_RUN, eST_STOP };
+
+struct worker {
+    pthread_t       th;
+    itemstate_t     *s;
+    int             n, loops, finished;
+    unsigned int    seed;
+};
+
+static atomic_int   Start = 0;
+
+//------------------------------------------------------------------------------
+// phase 1 : random restart / stop with results, phase 2 : RUN -> STOP race
+//------------------------------------------------------------------------------
+static void *worker (void *arg)
+{
+    struct worker *w = (struct worker *)arg;
+    int i, id;
+
+    while (!atomic_load (&Start))
+        ;
+    for (i = 0; i < w->loops; i++) {
+        id = rand_r (&w->seed) % w->n;
+        switch (rand_r (&w->seed) % 3) {
+            case 0: itemstate_set (w->s, id, eST_RUN,  ITEM_KEEP);              break;
+            case 1: itemstate_set (w->s, id, eST_STOP, rand_r (&w->seed) & 1);  break;
+            case 2: itemstate_set (w->s, id, ITEM_KEEP, 1);                      break;
+        }
+    }
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+static void *finisher (void *arg)
+{
+    struct worker *w = (struct worker *)arg;
+    int id;
+
+    for (id = 0; id < w->n; id++) {
+        // only one thread wins each RUN -> STOP transition
+        if (itemstate_cas (w->s, id, eST_RUN, eST_STOP, 1))
+            w->finished++;
+    }
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+// timeout countdown (main.c TimeoutStop) : decrement vs clear (eEVENT_STOP)
+//------------------------------------------------------------------------------
+static atomic_int   Countdown, Negative, ClearStop;
+
+static void *counter (void *arg)
+{
+    struct worker *w = (struct worker *)arg;
+    int i;
+
+    while (!atomic_load (&Start))
+        ;
+    for (i = 0; i < w->loops; i++) {
+        w->finished += itemstate_countdown (&Countdown);
+        if (atomic_load (&Countdown) < 0)
+            atomic_fetch_add (&Negative, 1);
+    }
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+static void *clearer (void *arg)
+{
+    while (!atomic_load (&Start))
+        ;
+    // re-arm and clear while the counters run
+    while (!atomic_load (&ClearStop)) {
+        atomic_store (&Countdown, 2);
+        atomic_store (&Countdown, 0);
+    }
+    return arg;
+}
+
+//------------------------------------------------------------------------------
+static int test_countdown (struct worker *w, int threads, int loops)
+{
+    pthread_t th;
+    int i, cnt = (threads * loops) / 2, dec = 0, err = 0;
+
+    // exact : every decrement of the start value is taken once, then 0
+    atomic_store (&Start, 0);   atomic_store (&Negative, 0);
+    atomic_store (&Countdown, cnt);
+    for (i = 0; i < threads; i++) {
+        w[i].finished = 0;  w[i].loops = loops;
+        pthread_create (&w[i].th, NULL, counter, &w[i]);
+    }
+    atomic_store (&Start, 1);
+    for (i = 0; i < threads; i++) {
+        pthread_join (w[i].th, NULL);
+        dec += w[i].finished;
+    }
+    if ((dec != cnt) || atomic_load (&Countdown) || atomic_load (&Negative))
+        err++;
+    printf ("countdown: %d of %d decrements, end %d, %s\n", dec, cnt,
+            atomic_load (&Countdown), err ? "FAIL" : "PASS");
+
+    // race with the clear : never below 0
+    atomic_store (&Start, 0);   atomic_store (&ClearStop, 0);
+    for (i = 0; i < threads; i++) {
+        w[i].finished = 0;
+        pthread_create (&w[i].th, NULL, counter, &w[i]);
+    }
+    pthread_create (&th, NULL, clearer, NULL);
+    atomic_store (&Start, 1);
+    for (i = 0; i < threads; i++)
+        pthread_join (w[i].th, NULL);
+    atomic_store (&ClearStop, 1);
+    pthread_join (th, NULL);
+    printf ("countdown: clear race, %d negative reads, end %d, %s\n",
+            atomic_load (&Negative), atomic_load (&Countdown),
+            (atomic_load (&Negative) || atomic_load (&Countdown)) ? "FAIL" : "PASS");
+    if (atomic_load (&Negative) || atomic_load (&Countdown))
+        err++;
+    return err;
+}
+
+//------------------------------------------------------------------------------
+static int check_remaining (itemstate_t *s, int n, const char *phase)
+{
+    int i, not_done = 0;
+
+    for (i = 0; i < n; i++)
+        if (itemstate_status (s, i) != eST_STOP)
+            not_done++;
+
+    printf ("%-8s : remaining %d, scan %d, %s\n", phase,
+            itemstate_remaining (s), not_done,
+            (itemstate_remaining (s) == not_done) ? "PASS" : "FAIL");
+    return (itemstate_remaining (s) == not_done) ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+int main (int argc, char **argv)
+{
+    struct worker *w;
+    itemstate_t *s;
+    int opt, threads = 8, n = 40, loops = 200000, i, err = 0, finished = 0;
+
+    while ((opt = getopt (argc, argv, "t:n:l:")) != -1) {
+        switch (opt) {
+            case 't':   threads = atoi (optarg);    break;
+            case 'n':   n       = atoi (optarg);    break;
+            case 'l':   loops   = atoi (optarg);    break;
+            default:
+                printf ("usage : %s [-t threads] [-n items] [-l loops]\n", argv[0]);
+                return 1;
+        }
+    }
+    if ((threads <= 0) || (n <= 0) || (loops <= 0))
+        return 1;
+
+    if ((s = itemstate_init (n, eST_WAIT, 0, eST_STOP)) == NULL)
+        return 1;
+    if ((w = (struct worker *)calloc (threads, sizeof(struct worker))) == NULL)
+        return 1;
+
+    // random transitions
+    for (i = 0; i < threads; i++) {
+        w[i].s = s;     w[i].n = n;     w[i].loops = loops;     w[i].seed = i + 1;
+        pthread_create (&w[i].th, NULL, worker, &w[i]);
+    }
+    atomic_store (&Start, 1);
+    for (i = 0; i < threads; i++)
+        pthread_join (w[i].th, NULL);
+    err += check_remaining (s, n, "random");
+
+    // every item RUN, then all threads race to stop them
+    for (i = 0; i < n; i++)
+        itemstate_set (s, i, eST_RUN, 0);
+    err += check_remaining (s, n, "run");
+    for (i = 0; i < threads; i++)
+        pthread_create (&w[i].th, NULL, finisher, &w[i]);
+    // completion wake up (eventfd), 5 sec limit
+    if (!itemstate_wait (s, 5000) && !itemstate_wait (s, 0)) {
+        printf ("wait     : no completion wake up, FAIL\n");
+        err++;
+    }
+    for (i = 0; i < threads; i++) {
+        pthread_join (w[i].th, NULL);
+        finished += w[i].finished;
+    }
+    err += check_remaining (s, n, "finish");
+    printf ("cas      : %d of %d items stopped once, %s\n", finished, n,
+            (finished == n) ? "PASS" : "FAIL");
+    if (finished != n)
+        err++;
+
+    err += test_countdown (w, threads, loops);
+
+    free (w);
+    itemstate_close (s);
+    return err ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
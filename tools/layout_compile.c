@@ -0,0 +1,118 @@
+//------------------------------------------------------------------------------
+/**
+ * @file layout_compile.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief UI layout compiler (m1.cfg -> m1.lyt) for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * usage : layout_compile [-W width] [-H height] [-b loops] cfg_file blob_file
+ *          -b : startup benchmark (text parse vs blob load)
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <time.h>
+
+//------------------------------------------------------------------------------
+#include "../core/layout.h"
+
+//------------------------------------------------------------------------------
+static long long time_us (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+//------------------------------------------------------------------------------
+static void layout_bench (const char *cfg, const char *blob, int w, int h, int loops)
+{
+    layout_t *ly;
+    long long t_text, t_blob;
+    int i;
+
+    t_text = time_us ();
+    for (i = 0; i < loops; i++)
+        layout_close (layout_parse (cfg, w, h));
+    t_text = time_us () - t_text;
+
+    t_blob = time_us ();
+    for (i = 0; i < loops; i++) {
+        if ((ly = layout_map (blob, cfg, w, h)) == NULL) {
+            printf ("blob load failed (%s)\n", blob);
+            return;
+        }
+        layout_close (ly);
+    }
+    t_blob = time_us () - t_blob;
+
+    printf ("text parse : %6lld us/load\n", t_text / loops);
+    printf ("blob load  : %6lld us/load, x%.1f\n", t_blob / loops,
+            t_blob ? (double)t_text / t_blob : 0.0);
+}
+
+//------------------------------------------------------------------------------
+int main (int argc, char **argv)
+{
+    layout_t *ly;
+    int opt, w = 1920, h = 1080, loops = 0, i;
+
+    while ((opt = getopt (argc, argv, "W:H:b:")) != -1) {
+        switch (opt) {
+            case 'W':   w     = atoi (optarg);  break;
+            case 'H':   h     = atoi (optarg);  break;
+            case 'b':   loops = atoi (optarg);  break;
+            default :
+                printf ("usage : %s [-W width] [-H height] [-b loops] cfg_file blob_file\n", argv[0]);
+                return 1;
+        }
+    }
+    if (optind + 2 > argc) {
+        printf ("usage : %s [-W width] [-H height] [-b loops] cfg_file blob_file\n", argv[0]);
+        return 1;
+    }
+
+    if ((ly = layout_parse (argv[optind], w, h)) == NULL) {
+        printf ("%s : parse error\n", argv[optind]);
+        return 1;
+    }
+    if (!ly->cnt) {
+        printf ("%s : no items (signature missing?)\n", argv[optind]);
+        layout_close (ly);
+        return 1;
+    }
+    // duplicate id : the ui update would hit the wrong box
+    for (i = 0; i < ly->cnt; i++) {
+        if (layout_find (ly, ly->item[i].id) != &ly->item[i]) {
+            printf ("%s : duplicate id %d\n", argv[optind], ly->item[i].id);
+            layout_close (ly);
+            return 1;
+        }
+    }
+    if (!layout_write (ly, argv[optind + 1])) {
+        printf ("%s : write error\n", argv[optind + 1]);
+        layout_close (ly);
+        return 1;
+    }
+    printf ("%s -> %s : %d items, %dx%d, %u bytes\n",
+            argv[optind], argv[optind + 1], ly->cnt, w, h, ly->hdr->size);
+    layout_close (ly);
+
+    if (loops > 0)
+        layout_bench (argv[optind], argv[optind + 1], w, h, loops);
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
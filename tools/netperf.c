@@ -0,0 +1,136 @@
+//------------------------------------------------------------------------------
+/**
+ * @file netperf.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Network throughput client / server for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * usage : netperf -s [-p port] [-n count]
+ *          server (nlp host), count 0 = forever
+ *         netperf -c host [-p port] [-u] [-t ms] [-l len] [-b mbps] [-z]
+ *          client, tcp (-u : udp) throughput, -z : no MSG_ZEROCOPY
+ *         netperf -L [-p port]
+ *          loopback self test (server thread, tcp + udp)
+ *
+ *          veth pair in a network namespace :
+ *            ip netns add jig
+ *            ip link add vjig0 type veth peer name vjig1 netns jig
+ *            ip addr add 10.99.0.1/24 dev vjig0; ip link set vjig0 up
+ *            ip netns exec jig ip addr add 10.99.0.2/24 dev vjig1
+ *            ip netns exec jig ip link set vjig1 up
+ *            ip netns exec jig netperf -s -n 2 &
+ *            netperf -c 10.99.0.2; netperf -c 10.99.0.2 -u
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <pthread.h>
+
+//------------------------------------------------------------------------------
+#include "../check_device/netperf.h"
+
+//------------------------------------------------------------------------------
+static void *server_thread (void *arg)
+{
+    netperf_server_t *s = (netperf_server_t *)arg;
+
+    netperf_server_run (s, 2, NULL);
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+static int client (const struct netperf_cfg *cfg)
+{
+    struct netperf_result r;
+
+    netperf_run (cfg, &r);
+    printf ("%s %s : %d Mbits/sec, %lld bytes, %lld usec", cfg->host,
+            (cfg->mode == eNETPERF_UDP) ? "udp" : "tcp", r.mbps, r.bytes, r.elapsed_us);
+    if (cfg->mode == eNETPERF_UDP)
+        printf (", lost %lld/%lld, reorder %lld, jitter %d usec",
+                r.lost, r.sent, r.reorder, r.jitter_us);
+    else
+        printf (", zerocopy %d", r.zerocopy);
+    printf (", %s\n", r.err ? strerror (r.err) : "ok");
+    return r.err ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+int main (int argc, char **argv)
+{
+    struct netperf_cfg cfg;
+    netperf_server_t *s;
+    pthread_t th;
+    const char *host = NULL;
+    int opt, server = 0, loop = 0, port = NETPERF_PORT, count = 0, err = 0;
+    int mode = eNETPERF_TCP, time = 0, len = 0, rate = -1, zerocopy = 1;
+
+    while ((opt = getopt (argc, argv, "sc:Lp:n:ut:l:b:z")) != -1) {
+        switch (opt) {
+            case 's':   server   = 1;               break;
+            case 'c':   host     = optarg;          break;
+            case 'L':   loop     = 1;               break;
+            case 'p':   port     = atoi (optarg);   break;
+            case 'n':   count    = atoi (optarg);   break;
+            case 'u':   mode     = eNETPERF_UDP;    break;
+            case 't':   time     = atoi (optarg);   break;
+            case 'l':   len      = atoi (optarg);   break;
+            case 'b':   rate     = atoi (optarg);   break;
+            case 'z':   zerocopy = 0;               break;
+            default:
+                goto usage;
+        }
+    }
+    if (server) {
+        if ((s = netperf_server_init (port)) == NULL)
+            return 1;
+        printf ("netperf server : port %d\n", port);
+        netperf_server_run (s, count, NULL);
+        netperf_server_close (s);
+        return 0;
+    }
+    if (loop) {
+        if ((s = netperf_server_init (port)) == NULL)
+            return 1;
+        pthread_create (&th, NULL, server_thread, s);
+
+        netperf_default (&cfg, "127.0.0.1", eNETPERF_TCP);
+        cfg.port = port;
+        err += client (&cfg);
+        netperf_default (&cfg, "127.0.0.1", eNETPERF_UDP);
+        cfg.port = port;
+        err += client (&cfg);
+
+        pthread_join (th, NULL);
+        netperf_server_close (s);
+        return err ? 1 : 0;
+    }
+    if (host == NULL)
+        goto usage;
+
+    netperf_default (&cfg, host, mode);
+    cfg.port     = port;
+    cfg.zerocopy = zerocopy;
+    if (time)       cfg.duration_ms = time;
+    if (len)        cfg.len         = len;
+    if (rate >= 0)  cfg.rate_mbps   = rate;
+    return client (&cfg);
+
+usage:
+    printf ("usage : %s -s [-p port] [-n count]\n", argv[0]);
+    printf ("        %s -c host [-p port] [-u] [-t ms] [-l len] [-b mbps] [-z]\n", argv[0]);
+    printf ("        %s -L [-p port]\n", argv[0]);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,174 @@
+//------------------------------------------------------------------------------
+/**
+ * @file nlp_discover.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief NLP server discovery test for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * usage : nlp_discover -i my_ip [-p port] [-c cache]
+ *          cached server probe, then the /24 connect sweep
+ *          (open port only, no protocol confirm)
+ *         nlp_discover -L [-p port]
+ *          loopback self test : stand-in server on 127.0.0.77 answers the
+ *          confirm exchange, a silent listener on 127.0.0.66 must never be
+ *          accepted or cached. cache on the listener (sweep + cache update),
+ *          then the cached probe, then the listener only (cache unchanged).
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+//------------------------------------------------------------------------------
+#include "../check_device/discover.h"
+
+//------------------------------------------------------------------------------
+#define LOOP_SERVER     "127.0.0.77"
+#define LOOP_LISTENER   "127.0.0.66"
+#define LOOP_CACHE      "/tmp/nlp_discover.cache"
+
+// stand-in protocol exchange
+#define LOOP_REQ        "nlp?"
+#define LOOP_ACK        "nlp"
+#define LOOP_CONFIRM_MS 100
+
+//------------------------------------------------------------------------------
+static int stand_in_server (const char *ip, int port)
+{
+    struct sockaddr_in sa;
+    int fd, on = 1;
+
+    if ((fd = socket (AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0)) < 0)
+        return -1;
+    setsockopt (fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    memset (&sa, 0, sizeof(sa));
+    sa.sin_family = AF_INET;
+    sa.sin_port   = htons (port);
+    inet_aton (ip, &sa.sin_addr);
+    if ((bind (fd, (struct sockaddr *)&sa, sizeof(sa)) < 0) || (listen (fd, 256) < 0)) {
+        close (fd);
+        return -1;
+    }
+    return fd;
+}
+
+//------------------------------------------------------------------------------
+// stand-in server : answer every request with the ack
+//------------------------------------------------------------------------------
+static void *server_thread (void *arg)
+{
+    int fd = *(int *)arg, c;
+    char buf[16];
+
+    while ((c = accept (fd, NULL, NULL)) >= 0) {
+        if (recv (c, buf, sizeof(buf), 0) > 0)
+            send (c, LOOP_ACK, strlen (LOOP_ACK), MSG_NOSIGNAL);
+        close (c);
+    }
+    return arg;
+}
+
+//------------------------------------------------------------------------------
+static int loop_confirm (const char *ip, int port)
+{
+    return discover_exchange (ip, port, LOOP_REQ, LOOP_ACK, LOOP_CONFIRM_MS);
+}
+
+//------------------------------------------------------------------------------
+static int loop_test (int port)
+{
+    char found[DISCOVER_IP_SIZE], cached[DISCOVER_IP_SIZE];
+    pthread_t th;
+    int fd, lfd, err = 0;
+
+    // listener : port open, no reply (accepted by the backlog only)
+    if (((fd  = stand_in_server (LOOP_SERVER,   port)) < 0) ||
+        ((lfd = stand_in_server (LOOP_LISTENER, port)) < 0)) {
+        printf ("%s:%d bind error\n", LOOP_SERVER, port);
+        return 1;
+    }
+    pthread_create (&th, NULL, server_thread, &fd);
+
+    // cache on a host that only has the port open
+    discover_cache_write (LOOP_CACHE, LOOP_LISTENER);
+
+    if (!discover_server (LOOP_CACHE, "127.0.0.1", port, loop_confirm, found) ||
+        strcmp (found, LOOP_SERVER))
+        err++;
+    if (!discover_cache_read (LOOP_CACHE, cached) || strcmp (cached, LOOP_SERVER))
+        err++;
+    printf ("sweep  : %s, cache %s, %s\n", found, cached, err ? "FAIL" : "PASS");
+
+    if (!discover_server (LOOP_CACHE, "127.0.0.1", port, loop_confirm, found) ||
+        strcmp (found, LOOP_SERVER))
+        err++;
+    printf ("cached : %s, %s\n", found, err ? "FAIL" : "PASS");
+
+    // server gone, listener left : not found, cache untouched
+    shutdown (fd, SHUT_RDWR);
+    pthread_join (th, NULL);
+    close (fd);
+    if (discover_server (LOOP_CACHE, "127.0.0.1", port, loop_confirm, found)) {
+        printf ("listener : found %s, FAIL\n", found);
+        err++;
+    }
+    if (!discover_cache_read (LOOP_CACHE, cached) || strcmp (cached, LOOP_SERVER)) {
+        printf ("listener : cache %s, FAIL\n", cached);
+        err++;
+    }
+    close (lfd);
+    if (discover_server (NULL, "127.0.0.1", port, loop_confirm, found)) {
+        printf ("no server : found %s, FAIL\n", found);
+        err++;
+    }
+    unlink (LOOP_CACHE);
+    printf ("%s\n", err ? "FAIL" : "PASS");
+    return err ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+int main (int argc, char **argv)
+{
+    const char *my_ip = NULL, *cache = NULL;
+    char found[DISCOVER_IP_SIZE];
+    int opt, port = 8888, loop = 0;
+
+    while ((opt = getopt (argc, argv, "i:p:c:L")) != -1) {
+        switch (opt) {
+            case 'i':   my_ip = optarg;         break;
+            case 'p':   port  = atoi (optarg);  break;
+            case 'c':   cache = optarg;         break;
+            case 'L':   loop  = 1;              break;
+            default:
+                goto usage;
+        }
+    }
+    if (loop)
+        return loop_test (port);
+    if (my_ip == NULL)
+        goto usage;
+
+    return discover_server (cache, my_ip, port, NULL, found) ? 0 : 1;
+
+usage:
+    printf ("usage : %s -i my_ip [-p port] [-c cache]\n", argv[0]);
+    printf ("        %s -L [-p port]\n", argv[0]);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,333 @@
+//------------------------------------------------------------------------------
+/**
+ * @file outbox_bench.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Server message latency benchmark for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * usage : outbox_bench [-r rounds] [-b burst] [-s server_us] [-p port]
+ *          loopback stand-in server (one "ok" line per message line,
+ *          server_us of work per message). Each round posts a burst of
+ *          messages (errcode lines + mac label) and waits for delivery.
+ *            sync    : caller sends, one connection per message (today)
+ *            async   : sender thread, one connection per message
+ *            pipe    : sender thread, persistent connection, the batch
+ *                      written at once and the acks read after (pipelined)
+ *          the jig runs async (nlp_server_write per message). pipe is the
+ *          stand-in protocol only, nlp_server_ctrl has no connection api.
+ *          caller = time the posting thread is blocked for the burst,
+ *          deliver = first post to the last ack.
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <poll.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+//------------------------------------------------------------------------------
+#include "../core/outbox.h"
+
+//------------------------------------------------------------------------------
+#define SERVER_CONN_MAX     16
+#define ROUND_MAX           10000
+
+static int Port = 5230, ServerUs = 0;
+static atomic_int ServerStop = 0;
+
+//------------------------------------------------------------------------------
+static long long time_us (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+//------------------------------------------------------------------------------
+static int int_compare (const void *a, const void *b)
+{
+    return *(const int *)a - *(const int *)b;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// stand-in server
+//------------------------------------------------------------------------------
+struct conn {
+    int     fd, len;
+    char    buf[1024];
+};
+
+//------------------------------------------------------------------------------
+// return 0 = connection closed
+//------------------------------------------------------------------------------
+static int server_read (struct conn *c)
+{
+    char *nl, ack[OUTBOX_MSG_MAX * 3];
+    int ret, acks = 0;
+
+    if ((ret = read (c->fd, c->buf + c->len, sizeof(c->buf) - c->len - 1)) <= 0)
+        return 0;
+    c->len += ret;
+    c->buf[c->len] = 0;
+
+    while ((nl = strchr (c->buf, '\n')) != NULL) {
+        if (ServerUs)
+            usleep (ServerUs);
+        if (acks < OUTBOX_MSG_MAX)
+            memcpy (&ack[acks++ * 3], "ok\n", 3);
+        c->len -= (nl + 1 - c->buf);
+        memmove (c->buf, nl + 1, c->len + 1);
+    }
+    if (acks && (write (c->fd, ack, acks * 3) != acks * 3))
+        return 0;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+static void *server_thread (void *arg)
+{
+    struct pollfd pfd [SERVER_CONN_MAX + 1];
+    struct conn conn [SERVER_CONN_MAX];
+    int lfd = *(int *)arg, i, fd;
+
+    for (i = 0; i < SERVER_CONN_MAX; i++)
+        conn[i].fd = -1;
+
+    while (!atomic_load (&ServerStop)) {
+        pfd[0].fd = lfd;    pfd[0].events = POLLIN;
+        for (i = 0; i < SERVER_CONN_MAX; i++) {
+            pfd[i + 1].fd     = conn[i].fd;
+            pfd[i + 1].events = POLLIN;
+        }
+        if (poll (pfd, SERVER_CONN_MAX + 1, 100) <= 0)
+            continue;
+
+        if ((pfd[0].revents & POLLIN) && ((fd = accept (lfd, NULL, NULL)) >= 0)) {
+            for (i = 0; i < SERVER_CONN_MAX; i++)
+                if (conn[i].fd < 0)
+                    break;
+            if (i < SERVER_CONN_MAX) {
+                conn[i].fd = fd;    conn[i].len = 0;
+            } else {
+                close (fd);
+            }
+        }
+        for (i = 0; i < SERVER_CONN_MAX; i++) {
+            if ((conn[i].fd < 0) || !pfd[i + 1].revents)
+                continue;
+            if (!server_read (&conn[i])) {
+                close (conn[i].fd);
+                conn[i].fd = -1;
+            }
+        }
+    }
+    for (i = 0; i < SERVER_CONN_MAX; i++)
+        if (conn[i].fd >= 0)
+            close (conn[i].fd);
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+static int server_open (void)
+{
+    struct sockaddr_in sa;
+    int fd, on = 1;
+
+    if ((fd = socket (AF_INET, SOCK_STREAM, 0)) < 0)
+        return -1;
+    setsockopt (fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    memset (&sa, 0, sizeof(sa));
+    sa.sin_family      = AF_INET;
+    sa.sin_port        = htons (Port);
+    sa.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+    if ((bind (fd, (struct sockaddr *)&sa, sizeof(sa)) < 0) || (listen (fd, 64) < 0)) {
+        close (fd);
+        return -1;
+    }
+    return fd;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// transports
+//------------------------------------------------------------------------------
+static int client_connect (const char *dst)
+{
+    struct sockaddr_in sa;
+    int fd, on = 1;
+
+    if ((fd = socket (AF_INET, SOCK_STREAM, 0)) < 0)
+        return -1;
+    setsockopt (fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    memset (&sa, 0, sizeof(sa));
+    sa.sin_family = AF_INET;
+    sa.sin_port   = htons (Port);
+    inet_aton (dst, &sa.sin_addr);
+    if (connect (fd, (struct sockaddr *)&sa, sizeof(sa)) < 0) {
+        close (fd);
+        return -1;
+    }
+    return fd;
+}
+
+//------------------------------------------------------------------------------
+// return 1 = cnt acks read
+//------------------------------------------------------------------------------
+static int read_acks (int fd, int cnt)
+{
+    char buf[OUTBOX_MSG_MAX * 3];
+    int len = 0, ret;
+
+    while (len < cnt * 3) {
+        if ((ret = read (fd, buf + len, cnt * 3 - len)) <= 0)
+            return 0;
+        len += ret;
+    }
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// nlp_server_write model : connect, message, ack, close
+//------------------------------------------------------------------------------
+static int conn_send (char *dst, char type, char *msg, char ch)
+{
+    char line[OUTBOX_MSG_SIZE + 8];
+    int fd, len, ret;
+
+    if ((fd = client_connect (dst)) < 0)
+        return 0;
+    len = snprintf (line, sizeof(line), "%c %d %s\n", type, ch, msg);
+    ret = (write (fd, line, len) == len) && read_acks (fd, 1);
+    close (fd);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+// persistent connection, batch written at once, acks read after
+//------------------------------------------------------------------------------
+static int pipe_batch (const char *dst, const struct outbox_msg *m, int cnt, void *arg)
+{
+    char buf[OUTBOX_MSG_MAX * (OUTBOX_MSG_SIZE + 8)];
+    int *fd = (int *)arg, i, len = 0;
+
+    for (i = 0; i < cnt; i++)
+        len += snprintf (&buf[len], sizeof(buf) - len, "%c %d %s\n", m[i].type, m[i].ch, m[i].msg);
+
+    // one reconnect when the server dropped the connection
+    for (i = 0; i < 2; i++) {
+        if ((*fd < 0) && ((*fd = client_connect (dst)) < 0))
+            return 0;
+        if ((write (*fd, buf, len) == len) && read_acks (*fd, cnt))
+            return cnt;
+        close (*fd);
+        *fd = -1;
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+enum { eMODE_SYNC = 0, eMODE_ASYNC, eMODE_PIPE, eMODE_END };
+
+static const char *ModeName [eMODE_END] = { "sync", "async", "pipe" };
+
+//------------------------------------------------------------------------------
+static int bench (int mode, int rounds, int burst)
+{
+    static int caller [ROUND_MAX], deliver [ROUND_MAX];
+    outbox_t *o;
+    long long t0, t1;
+    int i, j, fd = -1, fail = 0, ret;
+    char msg[32];
+
+    if ((o = outbox_init (conn_send)) == NULL)
+        return 1;
+    if (mode == eMODE_PIPE)
+        outbox_set_batch (o, pipe_batch, &fd);
+    if ((mode != eMODE_SYNC) && !outbox_start (o))
+        return 1;
+    outbox_set_dst (o, "127.0.0.1");
+
+    for (i = 0; i < rounds; i++) {
+        t0 = time_us ();
+        for (j = 0; j < burst; j++) {
+            snprintf (msg, sizeof(msg), "err%d,item%d,", i, j);
+            outbox_post (o, (j == burst - 1) ? 'm' : 'e', msg, 0);
+        }
+        t1 = time_us ();
+        if (!outbox_wait (o, 2000) || outbox_pending (o))
+            fail++;
+        caller [i] = (int)(t1 - t0);
+        deliver[i] = (int)(time_us () - t0);
+    }
+    qsort (caller,  rounds, sizeof(int), int_compare);
+    qsort (deliver, rounds, sizeof(int), int_compare);
+
+    ret = (fail || (o->sent != rounds * burst)) ? 1 : 0;
+    printf ("%-6s : caller p50 %6d p99 %6d us, deliver p50 %6d p99 %6d us, "
+            "sent %d, batches %d, %s\n", ModeName[mode],
+            caller [rounds / 2], caller [(rounds * 99) / 100],
+            deliver[rounds / 2], deliver[(rounds * 99) / 100],
+            o->sent, o->batches, ret ? "FAIL" : "PASS");
+
+    outbox_close (o);
+    if (fd >= 0)
+        close (fd);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+int main (int argc, char **argv)
+{
+    pthread_t th;
+    int opt, rounds = 200, burst = 4, lfd, mode, err = 0;
+
+    while ((opt = getopt (argc, argv, "r:b:s:p:")) != -1) {
+        switch (opt) {
+            case 'r':   rounds   = atoi (optarg);   break;
+            case 'b':   burst    = atoi (optarg);   break;
+            case 's':   ServerUs = atoi (optarg);   break;
+            case 'p':   Port     = atoi (optarg);   break;
+            default:
+                printf ("usage : %s [-r rounds] [-b burst] [-s server_us] [-p port]\n", argv[0]);
+                return 1;
+        }
+    }
+    if ((rounds <= 0) || (rounds > ROUND_MAX) || (burst <= 0) || (burst > OUTBOX_MSG_MAX))
+        return 1;
+    if ((lfd = server_open ()) < 0) {
+        printf ("stand-in server : port %d error (%s)\n", Port, strerror (errno));
+        return 1;
+    }
+    pthread_create (&th, NULL, server_thread, &lfd);
+
+    printf ("%d rounds x %d messages, server %d us/message\n", rounds, burst, ServerUs);
+    for (mode = 0; mode < eMODE_END; mode++)
+        err += bench (mode, rounds, burst);
+
+    atomic_store (&ServerStop, 1);
+    pthread_join (th, NULL);
+    close (lfd);
+    return err ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,209 @@
+//------------------------------------------------------------------------------
+/**
+ * @file outbox_check.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Server message outbox test for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * usage : outbox_check [-d delay_ms] [-t threads] [-n messages] [-p port]
+ *          test threads post messages from the start, a stand-in server
+ *          on 127.0.0.1 comes up after delay_ms and is found by the
+ *          discovery probe. Every message must arrive once, in the posted
+ *          order of each thread.
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+//------------------------------------------------------------------------------
+#include "../core/outbox.h"
+#include "../check_device/discover.h"
+
+//------------------------------------------------------------------------------
+#define THREAD_MAX      8
+#define MSG_PER_MAX     (OUTBOX_MSG_MAX / THREAD_MAX)
+
+static int Port = 5210, Delay = 1000, Threads = 4, Msgs = 4;
+static long long Start;
+
+// stand-in server record
+static int Recv [THREAD_MAX][MSG_PER_MAX], RecvCnt [THREAD_MAX], RecvErr = 0;
+static long long FirstRecv = 0;
+
+//------------------------------------------------------------------------------
+static long long time_ms (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+//------------------------------------------------------------------------------
+// one connection per message : "type ch thread:seq"
+//------------------------------------------------------------------------------
+static int send_msg (char *dst, char type, char *msg, char ch)
+{
+    struct sockaddr_in sa;
+    char buf[OUTBOX_MSG_SIZE + 8];
+    int fd, len, ret;
+
+    if ((fd = socket (AF_INET, SOCK_STREAM, 0)) < 0)
+        return 0;
+    memset (&sa, 0, sizeof(sa));
+    sa.sin_family = AF_INET;
+    sa.sin_port   = htons (Port);
+    inet_aton (dst, &sa.sin_addr);
+
+    len = snprintf (buf, sizeof(buf), "%c %d %s", type, ch, msg);
+    ret = (connect (fd, (struct sockaddr *)&sa, sizeof(sa)) == 0) &&
+          (write (fd, buf, len) == len);
+    close (fd);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+static void *server_thread (void *arg)
+{
+    struct sockaddr_in sa;
+    char buf[OUTBOX_MSG_SIZE + 8], type;
+    int lfd, fd, len, ch, th, seq, total = 0, on = 1;
+
+    (void)arg;
+    usleep (Delay * 1000);
+
+    lfd = socket (AF_INET, SOCK_STREAM, 0);
+    setsockopt (lfd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    memset (&sa, 0, sizeof(sa));
+    sa.sin_family      = AF_INET;
+    sa.sin_port        = htons (Port);
+    sa.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+    if ((bind (lfd, (struct sockaddr *)&sa, sizeof(sa)) < 0) || (listen (lfd, 64) < 0)) {
+        printf ("stand-in server : port %d error\n", Port);
+        RecvErr++;
+        return NULL;
+    }
+    printf ("stand-in server : up at %lld ms\n", time_ms () - Start);
+
+    while (total < Threads * Msgs) {
+        if ((fd = accept (lfd, NULL, NULL)) < 0)
+            break;
+        if ((len = read (fd, buf, sizeof(buf) - 1)) > 0) {
+            buf[len] = 0;
+            // discovery probe : connect only
+            if ((sscanf (buf, "%c %d %d:%d", &type, &ch, &th, &seq) == 4) &&
+                (th < Threads) && (RecvCnt[th] < MSG_PER_MAX)) {
+                if (!FirstRecv)
+                    FirstRecv = time_ms () - Start;
+                Recv[th][RecvCnt[th]++] = seq;
+                total++;
+            }
+        }
+        close (fd);
+    }
+    close (lfd);
+    return NULL;
+}
+
+struct tester {
+    pthread_t       th;
+    outbox_t        *o;
+    int             id;
+};
+
+//------------------------------------------------------------------------------
+// posts spread over the time before and after the server comes up
+//------------------------------------------------------------------------------
+static void *test_thread (void *arg)
+{
+    struct tester *t = (struct tester *)arg;
+    unsigned int seed = t->id + 1;
+    char msg[16];
+    int i;
+
+    for (i = 0; i < Msgs; i++) {
+        usleep ((rand_r (&seed) % (2 * Delay / Msgs + 1)) * 1000);
+        snprintf (msg, sizeof(msg), "%d:%d", t->id, i);
+        outbox_post (t->o, 'e', msg, 0);
+    }
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+int main (int argc, char **argv)
+{
+    struct tester t [THREAD_MAX];
+    pthread_t srv;
+    char found[DISCOVER_IP_SIZE];
+    outbox_t *o;
+    int opt, i, j, err = 0;
+
+    while ((opt = getopt (argc, argv, "d:t:n:p:")) != -1) {
+        switch (opt) {
+            case 'd':   Delay   = atoi (optarg);    break;
+            case 't':   Threads = atoi (optarg);    break;
+            case 'n':   Msgs    = atoi (optarg);    break;
+            case 'p':   Port    = atoi (optarg);    break;
+            default:
+                printf ("usage : %s [-d delay_ms] [-t threads] [-n messages] [-p port]\n", argv[0]);
+                return 1;
+        }
+    }
+    if ((Threads <= 0) || (Threads > THREAD_MAX) || (Msgs <= 0) || (Msgs > MSG_PER_MAX) ||
+        (Delay < 0))
+        return 1;
+    if ((o = outbox_init (send_msg)) == NULL)
+        return 1;
+
+    Start = time_ms ();
+    pthread_create (&srv, NULL, server_thread, NULL);
+    for (i = 0; i < Threads; i++) {
+        t[i].o = o;     t[i].id = i;
+        pthread_create (&t[i].th, NULL, test_thread, &t[i]);
+    }
+
+    // task_server : retry until the server answers
+    while (!discover_probe ("127.0.0.1", Port, DISCOVER_PROBE_MS))
+        usleep (100 * 1000);
+    snprintf (found, sizeof(found), "%s", "127.0.0.1");
+    printf ("server found    : %lld ms, %d messages queued\n", time_ms () - Start,
+            outbox_pending (o));
+    outbox_set_dst (o, found);
+
+    for (i = 0; i < Threads; i++)
+        pthread_join (t[i].th, NULL);
+    pthread_join (srv, NULL);
+
+    for (i = 0; i < Threads; i++) {
+        if (RecvCnt[i] != Msgs)
+            err++;
+        for (j = 0; j < RecvCnt[i]; j++)
+            if (Recv[i][j] != j)
+                err++;
+    }
+    printf ("first message   : %lld ms\n", FirstRecv);
+    printf ("received        : %d threads x %d messages, sent %d, dropped %d, pending %d, %s\n",
+            Threads, Msgs, o->sent, o->dropped, outbox_pending (o),
+            (err || RecvErr || outbox_pending (o)) ? "FAIL" : "PASS");
+
+    outbox_close (o);
+    return (err || RecvErr) ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
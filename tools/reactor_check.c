@@ -0,0 +1,446 @@
+//------------------------------------------------------------------------------
+/**
+ * @file reactor_check.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Event loop test with injected sources for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * usage : reactor_check [-p pipes] [-n messages] [-u uinput]
+ *          pipe   : writer threads feed pipes, every message must be dispatched
+ *                   once and in order (dispatch latency reported).
+ *          remove : a handler returning -1 and reactor_remove() stop dispatch.
+ *          timer  : a 10 ms timer ticks at its period.
+ *          stop   : a handler stops reactor_run() in the calling thread.
+ *          uinput : key events of a virtual input device (-u /dev/uinput,
+ *                   skipped when the device can not be opened).
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// pipe2
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/ioctl.h>
+#include <linux/input.h>
+#include <linux/uinput.h>
+
+//------------------------------------------------------------------------------
+#include "../core/reactor.h"
+
+//------------------------------------------------------------------------------
+#define PIPE_MAX        8
+#define TIMER_MS        10
+#define TIMER_RUN_MS    300
+#define UINPUT_NAME     "reactor_check"
+
+struct msg {
+    int             id, seq;
+    long long       t_us;
+};
+
+struct feed {
+    pthread_t       th;
+    int             fd [2], id, cnt;
+    // received, out of order, last sequence
+    atomic_int      rx;
+    int             order_err, last;
+    // dispatch latency (usec)
+    long long       lat_sum, lat_max;
+};
+
+static atomic_int   Calls;
+
+//------------------------------------------------------------------------------
+static long long time_us (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+//------------------------------------------------------------------------------
+static int wait_count (atomic_int *v, int cnt, int timeout_ms)
+{
+    while ((atomic_load (v) < cnt) && (timeout_ms-- > 0))
+        usleep (1000);
+    return atomic_load (v);
+}
+
+//------------------------------------------------------------------------------
+static void *writer (void *arg)
+{
+    struct feed *f = (struct feed *)arg;
+    struct msg m;
+    int i;
+
+    for (i = 0; i < f->cnt; i++) {
+        m.id = f->id;   m.seq = i;  m.t_us = time_us ();
+        if (write (f->fd[1], &m, sizeof(m)) != sizeof(m))
+            break;
+        if (!(i % 64))
+            usleep (100);
+    }
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+// pipe reader (reactor thread), messages are written atomically (< PIPE_BUF)
+//------------------------------------------------------------------------------
+static int feed_event (int fd, unsigned int events, void *arg)
+{
+    struct feed *f = (struct feed *)arg;
+    struct msg m;
+    long long lat;
+
+    (void)events;
+    while (read (fd, &m, sizeof(m)) == sizeof(m)) {
+        if ((m.id != f->id) || (m.seq != f->last + 1))
+            f->order_err++;
+        f->last = m.seq;
+        lat = time_us () - m.t_us;
+        f->lat_sum += lat;
+        if (lat > f->lat_max)
+            f->lat_max = lat;
+        atomic_fetch_add (&f->rx, 1);
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+static int check_pipe (int pipes, int cnt)
+{
+    struct feed f [PIPE_MAX];
+    long long lat_sum = 0, lat_max = 0;
+    reactor_t *r;
+    int i, err = 0;
+
+    if ((r = reactor_init ()) == NULL)
+        return 1;
+
+    memset (f, 0, sizeof(f));
+    for (i = 0; i < pipes; i++) {
+        f[i].id = i;    f[i].cnt = cnt;     f[i].last = -1;
+        if (pipe2 (f[i].fd, O_NONBLOCK | O_CLOEXEC) < 0)
+            return 1;
+        // writer blocks when the pipe is full
+        fcntl (f[i].fd[1], F_SETFL, 0);
+        if (reactor_add_fd (r, f[i].fd[0], feed_event, &f[i]) < 0)
+            err++;
+    }
+    reactor_start (r);
+    for (i = 0; i < pipes; i++)
+        pthread_create (&f[i].th, NULL, writer, &f[i]);
+    for (i = 0; i < pipes; i++) {
+        pthread_join (f[i].th, NULL);
+        wait_count (&f[i].rx, cnt, 1000);
+    }
+    reactor_close (r);
+
+    for (i = 0; i < pipes; i++) {
+        if ((atomic_load (&f[i].rx) != cnt) || f[i].order_err) {
+            printf ("pipe     : %d, received %d of %d, order err %d\n",
+                    i, atomic_load (&f[i].rx), cnt, f[i].order_err);
+            err++;
+        }
+        lat_sum += f[i].lat_sum;
+        if (f[i].lat_max > lat_max)
+            lat_max = f[i].lat_max;
+        close (f[i].fd[0]);     close (f[i].fd[1]);
+    }
+    printf ("pipe     : %d pipes x %d messages, latency avg %lld us, max %lld us, %s\n",
+            pipes, cnt, lat_sum / (pipes * cnt), lat_max, err ? "FAIL" : "PASS");
+    return err;
+}
+
+//------------------------------------------------------------------------------
+// counts the calls, removes itself at the 5th
+//------------------------------------------------------------------------------
+static int once_event (int fd, unsigned int events, void *arg)
+{
+    char c;
+
+    (void)events;   (void)arg;
+    while (read (fd, &c, 1) == 1)
+        ;
+    return (atomic_fetch_add (&Calls, 1) == 4) ? -1 : 0;
+}
+
+//------------------------------------------------------------------------------
+static int keep_event (int fd, unsigned int events, void *arg)
+{
+    char c;
+
+    (void)events;
+    while (read (fd, &c, 1) == 1)
+        atomic_fetch_add ((atomic_int *)arg, 1);
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+static int check_remove (void)
+{
+    reactor_t *r;
+    atomic_int kept;
+    int a [2], b [2], i, err = 0;
+
+    if ((r = reactor_init ()) == NULL)
+        return 1;
+    if ((pipe2 (a, O_NONBLOCK) < 0) || (pipe2 (b, O_NONBLOCK) < 0))
+        return 1;
+
+    atomic_store (&Calls, 0);   atomic_store (&kept, 0);
+    reactor_add_fd (r, a[0], once_event, NULL);
+    reactor_add_fd (r, b[0], keep_event, &kept);
+    reactor_start (r);
+
+    // handler return -1 : removed after the 5th call
+    for (i = 0; i < 10; i++) {
+        if (write (a[1], "x", 1) != 1)
+            err++;
+        usleep (2000);
+    }
+    if (atomic_load (&Calls) != 5) {
+        printf ("remove   : handler called %d times after returning -1\n", atomic_load (&Calls));
+        err++;
+    }
+    // reactor_remove from another thread
+    if (write (b[1], "x", 1) != 1)
+        err++;
+    wait_count (&kept, 1, 1000);
+    if (!reactor_remove (r, b[0]) || reactor_remove (r, b[0]))
+        err++;
+    if (write (b[1], "x", 1) != 1)
+        err++;
+    usleep (20000);
+    if (atomic_load (&kept) != 1) {
+        printf ("remove   : %d events after reactor_remove\n", atomic_load (&kept) - 1);
+        err++;
+    }
+    reactor_close (r);
+    close (a[0]);   close (a[1]);   close (b[0]);   close (b[1]);
+
+    printf ("remove   : %s\n", err ? "FAIL" : "PASS");
+    return err;
+}
+
+//------------------------------------------------------------------------------
+static int tick_event (int fd, unsigned int events, void *arg)
+{
+    (void)fd;   (void)events;
+    atomic_fetch_add ((atomic_int *)arg, 1);
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+static int check_timer (void)
+{
+    reactor_t *r;
+    atomic_int ticks;
+    int n, err = 0;
+
+    if ((r = reactor_init ()) == NULL)
+        return 1;
+
+    atomic_store (&ticks, 0);
+    if (reactor_add_timer (r, TIMER_MS, tick_event, &ticks) < 0)
+        err++;
+    reactor_start (r);
+    usleep (TIMER_RUN_MS * 1000);
+    reactor_close (r);
+
+    // expire count of a late wakeup is merged into one call
+    n = atomic_load (&ticks);
+    if ((n < TIMER_RUN_MS / TIMER_MS * 8 / 10) || (n > TIMER_RUN_MS / TIMER_MS + 1))
+        err++;
+    printf ("timer    : %d ms period, %d ticks in %d ms, %s\n",
+            TIMER_MS, n, TIMER_RUN_MS, err ? "FAIL" : "PASS");
+    return err;
+}
+
+//------------------------------------------------------------------------------
+static int stop_event (int fd, unsigned int events, void *arg)
+{
+    char c;
+
+    (void)events;
+    while (read (fd, &c, 1) == 1)
+        ;
+    atomic_store (&((reactor_t *)arg)->stop, 1);
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// reactor_run in this thread, returns when a handler sets stop
+//------------------------------------------------------------------------------
+static int check_stop (void)
+{
+    reactor_t *r;
+    int fd [2], ret, err = 0;
+
+    if ((r = reactor_init ()) == NULL)
+        return 1;
+    if (pipe2 (fd, O_NONBLOCK) < 0)
+        return 1;
+
+    reactor_add_fd (r, fd[0], stop_event, r);
+    if (write (fd[1], "x", 1) != 1)
+        err++;
+    if ((ret = reactor_run (r)) != 1)
+        err++;
+    reactor_close (r);
+    close (fd[0]);  close (fd[1]);
+
+    printf ("stop     : reactor_run return %d, %s\n", ret, err ? "FAIL" : "PASS");
+    return err;
+}
+
+//------------------------------------------------------------------------------
+static int key_event (int fd, unsigned int events, void *arg)
+{
+    struct input_event ev;
+
+    (void)events;
+    while (read (fd, &ev, sizeof(ev)) == sizeof(ev))
+        if (ev.type == EV_KEY)
+            atomic_fetch_add ((atomic_int *)arg, 1);
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// evdev node of the uinput device (by name)
+//------------------------------------------------------------------------------
+static int evdev_open (const char *name)
+{
+    struct dirent *d;
+    char path[300], dev_name[64];
+    DIR *dir;
+    int fd = -1;
+
+    if ((dir = opendir ("/dev/input")) == NULL)
+        return -1;
+    while ((d = readdir (dir)) != NULL) {
+        if (strncmp (d->d_name, "event", 5))
+            continue;
+        snprintf (path, sizeof(path), "/dev/input/%s", d->d_name);
+        if ((fd = open (path, O_RDONLY | O_NONBLOCK | O_CLOEXEC)) < 0)
+            continue;
+        memset (dev_name, 0, sizeof(dev_name));
+        if ((ioctl (fd, EVIOCGNAME(sizeof(dev_name) - 1), dev_name) >= 0) &&
+            !strcmp (dev_name, name))
+            break;
+        close (fd);
+        fd = -1;
+    }
+    closedir (dir);
+    return fd;
+}
+
+//------------------------------------------------------------------------------
+static void emit (int fd, int type, int code, int value)
+{
+    struct input_event ev;
+
+    memset (&ev, 0, sizeof(ev));
+    ev.type = type;     ev.code = code;     ev.value = value;
+    if (write (fd, &ev, sizeof(ev)) != sizeof(ev))
+        printf ("uinput   : write error\n");
+}
+
+//------------------------------------------------------------------------------
+static int check_uinput (const char *dev, int cnt)
+{
+    struct uinput_setup us;
+    reactor_t *r;
+    atomic_int keys;
+    int ufd, efd, i, n, err = 0;
+
+    if ((ufd = open (dev, O_WRONLY | O_NONBLOCK | O_CLOEXEC)) < 0) {
+        printf ("uinput   : %s open error, skip\n", dev);
+        return 0;
+    }
+    memset (&us, 0, sizeof(us));
+    us.id.bustype = BUS_VIRTUAL;
+    snprintf (us.name, sizeof(us.name), "%s", UINPUT_NAME);
+    if ((ioctl (ufd, UI_SET_EVBIT, EV_KEY) < 0) || (ioctl (ufd, UI_SET_KEYBIT, KEY_ENTER) < 0) ||
+        (ioctl (ufd, UI_DEV_SETUP, &us) < 0) || (ioctl (ufd, UI_DEV_CREATE) < 0)) {
+        printf ("uinput   : device create error, skip\n");
+        close (ufd);
+        return 0;
+    }
+    // udev creates the node
+    for (i = 0; (i < 100) && ((efd = evdev_open (UINPUT_NAME)) < 0); i++)
+        usleep (10000);
+    if (efd < 0) {
+        printf ("uinput   : evdev node not found\n");
+        ioctl (ufd, UI_DEV_DESTROY);
+        close (ufd);
+        return 1;
+    }
+
+    atomic_store (&keys, 0);
+    if ((r = reactor_init ()) == NULL)
+        return 1;
+    reactor_add_fd (r, efd, key_event, &keys);
+    reactor_start (r);
+    for (i = 0; i < cnt; i++) {
+        emit (ufd, EV_KEY, KEY_ENTER, 1);   emit (ufd, EV_SYN, SYN_REPORT, 0);
+        emit (ufd, EV_KEY, KEY_ENTER, 0);   emit (ufd, EV_SYN, SYN_REPORT, 0);
+        usleep (1000);
+    }
+    n = wait_count (&keys, cnt * 2, 1000);
+    reactor_close (r);
+    ioctl (ufd, UI_DEV_DESTROY);
+    close (efd);    close (ufd);
+
+    if (n != cnt * 2)
+        err++;
+    printf ("uinput   : %d of %d key events, %s\n", n, cnt * 2, err ? "FAIL" : "PASS");
+    return err;
+}
+
+//------------------------------------------------------------------------------
+int main (int argc, char **argv)
+{
+    const char *uinput = "/dev/uinput";
+    int opt, pipes = 4, cnt = 10000, err;
+
+    while ((opt = getopt (argc, argv, "p:n:u:")) != -1) {
+        switch (opt) {
+            case 'p':   pipes  = atoi (optarg);     break;
+            case 'n':   cnt    = atoi (optarg);     break;
+            case 'u':   uinput = optarg;            break;
+            default:
+                printf ("usage : %s [-p pipes] [-n messages] [-u uinput]\n", argv[0]);
+                return 1;
+        }
+    }
+    if ((pipes <= 0) || (pipes > PIPE_MAX) || (cnt <= 0))
+        return 1;
+
+    err  = check_pipe (pipes, cnt);
+    err += check_remove ();
+    err += check_timer ();
+    err += check_stop ();
+    err += check_uinput (uinput, 100);
+
+    printf ("%s\n", err ? "FAIL" : "PASS");
+    return err ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,274 @@
+//------------------------------------------------------------------------------
+/**
+ * @file sched_stress.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Test graph scheduler test and benchmark for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * usage : sched_stress [-n rounds] [-w workers] [-s seed]
+ *          random graphs of mock tasks (prerequisites, retries, one exclusion
+ *          group) : every task must start after its prerequisites are done,
+ *          rerun after its retry period until it passes, and two tasks of the
+ *          exclusion group must never run at the same time.
+ *          then wide/chain graphs of sleeping mocks are timed per worker count
+ *          (parallel speedup, dispatch latency per task).
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <time.h>
+#include <stdatomic.h>
+
+//------------------------------------------------------------------------------
+#include "../core/sched.h"
+
+//------------------------------------------------------------------------------
+#define ATTEMPT_MAX     4
+#define RETRY_MS        5
+// worker wakeup slack of the retry period check (usec)
+#define RETRY_SLACK_US  1500
+
+struct mock {
+    unsigned int    deps;
+    int             fail, work_us, excl;
+    atomic_int      attempts, done;
+    long long       start_us [ATTEMPT_MAX], end_us [ATTEMPT_MAX];
+};
+
+struct graph {
+    struct mock     t [SCHED_TASK_MAX];
+    int             cnt;
+    atomic_int      order_err, excl_in, excl_err;
+};
+
+//------------------------------------------------------------------------------
+static long long time_us (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+//------------------------------------------------------------------------------
+// one attempt of task id : fails t->fail times, then passes
+//------------------------------------------------------------------------------
+static int mock_run (void *arg, int id)
+{
+    struct graph *g = (struct graph *)arg;
+    struct mock *t = &g->t[id];
+    int i, n = atomic_fetch_add (&t->attempts, 1);
+
+    if (n < ATTEMPT_MAX)
+        t->start_us[n] = time_us ();
+
+    for (i = 0; i < g->cnt; i++)
+        if ((t->deps & SCHED_DEP(i)) && !atomic_load (&g->t[i].done))
+            atomic_fetch_add (&g->order_err, 1);
+
+    if (t->excl && atomic_fetch_add (&g->excl_in, 1))
+        atomic_fetch_add (&g->excl_err, 1);
+    if (t->work_us)
+        usleep (t->work_us);
+    if (t->excl)
+        atomic_fetch_sub (&g->excl_in, 1);
+
+    if (n < ATTEMPT_MAX)
+        t->end_us[n] = time_us ();
+    if (n < t->fail)
+        return 0;
+    atomic_store (&t->done, 1);
+    return 1;
+}
+
+// sched_func_t has no task id, one mock function per id
+#define MOCK(n) static int mock_##n (void *arg) { return mock_run (arg, n); }
+MOCK(0)  MOCK(1)  MOCK(2)  MOCK(3)  MOCK(4)  MOCK(5)  MOCK(6)  MOCK(7)
+MOCK(8)  MOCK(9)  MOCK(10) MOCK(11) MOCK(12) MOCK(13) MOCK(14) MOCK(15)
+MOCK(16) MOCK(17) MOCK(18) MOCK(19) MOCK(20) MOCK(21) MOCK(22) MOCK(23)
+MOCK(24) MOCK(25) MOCK(26) MOCK(27) MOCK(28) MOCK(29) MOCK(30) MOCK(31)
+
+static const sched_func_t Mock [SCHED_TASK_MAX] = {
+    mock_0,  mock_1,  mock_2,  mock_3,  mock_4,  mock_5,  mock_6,  mock_7,
+    mock_8,  mock_9,  mock_10, mock_11, mock_12, mock_13, mock_14, mock_15,
+    mock_16, mock_17, mock_18, mock_19, mock_20, mock_21, mock_22, mock_23,
+    mock_24, mock_25, mock_26, mock_27, mock_28, mock_29, mock_30, mock_31,
+};
+
+static const char *Name [SCHED_TASK_MAX] = {
+    "t0",  "t1",  "t2",  "t3",  "t4",  "t5",  "t6",  "t7",
+    "t8",  "t9",  "t10", "t11", "t12", "t13", "t14", "t15",
+    "t16", "t17", "t18", "t19", "t20", "t21", "t22", "t23",
+    "t24", "t25", "t26", "t27", "t28", "t29", "t30", "t31",
+};
+
+//------------------------------------------------------------------------------
+// run graph g, return elapsed usec (-1 = not finished)
+//------------------------------------------------------------------------------
+static long long run_graph (struct graph *g, int workers)
+{
+    unsigned int all = 0;
+    long long start;
+    sched_t *s;
+    int i, j, ok;
+
+    if ((s = sched_init (workers, g)) == NULL)
+        return -1;
+    for (i = 0; i < g->cnt; i++) {
+        sched_add (s, i, Name[i], Mock[i], g->t[i].deps, g->t[i].fail ? RETRY_MS : 0);
+        all |= SCHED_DEP(i);
+    }
+    for (i = 0; i < g->cnt; i++)
+        for (j = i + 1; j < g->cnt; j++)
+            if (g->t[i].excl && g->t[j].excl)
+                sched_exclude (s, i, j);
+
+    start = time_us ();
+    sched_start (s);
+    ok = sched_wait (s, all, 10000);
+    start = time_us () - start;
+    sched_close (s);
+
+    return ok ? start : -1;
+}
+
+//------------------------------------------------------------------------------
+static int check_graph (struct graph *g, int round)
+{
+    struct mock *t;
+    int i, k, err = 0;
+
+    for (i = 0; i < g->cnt; i++) {
+        t = &g->t[i];
+        if (atomic_load (&t->attempts) != t->fail + 1) {
+            printf ("round %d : t%d ran %d times, expected %d\n",
+                    round, i, atomic_load (&t->attempts), t->fail + 1);
+            err++;
+            continue;
+        }
+        for (k = 0; k < t->fail; k++) {
+            if (t->start_us[k + 1] - t->end_us[k] < RETRY_MS * 1000 - RETRY_SLACK_US) {
+                printf ("round %d : t%d rerun after %lld us (retry %d ms)\n",
+                        round, i, t->start_us[k + 1] - t->end_us[k], RETRY_MS);
+                err++;
+            }
+        }
+    }
+    if (atomic_load (&g->order_err)) {
+        printf ("round %d : %d tasks started before their prerequisites\n",
+                round, atomic_load (&g->order_err));
+        err++;
+    }
+    if (atomic_load (&g->excl_err)) {
+        printf ("round %d : exclusion group overlapped %d times\n",
+                round, atomic_load (&g->excl_err));
+        err++;
+    }
+    return err;
+}
+
+//------------------------------------------------------------------------------
+// random graph : prerequisites only on lower ids (no cycle)
+//------------------------------------------------------------------------------
+static void random_graph (struct graph *g, unsigned int *seed)
+{
+    int i, j;
+
+    memset (g, 0, sizeof(struct graph));
+    g->cnt = 8 + rand_r (seed) % (SCHED_TASK_MAX - 7);
+    for (i = 0; i < g->cnt; i++) {
+        for (j = 0; j < i; j++)
+            if (!(rand_r (seed) % 6))
+                g->t[i].deps |= SCHED_DEP(j);
+        g->t[i].fail    = rand_r (seed) % 3;
+        g->t[i].work_us = rand_r (seed) % 2000;
+        g->t[i].excl    = !(rand_r (seed) % 5);
+    }
+}
+
+//------------------------------------------------------------------------------
+// cnt mocks of work_us, chain : t(i) depends on t(i-1)
+//------------------------------------------------------------------------------
+static long long bench (int cnt, int work_us, int chain, int workers)
+{
+    static struct graph g;
+    int i;
+
+    memset (&g, 0, sizeof(g));
+    g.cnt = cnt;
+    for (i = 0; i < cnt; i++) {
+        g.t[i].work_us = work_us;
+        g.t[i].deps    = (chain && i) ? SCHED_DEP(i - 1) : 0;
+    }
+    return run_graph (&g, workers);
+}
+
+//------------------------------------------------------------------------------
+int main (int argc, char **argv)
+{
+    static struct graph g;
+    unsigned int seed = 1;
+    int opt, rounds = 50, workers = 4, i, w, err = 0;
+    long long us, serial, wide [SCHED_WORKER_MAX + 1];
+
+    while ((opt = getopt (argc, argv, "n:w:s:")) != -1) {
+        switch (opt) {
+            case 'n':   rounds  = atoi (optarg);            break;
+            case 'w':   workers = atoi (optarg);            break;
+            case 's':   seed    = (unsigned int)atoi (optarg);  break;
+            default:
+                printf ("usage : %s [-n rounds] [-w workers] [-s seed]\n", argv[0]);
+                return 1;
+        }
+    }
+    if ((rounds <= 0) || (workers <= 0) || (workers > SCHED_WORKER_MAX))
+        return 1;
+
+    // graph order, retry period, exclusion
+    for (i = 0; i < rounds; i++) {
+        random_graph (&g, &seed);
+        if ((us = run_graph (&g, workers)) < 0) {
+            printf ("round %d : %d tasks not done\n", i, g.cnt);
+            err++;
+            continue;
+        }
+        err += check_graph (&g, i);
+    }
+    printf ("graph    : %d rounds, %d workers, %s\n", rounds, workers, err ? "FAIL" : "PASS");
+
+    // 32 independent 5 ms tasks : makespan per worker count
+    serial = SCHED_TASK_MAX * 5000;
+    for (w = 1; w <= SCHED_WORKER_MAX; w *= 2) {
+        wide[w] = bench (SCHED_TASK_MAX, 5000, 0, w);
+        printf ("wide     : %d workers, %6lld us (serial %lld us, x%.1f)\n",
+                w, wide[w], serial, wide[w] > 0 ? (double)serial / wide[w] : 0.0);
+    }
+    // sleeping mocks scale with the workers (half the ideal speedup at least)
+    if ((wide[SCHED_WORKER_MAX] < 0) || (wide[SCHED_WORKER_MAX] * SCHED_WORKER_MAX > serial * 2)) {
+        printf ("wide     : FAIL\n");
+        err++;
+    }
+
+    // zero work chain : dispatch latency from done to the next start
+    us = bench (SCHED_TASK_MAX, 0, 1, workers);
+    printf ("chain    : %d tasks, %lld us, %lld us per task\n",
+            SCHED_TASK_MAX, us, us / SCHED_TASK_MAX);
+    if (us < 0)
+        err++;
+
+    printf ("%s\n", err ? "FAIL" : "PASS");
+    return err ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,201 @@
+//------------------------------------------------------------------------------
+/**
+ * @file trace_bench.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Item trace overhead benchmark for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * usage : trace_bench [-t threads] [-l loops] [-o trace.json]
+ *          cost per event of trace_put and of an item status change with
+ *          and without the trace attached (limit 1 usec per event), then
+ *          a simulated run exported as trace-event JSON / CSV.
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <time.h>
+
+//------------------------------------------------------------------------------
+#include "../core/trace.h"
+#include "../core/itemstate.h"
+
+//------------------------------------------------------------------------------
+enum { eST_WAIT = 0, eST_RUN, eST_STOP };
+
+#define ITEM_CNT        40
+// per event limit (nsec)
+#define EVENT_LIMIT_NS  1000
+
+struct worker {
+    pthread_t       th;
+    trace_t         *t;
+    itemstate_t     *s;
+    int             id, loops;
+};
+
+//------------------------------------------------------------------------------
+static long long time_ns (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+//------------------------------------------------------------------------------
+static void *put_worker (void *arg)
+{
+    struct worker *w = (struct worker *)arg;
+    int i;
+
+    for (i = 0; i < w->loops; i++)
+        trace_put (w->t, w->id, i & 1, !(i & 1), 1);
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+// each thread toggles its own items RUN <-> WAIT (every call is a transition)
+//------------------------------------------------------------------------------
+static void *set_worker (void *arg)
+{
+    struct worker *w = (struct worker *)arg;
+    int i;
+
+    for (i = 0; i < w->loops; i++)
+        itemstate_set (w->s, w->id, (i & 1) ? eST_WAIT : eST_RUN, ITEM_KEEP);
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+// return nsec per event
+//------------------------------------------------------------------------------
+static double bench (void *(*fn)(void *), trace_t *t, itemstate_t *s, int threads, int loops)
+{
+    struct worker w[threads];
+    long long start;
+    int i;
+
+    start = time_ns ();
+    for (i = 0; i < threads; i++) {
+        w[i].t = t;     w[i].s = s;     w[i].id = i;    w[i].loops = loops;
+        pthread_create (&w[i].th, NULL, fn, &w[i]);
+    }
+    for (i = 0; i < threads; i++)
+        pthread_join (w[i].th, NULL);
+
+    // wall time per event of one thread
+    return (double)(time_ns () - start) / loops;
+}
+
+//------------------------------------------------------------------------------
+static int report (const char *name, double ns, double base)
+{
+    int pass = (ns - base) < EVENT_LIMIT_NS;
+
+    printf ("%-16s : %8.1f ns/event (overhead %8.1f ns), %s\n",
+            name, ns, ns - base, pass ? "PASS" : "FAIL");
+    return pass ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+int main (int argc, char **argv)
+{
+    const char *out = "trace.json", *names[ITEM_CNT];
+    char name[ITEM_CNT][8], csv[2048];
+    struct trace_rec *rec;
+    int opt, threads = 4, loops = 1000000, i, cnt, err = 0;
+    double base, ns;
+    itemstate_t *s;
+    trace_t *t;
+
+    while ((opt = getopt (argc, argv, "t:l:o:")) != -1) {
+        switch (opt) {
+            case 't':   threads = atoi (optarg);    break;
+            case 'l':   loops   = atoi (optarg);    break;
+            case 'o':   out     = optarg;           break;
+            default:
+                printf ("usage : %s [-t threads] [-l loops] [-o trace.json]\n", argv[0]);
+                return 1;
+        }
+    }
+    if ((threads <= 0) || (threads > ITEM_CNT) || (loops <= 0))
+        return 1;
+
+    // raw record cost
+    if ((t = trace_init (TRACE_DEPTH_DEF, eST_RUN, eST_STOP)) == NULL)
+        return 1;
+    err += report ("trace_put x1", bench (put_worker, t, NULL, 1, loops), 0);
+    ns = bench (put_worker, t, NULL, threads, loops);
+    printf ("(%d threads)\n", threads);
+    err += report ("trace_put", ns, 0);
+
+    // ring keeps the newest records, all published after the writers joined
+    rec = (struct trace_rec *)malloc (TRACE_DEPTH_DEF * sizeof(struct trace_rec));
+    cnt = rec ? trace_read (t, rec, TRACE_DEPTH_DEF) : 0;
+    printf ("%-16s : %d of %d records (%u dropped), %s\n", "ring", cnt, TRACE_DEPTH_DEF,
+            atomic_load (&t->dropped),
+            (cnt == TRACE_DEPTH_DEF) ? "PASS" : "FAIL");
+    if (cnt != TRACE_DEPTH_DEF)
+        err++;
+    free (rec);
+    trace_close (t);
+
+    // status change cost with / without the trace
+    if ((s = itemstate_init (ITEM_CNT, eST_WAIT, 0, eST_STOP)) == NULL)
+        return 1;
+    base = bench (set_worker, NULL, s, threads, loops);
+    printf ("%-16s : %8.1f ns/event\n", "itemstate_set", base);
+    if ((t = trace_init (TRACE_DEPTH_DEF, eST_RUN, eST_STOP)) == NULL)
+        return 1;
+    itemstate_trace (s, t);
+    err += report ("  + trace", bench (set_worker, NULL, s, threads, loops), base);
+    itemstate_close (s);
+    trace_close (t);
+
+    // simulated run : WAIT -> RUN -> STOP, staggered
+    if ((s = itemstate_init (ITEM_CNT, eST_WAIT, 0, eST_STOP)) == NULL)
+        return 1;
+    if ((t = trace_init (TRACE_DEPTH_DEF, eST_RUN, eST_STOP)) == NULL)
+        return 1;
+    for (i = 0; i < ITEM_CNT; i++) {
+        snprintf (name[i], sizeof(name[i]), "it%02d", i);
+        names[i] = name[i];
+    }
+    trace_set_names (t, names, ITEM_CNT);
+    itemstate_trace (s, t);
+    for (i = 0; i < ITEM_CNT; i++) {
+        itemstate_set (s, i, eST_RUN, ITEM_KEEP);
+        if (i >= 4)
+            itemstate_set (s, i - 4, eST_STOP, i & 1);
+        usleep (500);
+    }
+    for (i = ITEM_CNT - 4; i < ITEM_CNT; i++)
+        itemstate_set (s, i, eST_STOP, 1);
+
+    cnt = trace_export_csv (t, csv, sizeof(csv));
+    printf ("csv : %s\n", csv);
+    if (!trace_export_json (t, out)) {
+        printf ("%s : export error\n", out);
+        err++;
+    } else {
+        printf ("json : %s (chrome://tracing, ui.perfetto.dev)\n", out);
+    }
+    itemstate_close (s);
+    trace_close (t);
+
+    return err ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
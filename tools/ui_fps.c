@@ -0,0 +1,209 @@
+//------------------------------------------------------------------------------
+/**
+ * @file ui_fps.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief UI render thread frame rate benchmark for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * usage : ui_fps [-c cfg] [-t threads] [-d sec] [-p period_us] [-x width] [-y height]
+ *          the render thread (uif_start) presents into a memory fb while the
+ *          producer threads post item updates (uif_set_ritem/sitem), each
+ *          thread owns its own items like the test threads of the app.
+ *          frames per second, flush time and post time are reported, the last
+ *          frame must match a full repaint of the final item state.
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <time.h>
+#include <pthread.h>
+
+//------------------------------------------------------------------------------
+#include "../core/fbmem.h"
+#include "../core/layout.h"
+#include "../core/uidraw.h"
+#include "../core/uiflush.h"
+
+//------------------------------------------------------------------------------
+#define PRODUCER_MAX    16
+
+static const int Palette [] = {
+    0x000000, 0xFFFFFF, 0xFF0000, 0x00FF00, 0x0000FF, 0xFFFF00, 0x2E86C1, 0xE0E0E0,
+};
+#define PALETTE_CNT     (int)(sizeof(Palette) / sizeof(Palette[0]))
+
+struct producer {
+    pthread_t       th;
+    int             idx, cnt, period_us;
+    const layout_t  *ly;
+    // final item state (items of this thread only)
+    uidraw_t        *ref;
+    fb_info_t       *back;
+    uidraw_t        *ui;
+    long long       end_us;
+    // posted updates, time in uif_set_*
+    unsigned int    posted;
+    long long       post_us;
+};
+
+//------------------------------------------------------------------------------
+static long long time_us (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+//------------------------------------------------------------------------------
+static void *producer_thread (void *arg)
+{
+    struct producer *p = (struct producer *)arg;
+    unsigned int seed = p->idx + 1;
+    char str[UIF_STR_MAX];
+    long long t;
+    int i, id, c;
+
+    while (time_us () < p->end_us) {
+        // items of this thread : layout index % thread count
+        i  = (rand_r (&seed) % ((p->ly->cnt + p->cnt - 1 - p->idx) / p->cnt)) * p->cnt + p->idx;
+        id = p->ly->item[i].id;
+        c  = Palette[rand_r (&seed) % PALETTE_CNT];
+
+        t = time_us ();
+        if (rand_r (&seed) & 1) {
+            uif_set_ritem (p->back, p->ui, id, c, -1);
+            uidraw_set_ritem (p->ref, id, c, -1);
+        } else {
+            snprintf (str, sizeof(str), "%u", p->posted);
+            uif_set_sitem (p->back, p->ui, id, c, -1, str);
+            uidraw_set_sitem (p->ref, id, c, -1, str);
+        }
+        p->post_us += time_us () - t;
+        p->posted++;
+
+        if (p->period_us)
+            usleep (p->period_us);
+    }
+    return arg;
+}
+
+//------------------------------------------------------------------------------
+// render thread idle : no flush in the last frames
+//------------------------------------------------------------------------------
+static void render_wait_idle (void)
+{
+    struct uif_stats st;
+    unsigned int last;
+
+    uif_get_stats (&st);
+    do {
+        last = st.flush_cnt;
+        usleep (UIF_FRAME_MS * 5 * 1000);
+        uif_get_stats (&st);
+    } while (st.flush_cnt != last);
+}
+
+//------------------------------------------------------------------------------
+int main (int argc, char **argv)
+{
+    const char *cfg = "m1.cfg";
+    static struct producer prod [PRODUCER_MAX];
+    fb_info_t *front, *back, *ref;
+    uidraw_t *ui, *ref_ui;
+    layout_t *ly;
+    struct uif_stats st0, st;
+    unsigned int posted = 0;
+    int opt, threads = 6, sec = 3, period_us = 1000, w = 1920, h = 1080, i, same;
+    long long start, elapsed, post_us = 0;
+
+    while ((opt = getopt (argc, argv, "c:t:d:p:x:y:")) != -1) {
+        switch (opt) {
+            case 'c':   cfg       = optarg;         break;
+            case 't':   threads   = atoi (optarg);  break;
+            case 'd':   sec       = atoi (optarg);  break;
+            case 'p':   period_us = atoi (optarg);  break;
+            case 'x':   w         = atoi (optarg);  break;
+            case 'y':   h         = atoi (optarg);  break;
+            default:
+                printf ("usage : %s [-c cfg] [-t threads] [-d sec] [-p period_us] [-x width] [-y height]\n",
+                        argv[0]);
+                return 1;
+        }
+    }
+    if ((threads <= 0) || (threads > PRODUCER_MAX) || (sec <= 0) || (period_us < 0))
+        return 1;
+
+    if (((ly = layout_parse (cfg, w, h)) == NULL) || (ly->cnt < threads)) {
+        printf ("%s : layout error\n", cfg);
+        return 1;
+    }
+    front  = fb_mem_init (w, h, 32);
+    ref    = fb_mem_init (w, h, 32);
+    if ((front == NULL) || (ref == NULL) || ((back = uif_init (front, ly)) == NULL))
+        return 1;
+
+    ui     = uidraw_init (ly);
+    ref_ui = uidraw_init (ly);
+    if ((ui == NULL) || (ref_ui == NULL) || !uif_start (ui))
+        return 1;
+
+    // first frame
+    render_wait_idle ();
+    uif_get_stats (&st0);
+
+    start = time_us ();
+    for (i = 0; i < threads; i++) {
+        prod[i].idx  = i;           prod[i].cnt       = threads;
+        prod[i].ly   = ly;          prod[i].period_us = period_us;
+        prod[i].ref  = ref_ui;      prod[i].back      = back;
+        prod[i].ui   = ui;          prod[i].end_us    = start + sec * 1000000LL;
+        if (pthread_create (&prod[i].th, NULL, producer_thread, &prod[i]))
+            return 1;
+    }
+    for (i = 0; i < threads; i++) {
+        pthread_join (prod[i].th, NULL);
+        posted  += prod[i].posted;
+        post_us += prod[i].post_us;
+    }
+    elapsed = time_us () - start;
+    render_wait_idle ();
+    uif_get_stats (&st);
+
+    // every posted update is in the last frame
+    uidraw_update (ref, ref_ui, -1);
+    same = !memcmp (front->data, ref->data, front->size);
+
+    printf ("layout  : %s, %d items, %dx%d, %s\n", cfg, ly->cnt, w, h,
+            st.present == eUIF_PRESENT_PAN ? "page flip" : "rect copy");
+    printf ("updates : %d threads, %u posted, %lld ns/post, queue full %u\n",
+            threads, posted, posted ? (post_us * 1000) / posted : 0, st.msg_full - st0.msg_full);
+    printf ("frames  : %u in %lld ms, %.1f fps (max %d)\n",
+            st.flush_cnt - st0.flush_cnt, elapsed / 1000,
+            (double)(st.flush_cnt - st0.flush_cnt) * 1000000 / elapsed, 1000 / UIF_FRAME_MS);
+    printf ("flush   : %u rects, %lld bytes, max %d us\n",
+            st.rect_cnt - st0.rect_cnt, st.bytes - st0.bytes, st.max_us);
+    printf ("frame compare : %s\n", same ? "SAME" : "DIFF");
+    printf ("%s\n", same ? "PASS" : "FAIL");
+
+    uif_close ();
+    uidraw_close (ref_ui);
+    uidraw_close (ui);
+    fb_mem_close (ref);
+    fb_mem_close (front);
+    layout_close (ly);
+    return same ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,181 @@
+//------------------------------------------------------------------------------
+/**
+ * @file ui_framediff.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Partial flush frame diff test and render benchmark for ODROID-JIG.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @package apt install iperf3, nmap, ethtool, usbutils, alsa-utils
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * usage : ui_framediff [-c cfg] [-n frames] [-s seed] [-x width] [-y height]
+ *          the ui of the cfg is rendered into a memory fb (no /dev/fb0).
+ *          each frame posts a few random item updates and presents them with
+ *          uif_flush (dirty items only), the same updates are applied to a
+ *          second item state that is fully repainted into a reference fb.
+ *          both frames must be the same, the partial flush and the full
+ *          repaint are timed per frame.
+ *
+ */
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <time.h>
+
+//------------------------------------------------------------------------------
+#include "../core/fbmem.h"
+#include "../core/layout.h"
+#include "../core/uidraw.h"
+#include "../core/uiflush.h"
+
+//------------------------------------------------------------------------------
+// updates per frame (max), less than UIF_MSG_MAX (no render thread drains the queue)
+#define FRAME_UPDATE_MAX    8
+
+static const int Palette [] = {
+    0x000000, 0xFFFFFF, 0xFF0000, 0x00FF00, 0x0000FF, 0xFFFF00, 0x2E86C1, 0xE0E0E0,
+};
+#define PALETTE_CNT     (int)(sizeof(Palette) / sizeof(Palette[0]))
+
+//------------------------------------------------------------------------------
+static long long time_us (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+//------------------------------------------------------------------------------
+// random update, posted to the renderer and applied to the reference state
+//------------------------------------------------------------------------------
+static void frame_update (fb_info_t *back, uidraw_t *ui, uidraw_t *ref,
+                          const layout_t *ly, unsigned int *seed)
+{
+    int id = ly->item[rand_r (seed) % ly->cnt].id;
+    int c1 = Palette[rand_r (seed) % PALETTE_CNT];
+    int c2 = Palette[rand_r (seed) % PALETTE_CNT];
+    char str[UIF_STR_MAX];
+
+    switch (rand_r (seed) % 3) {
+        case 0:
+            uif_set_ritem (back, ui, id, c1, -1);
+            uidraw_set_ritem (ref, id, c1, -1);
+            break;
+        case 1:
+            uif_set_ritem (back, ui, id, c1, c2);
+            uidraw_set_ritem (ref, id, c1, c2);
+            break;
+        default:
+            snprintf (str, sizeof(str), "%d MB/s", rand_r (seed) % 1000);
+            uif_set_sitem (back, ui, id, c1, -1, str);
+            uidraw_set_sitem (ref, id, c1, -1, str);
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+static int frame_compare (const fb_info_t *a, const fb_info_t *b, int frame)
+{
+    int x, y, bpp = a->bpp / 8;
+
+    if (!memcmp (a->data, b->data, a->size))
+        return 1;
+
+    for (y = 0; y < a->h; y++)
+        for (x = 0; x < a->w; x++)
+            if (memcmp (a->data + y * a->stride + x * bpp, b->data + y * b->stride + x * bpp, bpp)) {
+                printf ("frame %d : DIFF at (%d, %d)\n", frame, x, y);
+                return 0;
+            }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+int main (int argc, char **argv)
+{
+    const char *cfg = "m1.cfg";
+    fb_info_t *front, *back, *ref;
+    uidraw_t *ui, *ref_ui;
+    layout_t *ly;
+    struct uif_stats st;
+    unsigned int seed = 1;
+    int opt, frames = 500, w = 1920, h = 1080, i, u, err = 0;
+    long long t, flush_us = 0, full_us = 0;
+
+    while ((opt = getopt (argc, argv, "c:n:s:x:y:")) != -1) {
+        switch (opt) {
+            case 'c':   cfg    = optarg;                        break;
+            case 'n':   frames = atoi (optarg);                 break;
+            case 's':   seed   = (unsigned int)atoi (optarg);   break;
+            case 'x':   w      = atoi (optarg);                 break;
+            case 'y':   h      = atoi (optarg);                 break;
+            default:
+                printf ("usage : %s [-c cfg] [-n frames] [-s seed] [-x width] [-y height]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (frames <= 0)
+        return 1;
+
+    if ((ly = layout_parse (cfg, w, h)) == NULL || !ly->cnt) {
+        printf ("%s : layout error\n", cfg);
+        return 1;
+    }
+    front  = fb_mem_init (w, h, 32);
+    ref    = fb_mem_init (w, h, 32);
+    if ((front == NULL) || (ref == NULL) || ((back = uif_init (front, ly)) == NULL))
+        return 1;
+
+    ui     = uidraw_init (ly);
+    ref_ui = uidraw_init (ly);
+    if ((ui == NULL) || (ref_ui == NULL))
+        return 1;
+
+    // first frame (full repaint)
+    uif_flush (ui);
+    uidraw_update (ref, ref_ui, -1);
+    err += !frame_compare (front, ref, 0);
+
+    for (i = 1; (i <= frames) && !err; i++) {
+        for (u = rand_r (&seed) % FRAME_UPDATE_MAX; u >= 0; u--)
+            frame_update (back, ui, ref_ui, ly, &seed);
+
+        t = time_us ();
+        uif_flush (ui);
+        flush_us += time_us () - t;
+
+        t = time_us ();
+        uidraw_update (ref, ref_ui, -1);
+        full_us += time_us () - t;
+
+        err += !frame_compare (front, ref, i);
+    }
+    uif_get_stats (&st);
+    i--;
+
+    printf ("layout : %s, %d items, %dx%d\n", cfg, ly->cnt, w, h);
+    printf ("frames : %d, %u rects, %lld bytes presented\n", i, st.rect_cnt, st.bytes);
+    if (i > 0) {
+        printf ("partial flush : %6lld us/frame (max %d us)\n", flush_us / i, st.max_us);
+        printf ("full repaint  : %6lld us/frame, x%.1f\n", full_us / i,
+                flush_us ? (double)full_us / flush_us : 0.0);
+    }
+    printf ("%s\n", err ? "FAIL" : "PASS");
+
+    uidraw_close (ref_ui);
+    uidraw_close (ui);
+    uif_close ();
+    fb_mem_close (ref);
+    fb_mem_close (front);
+    layout_close (ly);
+    return err ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------